@@ -33,6 +33,7 @@
 
 #include "core/math/geometry_3d.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 
 int64_t AStar3D::get_available_point_id() const {
 	if (points.has(last_free_id)) {
@@ -58,10 +59,13 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
 		pt->enabled = true;
+		if (free_search_indices.is_empty()) {
+			pt->search_index = search_index_count++;
+		} else {
+			pt->search_index = free_search_indices[free_search_indices.size() - 1];
+			free_search_indices.remove_at(free_search_indices.size() - 1);
+		}
 		points.set(p_id, pt);
 	} else {
 		found_pt->pos = p_pos;
@@ -123,6 +127,7 @@ void AStar3D::remove_point(int64_t p_id) {
 		(*it.value)->unlinked_neighbours.remove(p->id);
 	}
 
+	free_search_indices.push_back(p->search_index);
 	memdelete(p);
 	points.remove(p_id);
 	last_free_id = p_id;
@@ -249,6 +254,8 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+	search_index_count = 0;
+	free_search_indices.clear();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -319,9 +326,82 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point) {
-	last_closest_point = nullptr;
-	pass++;
+bool AStar3D::_is_worse(const SearchState &p_state, const Point *p_a, const Point *p_b) {
+	const SearchPoint &a = p_state.search_points[p_a->search_index];
+	const SearchPoint &b = p_state.search_points[p_b->search_index];
+	if (a.f_score > b.f_score) {
+		return true;
+	} else if (a.f_score < b.f_score) {
+		return false;
+	} else {
+		return a.g_score < b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+	}
+}
+
+void AStar3D::_open_list_sift_up(SearchState &r_state, uint32_t p_hole, Point *p_point) {
+	LocalVector<Point *> &open_list = r_state.open_list;
+
+	while (p_hole > 0) {
+		const uint32_t parent = (p_hole - 1) / 2;
+		if (!_is_worse(r_state, open_list[parent], p_point)) {
+			break;
+		}
+		open_list[p_hole] = open_list[parent];
+		r_state.search_points[open_list[p_hole]->search_index].open_index = p_hole;
+		p_hole = parent;
+	}
+
+	open_list[p_hole] = p_point;
+	r_state.search_points[p_point->search_index].open_index = p_hole;
+}
+
+void AStar3D::_open_list_push(SearchState &r_state, Point *p_point) {
+	r_state.open_list.push_back(p_point);
+	_open_list_sift_up(r_state, r_state.open_list.size() - 1, p_point);
+}
+
+void AStar3D::_open_list_pop(SearchState &r_state) {
+	LocalVector<Point *> &open_list = r_state.open_list;
+
+	const uint32_t size = open_list.size() - 1;
+	Point *last = open_list[size];
+	open_list.resize(size);
+	if (size == 0) {
+		return;
+	}
+
+	// Moves the hole left by the first point down to a leaf, then lets the last point rise from there.
+	uint32_t hole = 0;
+	uint32_t child = 2;
+	while (child < size) {
+		if (_is_worse(r_state, open_list[child], open_list[child - 1])) {
+			child--;
+		}
+		open_list[hole] = open_list[child];
+		r_state.search_points[open_list[hole]->search_index].open_index = hole;
+		hole = child;
+		child = 2 * (child + 1);
+	}
+	if (child == size) {
+		open_list[hole] = open_list[child - 1];
+		r_state.search_points[open_list[hole]->search_index].open_index = hole;
+		hole = child - 1;
+	}
+
+	_open_list_sift_up(r_state, hole, last);
+}
+
+void AStar3D::_begin_search(SearchState &r_state) const {
+	if (r_state.search_points.size() < search_index_count) {
+		r_state.search_points.resize(search_index_count);
+	}
+	r_state.open_list.clear();
+	r_state.last_closest_point = nullptr;
+	r_state.pass++;
+}
+
+bool AStar3D::_solve(Point *begin_point, Point *end_point, SearchState &r_state) {
+	_begin_search(r_state);
 
 	if (!end_point->enabled) {
 		return false;
@@ -329,21 +409,25 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point) {
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	SearchPoint &search_begin = r_state.search_points[begin_point->search_index];
+	search_begin.g_score = 0;
+	search_begin.f_score = _estimate_cost(begin_point->id, end_point->id);
+	search_begin.abs_g_score = 0;
+	search_begin.abs_f_score = _estimate_cost(begin_point->id, end_point->id);
+	_open_list_push(r_state, begin_point);
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+	while (!r_state.open_list.is_empty()) {
+		Point *p = r_state.open_list[0]; // The currently processed point.
+		SearchPoint &search_p = r_state.search_points[p->search_index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		if (r_state.last_closest_point == nullptr) {
+			r_state.last_closest_point = p;
+		} else {
+			const SearchPoint &search_closest = r_state.search_points[r_state.last_closest_point->search_index];
+			if (search_closest.abs_f_score > search_p.abs_f_score || (search_closest.abs_f_score >= search_p.abs_f_score && search_closest.abs_g_score > search_p.abs_g_score)) {
+				r_state.last_closest_point = p;
+			}
 		}
 
 		if (p == end_point) {
@@ -351,39 +435,38 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point) {
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		_open_list_pop(r_state); // Remove the current point from the open list.
+		search_p.closed_pass = r_state.pass; // Mark the point as closed.
 
 		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
 			Point *e = *(it.value); // The neighbor point.
+			SearchPoint &search_e = r_state.search_points[e->search_index];
 
-			if (!e->enabled || e->closed_pass == pass) {
+			if (!e->enabled || search_e.closed_pass == r_state.pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = search_p.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (search_e.open_pass != r_state.pass) { // The point wasn't inside the open list.
+				search_e.open_pass = r_state.pass;
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= search_e.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			search_e.prev_point = p;
+			search_e.g_score = tentative_g_score;
+			search_e.f_score = search_e.g_score + _estimate_cost(e->id, end_point->id);
+			search_e.abs_g_score = tentative_g_score;
+			search_e.abs_f_score = search_e.f_score - search_e.g_score;
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			if (new_point) {
+				_open_list_push(r_state, e);
+			} else { // The point only moves up, its position in the open list is already known.
+				_open_list_sift_up(r_state, search_e.open_index, e);
 			}
 		}
 	}
@@ -443,21 +526,21 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, search_state);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || search_state.last_closest_point == nullptr) {
 			return Vector<Vector3>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = search_state.last_closest_point;
 	}
 
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = search_state.search_points[p->search_index].prev_point;
 	}
 
 	Vector<Vector3> path;
@@ -470,7 +553,7 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
+			p2 = search_state.search_points[p2->search_index].prev_point;
 		}
 
 		w[0] = p2->pos; // Assign first
@@ -480,6 +563,10 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	return _get_id_path(p_from_id, p_to_id, p_allow_partial_path, search_state);
+}
+
+Vector<int64_t> AStar3D::_get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path, SearchState &r_state) {
 	Point *a = nullptr;
 	bool from_exists = points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
@@ -497,21 +584,21 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	Point *begin_point = a;
 	Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, r_state);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || r_state.last_closest_point == nullptr) {
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = last_closest_point;
+		end_point = r_state.last_closest_point;
 	}
 
 	Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = r_state.search_points[p->search_index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -524,7 +611,7 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = r_state.search_points[p->search_index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
@@ -533,6 +620,60 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	return path;
 }
 
+TypedArray<PackedInt64Array> AStar3D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. Got %d from ids but %d to ids.", p_from_ids.size(), p_to_ids.size()));
+
+	IdPathBatch batch;
+	batch.astar_3d = this;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+
+	// Costs implemented in scripts are not assumed to be safe to call from several threads at once.
+	const bool use_threads = !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost);
+	return _run_id_path_batch(batch, p_from_ids.size(), use_threads);
+}
+
+TypedArray<PackedInt64Array> AStar3D::_run_id_path_batch(IdPathBatch &r_batch, int64_t p_path_count, bool p_use_threads) {
+	r_batch.paths.resize(p_path_count);
+	r_batch.search_states = &batch_search_states;
+
+	// The points are only read during a search, so every task only needs its own search state.
+	const int task_count = (p_use_threads && p_path_count > 1) ? MIN((int)p_path_count - 1, WorkerThreadPool::get_singleton()->get_thread_count()) : 0;
+	if (batch_search_states.size() < (uint32_t)task_count + 1) {
+		batch_search_states.resize(task_count + 1);
+	}
+
+	if (task_count > 0) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AStar3D::_id_path_batch_task, &r_batch, task_count, task_count, true, SNAME("AStarIdPaths"));
+		// The calling thread uses the last search state and takes part in the searches instead of only waiting.
+		_id_path_batch_task(&r_batch, task_count);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_id_path_batch_task(&r_batch, 0);
+	}
+
+	TypedArray<PackedInt64Array> paths;
+	paths.resize(p_path_count);
+	for (int64_t i = 0; i < p_path_count; i++) {
+		paths[i] = r_batch.paths[i];
+	}
+	return paths;
+}
+
+void AStar3D::_id_path_batch_task(void *p_userdata, uint32_t p_index) {
+	IdPathBatch *batch = static_cast<IdPathBatch *>(p_userdata);
+	SearchState &state = (*batch->search_states)[p_index];
+
+	for (uint32_t i = batch->next_path.postincrement(); i < batch->paths.size(); i = batch->next_path.postincrement()) {
+		if (batch->astar_2d) {
+			batch->paths[i] = batch->astar_2d->_get_id_path(batch->from_ids[i], batch->to_ids[i], batch->allow_partial_path, state);
+		} else {
+			batch->paths[i] = batch->astar_3d->_get_id_path(batch->from_ids[i], batch->to_ids[i], batch->allow_partial_path, state);
+		}
+	}
+}
+
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	Point *p = nullptr;
 	bool p_exists = points.lookup(p_id, p);
@@ -578,6 +719,7 @@ void AStar3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar3D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar3D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -726,21 +868,21 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, astar.search_state);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || astar.search_state.last_closest_point == nullptr) {
 			return Vector<Vector2>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = astar.search_state.last_closest_point;
 	}
 
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = astar.search_state.search_points[p->search_index].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -753,7 +895,7 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 		int64_t idx = pc - 1;
 		while (p2 != begin_point) {
 			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
+			p2 = astar.search_state.search_points[p2->search_index].prev_point;
 		}
 
 		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
@@ -763,6 +905,24 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	return _get_id_path(p_from_id, p_to_id, p_allow_partial_path, astar.search_state);
+}
+
+TypedArray<PackedInt64Array> AStar2D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. Got %d from ids but %d to ids.", p_from_ids.size(), p_to_ids.size()));
+
+	AStar3D::IdPathBatch batch;
+	batch.astar_2d = this;
+	batch.from_ids = p_from_ids.ptr();
+	batch.to_ids = p_to_ids.ptr();
+	batch.allow_partial_path = p_allow_partial_path;
+
+	// Costs implemented in scripts are not assumed to be safe to call from several threads at once.
+	const bool use_threads = !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost);
+	return astar._run_id_path_batch(batch, p_from_ids.size(), use_threads);
+}
+
+Vector<int64_t> AStar2D::_get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path, AStar3D::SearchState &r_state) {
 	AStar3D::Point *a = nullptr;
 	bool from_exists = astar.points.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
@@ -780,21 +940,21 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	AStar3D::Point *begin_point = a;
 	AStar3D::Point *end_point = b;
 
-	bool found_route = _solve(begin_point, end_point);
+	bool found_route = _solve(begin_point, end_point, r_state);
 	if (!found_route) {
-		if (!p_allow_partial_path || astar.last_closest_point == nullptr) {
+		if (!p_allow_partial_path || r_state.last_closest_point == nullptr) {
 			return Vector<int64_t>();
 		}
 
 		// Use closest point instead.
-		end_point = astar.last_closest_point;
+		end_point = r_state.last_closest_point;
 	}
 
 	AStar3D::Point *p = end_point;
 	int64_t pc = 1; // Begin point
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = r_state.search_points[p->search_index].prev_point;
 	}
 
 	Vector<int64_t> path;
@@ -807,7 +967,7 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 		int64_t idx = pc - 1;
 		while (p != begin_point) {
 			w[idx--] = p->id;
-			p = p->prev_point;
+			p = r_state.search_points[p->search_index].prev_point;
 		}
 
 		w[0] = p->id; // Assign first
@@ -816,9 +976,8 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 	return path;
 }
 
-bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
-	astar.last_closest_point = nullptr;
-	astar.pass++;
+bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, AStar3D::SearchState &r_state) {
+	astar._begin_search(r_state);
 
 	if (!end_point->enabled) {
 		return false;
@@ -826,21 +985,25 @@ bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
 
 	bool found_route = false;
 
-	LocalVector<AStar3D::Point *> open_list;
-	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	begin_point->abs_g_score = 0;
-	begin_point->abs_f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	AStar3D::SearchPoint &search_begin = r_state.search_points[begin_point->search_index];
+	search_begin.g_score = 0;
+	search_begin.f_score = _estimate_cost(begin_point->id, end_point->id);
+	search_begin.abs_g_score = 0;
+	search_begin.abs_f_score = _estimate_cost(begin_point->id, end_point->id);
+	AStar3D::_open_list_push(r_state, begin_point);
 
-	while (!open_list.is_empty()) {
-		AStar3D::Point *p = open_list[0]; // The currently processed point.
+	while (!r_state.open_list.is_empty()) {
+		AStar3D::Point *p = r_state.open_list[0]; // The currently processed point.
+		AStar3D::SearchPoint &search_p = r_state.search_points[p->search_index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (astar.last_closest_point == nullptr || astar.last_closest_point->abs_f_score > p->abs_f_score || (astar.last_closest_point->abs_f_score >= p->abs_f_score && astar.last_closest_point->abs_g_score > p->abs_g_score)) {
-			astar.last_closest_point = p;
+		if (r_state.last_closest_point == nullptr) {
+			r_state.last_closest_point = p;
+		} else {
+			const AStar3D::SearchPoint &search_closest = r_state.search_points[r_state.last_closest_point->search_index];
+			if (search_closest.abs_f_score > search_p.abs_f_score || (search_closest.abs_f_score >= search_p.abs_f_score && search_closest.abs_g_score > search_p.abs_g_score)) {
+				r_state.last_closest_point = p;
+			}
 		}
 
 		if (p == end_point) {
@@ -848,39 +1011,38 @@ bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
+		AStar3D::_open_list_pop(r_state); // Remove the current point from the open list.
+		search_p.closed_pass = r_state.pass; // Mark the point as closed.
 
 		for (OAHashMap<int64_t, AStar3D::Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
 			AStar3D::Point *e = *(it.value); // The neighbor point.
+			AStar3D::SearchPoint &search_e = r_state.search_points[e->search_index];
 
-			if (!e->enabled || e->closed_pass == astar.pass) {
+			if (!e->enabled || search_e.closed_pass == r_state.pass) {
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			real_t tentative_g_score = search_p.g_score + _compute_cost(p->id, e->id) * e->weight_scale;
 
 			bool new_point = false;
 
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
+			if (search_e.open_pass != r_state.pass) { // The point wasn't inside the open list.
+				search_e.open_pass = r_state.pass;
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= search_e.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			search_e.prev_point = p;
+			search_e.g_score = tentative_g_score;
+			search_e.f_score = search_e.g_score + _estimate_cost(e->id, end_point->id);
+			search_e.abs_g_score = tentative_g_score;
+			search_e.abs_f_score = search_e.f_score - search_e.g_score;
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			if (new_point) {
+				AStar3D::_open_list_push(r_state, e);
+			} else { // The point only moves up, its position in the open list is already known.
+				AStar3D::_open_list_sift_up(r_state, search_e.open_index, e);
 			}
 		}
 	}
@@ -917,6 +1079,7 @@ void AStar2D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStar2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStar2D::get_id_paths, DEFVAL(false));
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -34,6 +34,10 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/typed_array.h"
+
+class AStar2D;
 
 /**
 	A* pathfinding algorithm.
@@ -51,31 +55,44 @@ class AStar3D : public RefCounted {
 		real_t weight_scale = 0;
 		bool enabled = false;
 
+		// Index of the point's state in SearchState::search_points.
+		uint32_t search_index = 0;
+
 		OAHashMap<int64_t, Point *> neighbors = 4u;
 		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
+	};
 
-		// Used for pathfinding.
+	// Pathfinding state of a point. Kept apart from Point so several searches can run at the same time.
+	struct SearchPoint {
 		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
 		uint64_t open_pass = 0;
 		uint64_t closed_pass = 0;
+		uint32_t open_index = 0; // Position in the open list, to move the point up when a better path to it is found.
 
 		// Used for getting closest_point_of_last_pathing_call.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
-				return true;
-			} else if (A->f_score < B->f_score) {
-				return false;
-			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
-			}
-		}
+	// Reused between searches, so only a growing graph causes allocations.
+	struct SearchState {
+		LocalVector<SearchPoint> search_points;
+		LocalVector<Point *> open_list;
+		uint64_t pass = 1;
+		Point *last_closest_point = nullptr;
+	};
+
+	struct IdPathBatch {
+		AStar3D *astar_3d = nullptr;
+		AStar2D *astar_2d = nullptr;
+		const int64_t *from_ids = nullptr;
+		const int64_t *to_ids = nullptr;
+		bool allow_partial_path = false;
+		LocalVector<Vector<int64_t>> paths;
+		SafeNumeric<uint32_t> next_path;
+		LocalVector<SearchState> *search_states = nullptr;
 	};
 
 	struct Segment {
@@ -109,13 +126,27 @@ class AStar3D : public RefCounted {
 	};
 
 	int64_t last_free_id = 0;
-	uint64_t pass = 1;
 
 	OAHashMap<int64_t, Point *> points;
 	HashSet<Segment, Segment> segments;
-	Point *last_closest_point = nullptr;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	uint32_t search_index_count = 0;
+	LocalVector<uint32_t> free_search_indices;
+
+	SearchState search_state;
+	LocalVector<SearchState> batch_search_states;
+
+	static bool _is_worse(const SearchState &p_state, const Point *p_a, const Point *p_b);
+	static void _open_list_sift_up(SearchState &r_state, uint32_t p_hole, Point *p_point);
+	static void _open_list_push(SearchState &r_state, Point *p_point);
+	static void _open_list_pop(SearchState &r_state);
+	void _begin_search(SearchState &r_state) const;
+
+	bool _solve(Point *begin_point, Point *end_point, SearchState &r_state);
+	Vector<int64_t> _get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path, SearchState &r_state);
+
+	static void _id_path_batch_task(void *p_userdata, uint32_t p_index);
+	TypedArray<PackedInt64Array> _run_id_path_batch(IdPathBatch &r_batch, int64_t p_path_count, bool p_use_threads);
 
 protected:
 	static void _bind_methods();
@@ -162,6 +193,7 @@ public:
 
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 
 	AStar3D() {}
 	~AStar3D();
@@ -169,9 +201,11 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
 	AStar3D astar;
 
-	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point);
+	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, AStar3D::SearchState &r_state);
+	Vector<int64_t> _get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path, AStar3D::SearchState &r_state);
 
 protected:
 	static void _bind_methods();
@@ -218,6 +252,7 @@ public:
 
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path = false);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids, bool p_allow_partial_path = false);
 
 	AStar2D() {}
 	~AStar2D() {}
@@ -60,6 +60,18 @@ static real_t heuristic_chebyshev(const Vector2i &p_from, const Vector2i &p_to)
 
 static real_t (*heuristics[AStarGrid2D::HEURISTIC_MAX])(const Vector2i &, const Vector2i &) = { heuristic_euclidean, heuristic_manhattan, heuristic_octile, heuristic_chebyshev };
 
+// Indexed by AStarGrid2D::Direction.
+static const Vector2i grid_directions[] = {
+	Vector2i(0, -1),
+	Vector2i(1, 0),
+	Vector2i(0, 1),
+	Vector2i(-1, 0),
+	Vector2i(-1, -1),
+	Vector2i(1, -1),
+	Vector2i(1, 1),
+	Vector2i(-1, 1),
+};
+
 void AStarGrid2D::set_region(const Rect2i &p_region) {
 	ERR_FAIL_COND(p_region.size.x < 0 || p_region.size.y < 0);
 	if (p_region != region) {
@@ -122,35 +134,75 @@ AStarGrid2D::CellShape AStarGrid2D::get_cell_shape() const {
 }
 
 void AStarGrid2D::update() {
-	points.clear();
+	const uint64_t point_count = uint64_t(region.size.x) * uint64_t(region.size.y);
+	ERR_FAIL_COND_MSG(point_count >= INVALID_POINT, vformat("Can't update the grid. Region %s has too many points.", region));
 
-	const int32_t end_x = region.get_end().x;
-	const int32_t end_y = region.get_end().y;
-	const Vector2 half_cell_size = cell_size / 2;
+	solid_mask.resize((point_count + 63) / 64);
+	for (uint64_t &bits : solid_mask) {
+		bits = 0;
+	}
+	weight_scales.reset();
+	jump_distances.reset();
+	jump_update_points.reset();
+	jump_distances_dirty = true;
+	search_points.reset();
+	open_list.reset();
 
-	for (int32_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
-		for (int32_t x = region.position.x; x < end_x; x++) {
-			Vector2 v = offset;
-			switch (cell_shape) {
-				case CELL_SHAPE_ISOMETRIC_RIGHT:
-					v += half_cell_size + Vector2(x + y, y - x) * half_cell_size;
-					break;
-				case CELL_SHAPE_ISOMETRIC_DOWN:
-					v += half_cell_size + Vector2(x - y, x + y) * half_cell_size;
-					break;
-				case CELL_SHAPE_SQUARE:
-					v += Vector2(x, y) * cell_size;
-					break;
-				default:
-					break;
-			}
-			line.push_back(Point(Vector2i(x, y), v));
+	dirty = false;
+}
+
+void AStarGrid2D::_set_solid(uint32_t p_index, bool p_solid) {
+	if (_is_solid(p_index) == p_solid) {
+		return;
+	}
+	if (p_solid) {
+		solid_mask[p_index >> 6] |= uint64_t(1) << (p_index & 63);
+	} else {
+		solid_mask[p_index >> 6] &= ~(uint64_t(1) << (p_index & 63));
+	}
+
+	if (!jump_distances_dirty) {
+		// Every changed point updates the lines of points around it, once there are many it's cheaper to update all the points.
+		if (uint64_t(jump_update_points.size() + 1) * uint64_t(region.size.x + region.size.y) > uint64_t(region.size.x) * uint64_t(region.size.y)) {
+			jump_update_points.clear();
+			jump_distances_dirty = true;
+		} else {
+			jump_update_points.push_back(p_index);
 		}
-		points.push_back(line);
 	}
+}
 
-	dirty = false;
+void AStarGrid2D::_set_weight_scale(uint32_t p_index, real_t p_weight_scale) {
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0) {
+			return;
+		}
+		weight_scales.resize(uint32_t(region.size.x) * uint32_t(region.size.y));
+		for (real_t &weight_scale : weight_scales) {
+			weight_scale = 1.0;
+		}
+	}
+	weight_scales[p_index] = p_weight_scale;
+}
+
+Vector2 AStarGrid2D::_get_point_position(const Vector2i &p_id) const {
+	const Vector2 half_cell_size = cell_size / 2;
+
+	Vector2 v = offset;
+	switch (cell_shape) {
+		case CELL_SHAPE_ISOMETRIC_RIGHT:
+			v += half_cell_size + Vector2(p_id.x + p_id.y, p_id.y - p_id.x) * half_cell_size;
+			break;
+		case CELL_SHAPE_ISOMETRIC_DOWN:
+			v += half_cell_size + Vector2(p_id.x - p_id.y, p_id.x + p_id.y) * half_cell_size;
+			break;
+		case CELL_SHAPE_SQUARE:
+			v += Vector2(p_id.x, p_id.y) * cell_size;
+			break;
+		default:
+			break;
+	}
+	return v;
 }
 
 bool AStarGrid2D::is_in_bounds(int32_t p_x, int32_t p_y) const {
@@ -167,6 +219,11 @@ bool AStarGrid2D::is_dirty() const {
 
 void AStarGrid2D::set_jumping_enabled(bool p_enabled) {
 	jumping_enabled = p_enabled;
+	if (!jumping_enabled) {
+		jump_distances.reset();
+		jump_update_points.reset();
+		jump_distances_dirty = true;
+	}
 }
 
 bool AStarGrid2D::is_jumping_enabled() const {
@@ -175,7 +232,10 @@ bool AStarGrid2D::is_jumping_enabled() const {
 
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
-	diagonal_mode = p_diagonal_mode;
+	if (diagonal_mode != p_diagonal_mode) {
+		diagonal_mode = p_diagonal_mode;
+		jump_distances_dirty = true;
+	}
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -203,26 +263,26 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	_get_point_unchecked(p_id)->solid = p_solid;
+	_set_solid(_get_point_index(p_id.x, p_id.y), p_solid);
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is disabled. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->solid;
+	return _is_solid(_get_point_index(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	_get_point_unchecked(p_id)->weight_scale = p_weight_scale;
+	_set_weight_scale(_get_point_index(p_id.x, p_id.y), p_weight_scale);
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, 0, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->weight_scale;
+	return _get_weight_scale(_get_point_index(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
@@ -234,7 +294,7 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->solid = p_solid;
+			_set_solid(_get_point_index(x, y), p_solid);
 		}
 	}
 }
@@ -249,164 +309,291 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->weight_scale = p_weight_scale;
+			_set_weight_scale(_get_point_index(x, y), p_weight_scale);
 		}
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	if (!p_to || p_to->solid) {
-		return nullptr;
-	}
-	if (p_to == end) {
-		return p_to;
+bool AStarGrid2D::_is_forced_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const {
+	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+		if (p_dx != 0 && p_dy != 0) {
+			return (_is_walkable(p_x - p_dx, p_y + p_dy) && !_is_walkable(p_x - p_dx, p_y)) || (_is_walkable(p_x + p_dx, p_y - p_dy) && !_is_walkable(p_x, p_y - p_dy));
+		} else if (p_dx != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + 1) && !_is_walkable(p_x, p_y + 1)) || (_is_walkable(p_x + p_dx, p_y - 1) && !_is_walkable(p_x, p_y - 1));
+		} else {
+			return (_is_walkable(p_x + 1, p_y + p_dy) && !_is_walkable(p_x + 1, p_y)) || (_is_walkable(p_x - 1, p_y + p_dy) && !_is_walkable(p_x - 1, p_y));
+		}
+	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+		if (p_dx != 0 && p_dy != 0) {
+			return (_is_walkable(p_x + p_dx, p_y + p_dy) && !_is_walkable(p_x, p_y + p_dy)) || !_is_walkable(p_x + p_dx, p_y);
+		} else if (p_dx != 0) {
+			return (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1)) || (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1));
+		} else {
+			return (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy)) || (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy));
+		}
+	} else { // DIAGONAL_MODE_NEVER
+		if (p_dx != 0) {
+			return (_is_walkable(p_x, p_y - 1) && !_is_walkable(p_x - p_dx, p_y - 1)) || (_is_walkable(p_x, p_y + 1) && !_is_walkable(p_x - p_dx, p_y + 1));
+		} else {
+			return (_is_walkable(p_x - 1, p_y) && !_is_walkable(p_x - 1, p_y - p_dy)) || (_is_walkable(p_x + 1, p_y) && !_is_walkable(p_x + 1, p_y - p_dy));
+		}
 	}
+}
 
-	int32_t from_x = p_from->id.x;
-	int32_t from_y = p_from->id.y;
+// Positive results are the steps to the next jump point, other results are minus the steps that can be taken before getting blocked.
+int32_t AStarGrid2D::_compute_jump_distance(int32_t p_x, int32_t p_y, Direction p_direction) const {
+	const Vector2i dir = grid_directions[p_direction];
+	const int32_t to_x = p_x + dir.x;
+	const int32_t to_y = p_y + dir.y;
 
-	int32_t to_x = p_to->id.x;
-	int32_t to_y = p_to->id.y;
+	if (!_is_walkable(to_x, to_y)) {
+		return 0;
+	}
+	if (_is_forced_jump_point(to_x, to_y, dir.x, dir.y)) {
+		return 1;
+	}
 
-	int32_t dx = to_x - from_x;
-	int32_t dy = to_y - from_y;
+	const int16_t *to_distances = &jump_distances[_get_point_index(to_x, to_y) * DIRECTION_MAX];
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
-					return p_to;
-				}
-			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+	// A point which starts a straight jump that finds a jump point is a jump point too.
+	if (diagonal_mode == DIAGONAL_MODE_NEVER) {
+		if (dir.y != 0 && (to_distances[DIRECTION_RIGHT] > 0 || to_distances[DIRECTION_LEFT] > 0)) {
+			return 1;
 		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
-					return p_to;
-				}
-			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
-					return p_to;
-				}
-			}
+	} else if (dir.x != 0 && dir.y != 0) {
+		if (to_distances[dir.x > 0 ? DIRECTION_RIGHT : DIRECTION_LEFT] > 0 || to_distances[dir.y > 0 ? DIRECTION_BOTTOM : DIRECTION_TOP] > 0) {
+			return 1;
 		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+	}
+
+	bool can_continue = true;
+	switch (diagonal_mode) {
+		case DIAGONAL_MODE_ALWAYS: {
+			can_continue = _is_walkable(to_x + dir.x, to_y + dir.y);
+		} break;
+		case DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE: {
+			can_continue = _is_walkable(to_x + dir.x, to_y + dir.y) && (_is_walkable(to_x + dir.x, to_y) || _is_walkable(to_x, to_y + dir.y));
+		} break;
+		case DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES: {
+			can_continue = _is_walkable(to_x + dir.x, to_y + dir.y) && _is_walkable(to_x + dir.x, to_y) && _is_walkable(to_x, to_y + dir.y);
+		} break;
+		default:
+			break;
+	}
+	if (!can_continue) {
+		return -1;
+	}
+
+	// Distances that don't fit make the next point a jump point, which only adds a point to the paths going through it.
+	const int32_t distance = to_distances[p_direction];
+	if (distance > 0) {
+		return distance < INT16_MAX ? distance + 1 : 1;
+	}
+	return distance > -INT16_MAX ? distance - 1 : 1;
+}
+
+void AStarGrid2D::_update_jump_distances() {
+	jump_distances.resize(uint32_t(region.size.x) * uint32_t(region.size.y) * DIRECTION_MAX);
+
+	// The straight jumps go first since the other ones start straight jumps from every point they visit.
+	static const Direction direction_order[DIRECTION_MAX] = {
+		DIRECTION_RIGHT,
+		DIRECTION_LEFT,
+		DIRECTION_TOP,
+		DIRECTION_BOTTOM,
+		DIRECTION_TOP_LEFT,
+		DIRECTION_TOP_RIGHT,
+		DIRECTION_BOTTOM_RIGHT,
+		DIRECTION_BOTTOM_LEFT,
+	};
+
+	const int32_t end_x = region.get_end().x;
+	const int32_t end_y = region.get_end().y;
+
+	for (const Direction direction : direction_order) {
+		if (diagonal_mode == DIAGONAL_MODE_NEVER && direction >= DIRECTION_TOP_LEFT) {
+			break;
 		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
-				return p_to;
-			}
-		} else if (dy != 0) {
-			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
+
+		// Points are visited against the direction, so the distances of the next point are always known.
+		const Vector2i dir = grid_directions[direction];
+		for (int32_t i = 0; i < region.size.y; i++) {
+			const int32_t y = dir.y > 0 ? end_y - 1 - i : region.position.y + i;
+			for (int32_t j = 0; j < region.size.x; j++) {
+				const int32_t x = dir.x > 0 ? end_x - 1 - j : region.position.x + j;
+				jump_distances[_get_point_index(x, y) * DIRECTION_MAX + direction] = _compute_jump_distance(x, y, direction);
 			}
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
 	}
-	return nullptr;
-}
 
-void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
-	bool ts0 = false, td0 = false,
-		 ts1 = false, td1 = false,
-		 ts2 = false, td2 = false,
-		 ts3 = false, td3 = false;
+	jump_update_points.clear();
+	jump_distances_dirty = false;
+}
 
-	Point *left = nullptr;
-	Point *right = nullptr;
-	Point *top = nullptr;
-	Point *bottom = nullptr;
+void AStarGrid2D::_update_jump_distance_line(int32_t p_x, int32_t p_y, Direction p_direction, LocalVector<uint32_t> *r_changed_points) {
+	const Vector2i dir = grid_directions[p_direction];
 
-	Point *top_left = nullptr;
-	Point *top_right = nullptr;
-	Point *bottom_left = nullptr;
-	Point *bottom_right = nullptr;
+	// Points are visited against the direction, so the last point of the line goes first.
+	int32_t x = p_x;
+	int32_t y = p_y;
+	while (region.has_point(Vector2i(x + dir.x, y + dir.y))) {
+		x += dir.x;
+		y += dir.y;
+	}
 
-	{
-		bool has_left = false;
-		bool has_right = false;
+	for (; region.has_point(Vector2i(x, y)); x -= dir.x, y -= dir.y) {
+		const uint32_t index = _get_point_index(x, y);
+		int16_t &distance = jump_distances[index * DIRECTION_MAX + p_direction];
+		const int16_t new_distance = _compute_jump_distance(x, y, p_direction);
+		if (r_changed_points && (distance > 0) != (new_distance > 0)) {
+			r_changed_points->push_back(index);
+		}
+		distance = new_distance;
+	}
+}
+
+void AStarGrid2D::_update_changed_jump_distances() {
+	const int32_t width = region.size.x;
+	const int32_t height = region.size.y;
+	const bool use_diagonals = diagonal_mode != DIAGONAL_MODE_NEVER;
+
+	// The jump distances of a point only depend on the points on its lines and the points next to them.
+	// Rows and columns are indexed from the region position, diagonals by x - y + height - 1 and anti-diagonals by x + y.
+	LocalVector<bool> rows;
+	LocalVector<bool> columns;
+	LocalVector<bool> diagonals;
+	LocalVector<bool> anti_diagonals;
+	rows.resize(height);
+	columns.resize(width);
+	diagonals.resize(width + height - 1);
+	anti_diagonals.resize(width + height - 1);
+	for (LocalVector<bool> *lines : { &rows, &columns, &diagonals, &anti_diagonals }) {
+		for (bool &marked : *lines) {
+			marked = false;
+		}
+	}
 
-		if (p_point->id.x - 1 >= region.position.x) {
-			left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y);
-			has_left = true;
+	auto mark_lines = [](LocalVector<bool> &r_lines, int32_t p_from, int32_t p_to) {
+		for (int32_t i = MAX(p_from, 0); i <= MIN(p_to, int32_t(r_lines.size()) - 1); i++) {
+			r_lines[i] = true;
 		}
-		if (p_point->id.x + 1 < region.position.x + region.size.width) {
-			right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y);
-			has_right = true;
+	};
+
+	for (uint32_t point : jump_update_points) {
+		const int32_t x = int32_t(point % uint32_t(width));
+		const int32_t y = int32_t(point / uint32_t(width));
+		mark_lines(rows, y - 1, y + 1);
+		mark_lines(columns, x - 1, x + 1);
+		if (use_diagonals) {
+			mark_lines(diagonals, x - y + height - 1 - 2, x - y + height - 1 + 2);
+			mark_lines(anti_diagonals, x + y - 2, x + y + 2);
 		}
-		if (p_point->id.y - 1 >= region.position.y) {
-			top = _get_point_unchecked(p_point->id.x, p_point->id.y - 1);
-			if (has_left) {
-				top_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y - 1);
-			}
-			if (has_right) {
-				top_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y - 1);
+	}
+	jump_update_points.clear();
+
+	// Straight jump distances which started or stopped finding a jump point change the jump distances that start straight jumps from their points.
+	LocalVector<uint32_t> changed_points;
+	auto mark_changed_points = [&]() {
+		for (uint32_t point : changed_points) {
+			const int32_t x = int32_t(point % uint32_t(width));
+			const int32_t y = int32_t(point / uint32_t(width));
+			if (use_diagonals) {
+				diagonals[x - y + height - 1] = true;
+				anti_diagonals[x + y] = true;
+			} else {
+				columns[x] = true;
 			}
 		}
-		if (p_point->id.y + 1 < region.position.y + region.size.height) {
-			bottom = _get_point_unchecked(p_point->id.x, p_point->id.y + 1);
-			if (has_left) {
-				bottom_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y + 1);
-			}
-			if (has_right) {
-				bottom_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y + 1);
-			}
+		changed_points.clear();
+	};
+
+	for (int32_t y = 0; y < height; y++) {
+		if (rows[y]) {
+			_update_jump_distance_line(region.position.x, region.position.y + y, DIRECTION_RIGHT, &changed_points);
+			_update_jump_distance_line(region.position.x, region.position.y + y, DIRECTION_LEFT, &changed_points);
 		}
 	}
+	mark_changed_points();
 
-	if (top && !top->solid) {
-		r_nbors.push_back(top);
-		ts0 = true;
+	for (int32_t x = 0; x < width; x++) {
+		if (columns[x]) {
+			_update_jump_distance_line(region.position.x + x, region.position.y, DIRECTION_TOP, &changed_points);
+			_update_jump_distance_line(region.position.x + x, region.position.y, DIRECTION_BOTTOM, &changed_points);
+		}
 	}
-	if (right && !right->solid) {
-		r_nbors.push_back(right);
-		ts1 = true;
+
+	if (!use_diagonals) {
+		return;
 	}
-	if (bottom && !bottom->solid) {
-		r_nbors.push_back(bottom);
-		ts2 = true;
+	mark_changed_points();
+
+	for (int32_t i = 0; i < width + height - 1; i++) {
+		if (diagonals[i]) {
+			const int32_t x_minus_y = i - (height - 1);
+			const Vector2i start = region.position + (x_minus_y >= 0 ? Vector2i(x_minus_y, 0) : Vector2i(0, -x_minus_y));
+			_update_jump_distance_line(start.x, start.y, DIRECTION_TOP_LEFT);
+			_update_jump_distance_line(start.x, start.y, DIRECTION_BOTTOM_RIGHT);
+		}
+		if (anti_diagonals[i]) {
+			const Vector2i start = region.position + (i < width ? Vector2i(i, 0) : Vector2i(width - 1, i - (width - 1)));
+			_update_jump_distance_line(start.x, start.y, DIRECTION_TOP_RIGHT);
+			_update_jump_distance_line(start.x, start.y, DIRECTION_BOTTOM_LEFT);
+		}
 	}
-	if (left && !left->solid) {
-		r_nbors.push_back(left);
-		ts3 = true;
+}
+
+uint32_t AStarGrid2D::_jump(const Vector2i &p_from, uint32_t p_from_index, Direction p_direction, const Vector2i &p_end) const {
+	const Vector2i dir = grid_directions[p_direction];
+	const int32_t distance = jump_distances[p_from_index * DIRECTION_MAX + p_direction];
+	const int32_t reach = ABS(distance); // The amount of points visited by the jump.
+	int32_t steps = distance > 0 ? distance : INT32_MAX;
+
+	// Whether the straight jump started from p_point visits the end point, p_steps away from it.
+	auto straight_jump_visits_end = [&](const Vector2i &p_point, int32_t p_steps, Direction p_straight_direction) -> bool {
+		if (p_steps <= 0) {
+			return p_steps == 0;
+		}
+		return ABS(jump_distances[_get_point_index(p_point.x, p_point.y) * DIRECTION_MAX + p_straight_direction]) >= p_steps;
+	};
+
+	// The end point stops the jump early if it's visited, either directly or by the straight jumps started from the visited points.
+	const Vector2i to_end = p_end - p_from;
+	if (dir.x != 0 && dir.y != 0) {
+		const int32_t steps_x = to_end.x * dir.x;
+		if (steps_x > 0 && steps_x <= reach && steps_x < steps && straight_jump_visits_end(p_from + dir * steps_x, to_end.y * dir.y - steps_x, dir.y > 0 ? DIRECTION_BOTTOM : DIRECTION_TOP)) {
+			steps = steps_x;
+		}
+		const int32_t steps_y = to_end.y * dir.y;
+		if (steps_y > 0 && steps_y <= reach && steps_y < steps && straight_jump_visits_end(p_from + dir * steps_y, to_end.x * dir.x - steps_y, dir.x > 0 ? DIRECTION_RIGHT : DIRECTION_LEFT)) {
+			steps = steps_y;
+		}
+	} else if (dir.y != 0 && diagonal_mode == DIAGONAL_MODE_NEVER) {
+		const int32_t steps_y = to_end.y * dir.y;
+		if (steps_y > 0 && steps_y <= reach && steps_y < steps && straight_jump_visits_end(p_from + dir * steps_y, ABS(to_end.x), to_end.x > 0 ? DIRECTION_RIGHT : DIRECTION_LEFT)) {
+			steps = steps_y;
+		}
+	} else {
+		const int32_t steps_to_end = to_end.x * dir.x + to_end.y * dir.y;
+		if ((dir.x != 0 ? to_end.y : to_end.x) == 0 && steps_to_end > 0 && steps_to_end <= reach && steps_to_end < steps) {
+			steps = steps_to_end;
+		}
 	}
 
+	if (steps == INT32_MAX) {
+		return INVALID_POINT;
+	}
+	const Vector2i to = p_from + dir * steps;
+	return _get_point_index(to.x, to.y);
+}
+
+uint32_t AStarGrid2D::_get_nbors(const Vector2i &p_id) const {
+	const bool ts0 = _is_walkable(p_id.x, p_id.y - 1);
+	const bool ts1 = _is_walkable(p_id.x + 1, p_id.y);
+	const bool ts2 = _is_walkable(p_id.x, p_id.y + 1);
+	const bool ts3 = _is_walkable(p_id.x - 1, p_id.y);
+
+	bool td0 = false, td1 = false, td2 = false, td3 = false;
+
 	switch (diagonal_mode) {
 		case DIAGONAL_MODE_ALWAYS: {
 			td0 = true;
@@ -432,46 +619,132 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !top_left->solid)) {
-		r_nbors.push_back(top_left);
+	uint32_t nbors = 0;
+	nbors |= uint32_t(ts0) << DIRECTION_TOP;
+	nbors |= uint32_t(ts1) << DIRECTION_RIGHT;
+	nbors |= uint32_t(ts2) << DIRECTION_BOTTOM;
+	nbors |= uint32_t(ts3) << DIRECTION_LEFT;
+	nbors |= uint32_t(td0 && _is_walkable(p_id.x - 1, p_id.y - 1)) << DIRECTION_TOP_LEFT;
+	nbors |= uint32_t(td1 && _is_walkable(p_id.x + 1, p_id.y - 1)) << DIRECTION_TOP_RIGHT;
+	nbors |= uint32_t(td2 && _is_walkable(p_id.x + 1, p_id.y + 1)) << DIRECTION_BOTTOM_RIGHT;
+	nbors |= uint32_t(td3 && _is_walkable(p_id.x - 1, p_id.y + 1)) << DIRECTION_BOTTOM_LEFT;
+	return nbors;
+}
+
+bool AStarGrid2D::_is_worse(uint32_t p_a, uint32_t p_b) const {
+	const SearchPoint &a = search_points[p_a];
+	const SearchPoint &b = search_points[p_b];
+	if (a.f_score > b.f_score) {
+		return true;
+	} else if (a.f_score < b.f_score) {
+		return false;
+	} else {
+		return a.g_score < b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 	}
-	if (td1 && (top_right && !top_right->solid)) {
-		r_nbors.push_back(top_right);
+}
+
+void AStarGrid2D::_open_list_sift_up(uint32_t p_hole, uint32_t p_point) {
+	while (p_hole > 0) {
+		const uint32_t parent = (p_hole - 1) / 2;
+		if (!_is_worse(open_list[parent], p_point)) {
+			break;
+		}
+		open_list[p_hole] = open_list[parent];
+		search_points[open_list[p_hole]].open_index = p_hole;
+		p_hole = parent;
+	}
+
+	open_list[p_hole] = p_point;
+	search_points[p_point].open_index = p_hole;
+}
+
+void AStarGrid2D::_open_list_push(uint32_t p_point) {
+	open_list.push_back(p_point);
+	_open_list_sift_up(open_list.size() - 1, p_point);
+}
+
+void AStarGrid2D::_open_list_pop() {
+	const uint32_t size = open_list.size() - 1;
+	const uint32_t last = open_list[size];
+	open_list.resize(size);
+	if (size == 0) {
+		return;
 	}
-	if (td2 && (bottom_right && !bottom_right->solid)) {
-		r_nbors.push_back(bottom_right);
+
+	// Moves the hole left by the first point down to a leaf, then lets the last point rise from there.
+	uint32_t hole = 0;
+	uint32_t child = 2;
+	while (child < size) {
+		if (_is_worse(open_list[child], open_list[child - 1])) {
+			child--;
+		}
+		open_list[hole] = open_list[child];
+		search_points[open_list[hole]].open_index = hole;
+		hole = child;
+		child = 2 * (child + 1);
 	}
-	if (td3 && (bottom_left && !bottom_left->solid)) {
-		r_nbors.push_back(bottom_left);
+	if (child == size) {
+		open_list[hole] = open_list[child - 1];
+		search_points[open_list[hole]].open_index = hole;
+		hole = child - 1;
 	}
+
+	_open_list_sift_up(hole, last);
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
-	last_closest_point = nullptr;
+bool AStarGrid2D::_solve(uint32_t p_begin_point, uint32_t p_end_point) {
+	last_closest_point = INVALID_POINT;
+
+	const uint32_t point_count = uint32_t(region.size.x) * uint32_t(region.size.y);
+	if (search_points.size() < point_count) {
+		search_points.resize(point_count);
+	}
 	pass++;
+	if (pass == 0) { // Wrapped around, the old passes can't be told apart from the new ones anymore.
+		for (SearchPoint &search_point : search_points) {
+			search_point.open_pass = 0;
+			search_point.closed_pass = 0;
+		}
+		pass = 1;
+	}
 
-	if (p_end_point->solid) {
+	if (_is_solid(p_end_point)) {
 		return false;
 	}
 
+	if (jumping_enabled) {
+		if (jump_distances_dirty) {
+			_update_jump_distances();
+		} else if (!jump_update_points.is_empty()) {
+			_update_changed_jump_distances();
+		}
+	}
+
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	const Vector2i begin_id = _get_point_id(p_begin_point);
+	const Vector2i end_id = _get_point_id(p_end_point);
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
-	end = p_end_point;
+	SearchPoint &search_begin = search_points[p_begin_point];
+	search_begin.g_score = 0;
+	search_begin.f_score = _estimate_cost(begin_id, end_id);
+	search_begin.abs_g_score = 0;
+	search_begin.abs_f_score = _estimate_cost(begin_id, end_id);
+	open_list.clear();
+	_open_list_push(p_begin_point);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const uint32_t p = open_list[0]; // The currently processed point.
+		SearchPoint &search_p = search_points[p];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
+		if (last_closest_point == INVALID_POINT) {
 			last_closest_point = p;
+		} else {
+			const SearchPoint &search_closest = search_points[last_closest_point];
+			if (search_closest.abs_f_score > search_p.abs_f_score || (search_closest.abs_f_score >= search_p.abs_f_score && search_closest.abs_g_score > search_p.abs_g_score)) {
+				last_closest_point = p;
+			}
 		}
 
 		if (p == p_end_point) {
@@ -479,51 +752,58 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
 			break;
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		_open_list_pop(); // Remove the current point from the open list.
+		search_p.closed_pass = pass; // Mark the point as closed.
+
+		const Vector2i point_id = _get_point_id(p);
+		const uint32_t nbors = _get_nbors(point_id);
 
-		LocalVector<Point *> nbors;
-		_get_nbors(p, nbors);
+		for (uint32_t i = 0; i < DIRECTION_MAX; i++) {
+			if (!(nbors & (1 << i))) {
+				continue;
+			}
 
-		for (Point *e : nbors) {
+			uint32_t e; // The neighbor point.
 			real_t weight_scale = 1.0;
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(point_id, p, Direction(i), end_id);
+				if (e == INVALID_POINT || search_points[e].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				e = _get_point_index(point_id.x + grid_directions[i].x, point_id.y + grid_directions[i].y);
+				if (search_points[e].closed_pass == pass) {
 					continue;
 				}
-				weight_scale = e->weight_scale;
+				weight_scale = _get_weight_scale(e);
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			SearchPoint &search_e = search_points[e];
+			const Vector2i nbor_id = _get_point_id(e);
+
+			real_t tentative_g_score = search_p.g_score + _compute_cost(point_id, nbor_id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
+			if (search_e.open_pass != pass) { // The point wasn't inside the open list.
+				search_e.open_pass = pass;
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= search_e.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			search_e.prev_point = p;
+			search_e.g_score = tentative_g_score;
+			search_e.f_score = search_e.g_score + _estimate_cost(nbor_id, end_id);
 
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			search_e.abs_g_score = tentative_g_score;
+			search_e.abs_f_score = search_e.f_score - search_e.g_score;
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+			if (new_point) {
+				_open_list_push(e);
+			} else { // The point only moves up, its position in the open list is already known.
+				_open_list_sift_up(search_e.open_index, e);
 			}
 		}
 	}
@@ -548,14 +828,20 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
-	points.clear();
+	solid_mask.reset();
+	weight_scales.reset();
+	jump_distances.reset();
+	jump_update_points.reset();
+	jump_distances_dirty = true;
+	search_points.reset();
+	open_list.reset();
 	region = Rect2i();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return _get_point_unchecked(p_id)->pos;
+	return _get_point_position(p_id);
 }
 
 Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id, bool p_allow_partial_path) {
@@ -563,21 +849,18 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
+	uint32_t begin_point = _get_point_index(p_from_id.x, p_from_id.y);
+	uint32_t end_point = _get_point_index(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
+	if (begin_point == end_point) {
 		Vector<Vector2> ret;
-		ret.push_back(a->pos);
+		ret.push_back(_get_point_position(p_from_id));
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
 	bool found_route = _solve(begin_point, end_point);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || last_closest_point == INVALID_POINT) {
 			return Vector<Vector2>();
 		}
 
@@ -585,11 +868,11 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		end_point = last_closest_point;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = search_points[p].prev_point;
 	}
 
 	Vector<Vector2> path;
@@ -601,11 +884,11 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 		p = end_point;
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+			w[idx--] = _get_point_position(_get_point_id(p));
+			p = search_points[p].prev_point;
 		}
 
-		w[0] = p->pos;
+		w[0] = _get_point_position(p_from_id);
 	}
 
 	return path;
@@ -616,21 +899,18 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
+	uint32_t begin_point = _get_point_index(p_from_id.x, p_from_id.y);
+	uint32_t end_point = _get_point_index(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
+	if (begin_point == end_point) {
 		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
+		ret.push_back(p_from_id);
 		return ret;
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
 	bool found_route = _solve(begin_point, end_point);
 	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
+		if (!p_allow_partial_path || last_closest_point == INVALID_POINT) {
 			return TypedArray<Vector2i>();
 		}
 
@@ -638,11 +918,11 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 		end_point = last_closest_point;
 	}
 
-	Point *p = end_point;
+	uint32_t p = end_point;
 	int32_t pc = 1;
 	while (p != begin_point) {
 		pc++;
-		p = p->prev_point;
+		p = search_points[p].prev_point;
 	}
 
 	TypedArray<Vector2i> path;
@@ -652,11 +932,11 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 		p = end_point;
 		int32_t idx = pc - 1;
 		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+			path[idx--] = _get_point_id(p);
+			p = search_points[p].prev_point;
 		}
 
-		path[0] = p->id;
+		path[0] = p_from_id;
 	}
 
 	return path;
@@ -75,78 +75,92 @@ private:
 	Heuristic default_compute_heuristic = HEURISTIC_EUCLIDEAN;
 	Heuristic default_estimate_heuristic = HEURISTIC_EUCLIDEAN;
 
-	struct Point {
-		Vector2i id;
-
-		bool solid = false;
-		Vector2 pos;
-		real_t weight_scale = 1.0;
+	// Points are stored as indices into the region, row by row.
+	static constexpr uint32_t INVALID_POINT = UINT32_MAX;
+
+	// Neighbor directions, in the order they are added to the open list.
+	enum Direction {
+		DIRECTION_TOP,
+		DIRECTION_RIGHT,
+		DIRECTION_BOTTOM,
+		DIRECTION_LEFT,
+		DIRECTION_TOP_LEFT,
+		DIRECTION_TOP_RIGHT,
+		DIRECTION_BOTTOM_RIGHT,
+		DIRECTION_BOTTOM_LEFT,
+		DIRECTION_MAX,
+	};
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+	// Used for pathfinding, reused between searches.
+	struct SearchPoint {
+		uint32_t prev_point = INVALID_POINT;
+		uint32_t open_index = 0; // Position of the point in open_list while it's open.
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
 		real_t g_score = 0;
 		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
 
 		// Used for getting last_closest_point.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
-
-		Point() {}
-
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
-				return true;
-			} else if (A->f_score < B->f_score) {
-				return false;
-			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
-			}
-		}
-	};
+	LocalVector<uint64_t> solid_mask; // One bit per point.
+	LocalVector<real_t> weight_scales; // Empty while all the points use the default weight scale of 1.0.
+
+	// Steps to the next jump point from every point in every direction, see _update_jump_distances().
+	LocalVector<int16_t> jump_distances;
+	bool jump_distances_dirty = true; // All the jump distances have to be computed.
+	LocalVector<uint32_t> jump_update_points; // Points that changed since, only the jump distances around them have to be updated.
 
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
+	LocalVector<SearchPoint> search_points;
+	LocalVector<uint32_t> open_list;
+	uint32_t last_closest_point = INVALID_POINT;
 
-	uint64_t pass = 1;
+	uint32_t pass = 1;
 
 private: // Internal routines.
+	_FORCE_INLINE_ uint32_t _get_point_index(int32_t p_x, int32_t p_y) const {
+		return uint32_t(p_y - region.position.y) * uint32_t(region.size.x) + uint32_t(p_x - region.position.x);
+	}
+
+	_FORCE_INLINE_ Vector2i _get_point_id(uint32_t p_index) const {
+		return Vector2i(region.position.x + int32_t(p_index % uint32_t(region.size.x)), region.position.y + int32_t(p_index / uint32_t(region.size.x)));
+	}
+
+	_FORCE_INLINE_ bool _is_solid(uint32_t p_index) const {
+		return solid_mask[p_index >> 6] & (uint64_t(1) << (p_index & 63));
+	}
+
 	_FORCE_INLINE_ bool _is_walkable(int32_t p_x, int32_t p_y) const {
 		if (region.has_point(Vector2i(p_x, p_y))) {
-			return !points[p_y - region.position.y][p_x - region.position.x].solid;
+			return !_is_solid(_get_point_index(p_x, p_y));
 		}
 		return false;
 	}
 
-	_FORCE_INLINE_ Point *_get_point(int32_t p_x, int32_t p_y) {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
-		}
-		return nullptr;
+	_FORCE_INLINE_ real_t _get_weight_scale(uint32_t p_index) const {
+		return weight_scales.is_empty() ? real_t(1.0) : weight_scales[p_index];
 	}
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(int32_t p_x, int32_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
-	}
+	void _set_solid(uint32_t p_index, bool p_solid);
+	void _set_weight_scale(uint32_t p_index, real_t p_weight_scale);
+	Vector2 _get_point_position(const Vector2i &p_id) const;
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(const Vector2i &p_id) {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
-	}
+	bool _is_forced_jump_point(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy) const;
+	int32_t _compute_jump_distance(int32_t p_x, int32_t p_y, Direction p_direction) const;
+	void _update_jump_distances();
+	void _update_jump_distance_line(int32_t p_x, int32_t p_y, Direction p_direction, LocalVector<uint32_t> *r_changed_points = nullptr);
+	void _update_changed_jump_distances();
+	uint32_t _jump(const Vector2i &p_from, uint32_t p_from_index, Direction p_direction, const Vector2i &p_end) const;
 
-	_FORCE_INLINE_ const Point *_get_point_unchecked(const Vector2i &p_id) const {
-		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
-	}
+	uint32_t _get_nbors(const Vector2i &p_id) const;
 
-	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	bool _is_worse(uint32_t p_a, uint32_t p_b) const;
+	void _open_list_sift_up(uint32_t p_hole, uint32_t p_point);
+	void _open_list_push(uint32_t p_point);
+	void _open_list_pop();
+	bool _solve(uint32_t p_begin_point, uint32_t p_end_point);
 
 protected:
 	static void _bind_methods();
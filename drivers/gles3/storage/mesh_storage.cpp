@@ -1971,6 +1971,50 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_instances(RID p_multimesh, const Vector<int> &p_instances, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+
+	uint32_t xform_stride = multimesh->xform_format == RS::MULTIMESH_TRANSFORM_2D ? 8 : 12;
+	uint32_t old_stride = xform_stride;
+	old_stride += multimesh->uses_colors ? 4 : 0;
+	old_stride += multimesh->uses_custom_data ? 4 : 0;
+	ERR_FAIL_COND(p_buffer.size() != (p_instances.size() * (int)old_stride));
+
+	if (p_instances.is_empty()) {
+		return;
+	}
+
+	_multimesh_make_local(multimesh);
+
+	// Only the regions containing the given instances are uploaded.
+	float *w = multimesh->data_cache.ptrw();
+	const int *instances = p_instances.ptr();
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		int index = instances[i];
+		ERR_CONTINUE(index < 0 || index >= multimesh->instances);
+
+		const float *dataptr = r + i * old_stride;
+		float *newptr = w + index * multimesh->stride_cache;
+		memcpy(newptr, dataptr, xform_stride * sizeof(float));
+
+		// Color and custom data are packed as half floats.
+		if (multimesh->uses_colors) {
+			const float *colorptr = dataptr + xform_stride;
+			uint16_t val[4] = { Math::make_half_float(colorptr[0]), Math::make_half_float(colorptr[1]), Math::make_half_float(colorptr[2]), Math::make_half_float(colorptr[3]) };
+			memcpy(newptr + multimesh->color_offset_cache, val, 2 * 4);
+		}
+		if (multimesh->uses_custom_data) {
+			const float *customptr = dataptr + xform_stride + (multimesh->uses_colors ? 4 : 0);
+			uint16_t val[4] = { Math::make_half_float(customptr[0]), Math::make_half_float(customptr[1]), Math::make_half_float(customptr[2]), Math::make_half_float(customptr[3]) };
+			memcpy(newptr + multimesh->custom_data_offset_cache, val, 2 * 4);
+		}
+
+		_multimesh_mark_dirty(multimesh, index, true);
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -201,6 +201,18 @@ void GodotNavigationServer2D::parse_source_geometry_data(const Ref<NavigationPol
 #endif // CLIPPER2_ENABLED
 }
 
+void GodotNavigationServer2D::parse_source_geometry_data_async(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation polygon.");
+	ERR_FAIL_NULL_MSG(p_root_node, "No parsing root node specified.");
+	ERR_FAIL_COND_MSG(!p_root_node->is_inside_tree(), "The root node needs to be inside the SceneTree.");
+
+#ifdef CLIPPER2_ENABLED
+	ERR_FAIL_NULL(NavMeshGenerator2D::get_singleton());
+	NavMeshGenerator2D::get_singleton()->parse_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_root_node, p_callback);
+#endif // CLIPPER2_ENABLED
+}
+
 void GodotNavigationServer2D::bake_from_source_geometry_data(const Ref<NavigationPolygon> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData2D> &p_source_geometry_data, const Callable &p_callback) {
 	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation polygon.");
 	ERR_FAIL_COND_MSG(!p_source_geometry_data.is_valid(), "Invalid NavigationMeshSourceGeometryData2D.");
@@ -282,6 +294,11 @@ Vector<Vector2> FORWARD_5_R_C(vector_v3_to_v2, map_get_path, RID, p_map, Vector2
 Vector2 FORWARD_2_R_C(v3_to_v2, map_get_closest_point, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
 RID FORWARD_2_C(map_get_closest_point_owner, RID, p_map, const Vector2 &, p_point, rid_to_rid, v2_to_v3);
 
+Vector2 GodotNavigationServer2D::map_get_flow_field_next_position(RID p_map, const Vector2 &p_origin, const Vector2 &p_destination, uint32_t p_navigation_layers) const {
+	Vector3 result = NavigationServer3D::get_singleton()->map_get_flow_field_next_position(p_map, v2_to_v3(p_origin), v2_to_v3(p_destination), p_navigation_layers);
+	return v3_to_v2(result);
+}
+
 Vector2 GodotNavigationServer2D::map_get_random_point(RID p_map, uint32_t p_naviation_layers, bool p_uniformly) const {
 	Vector3 result = NavigationServer3D::get_singleton()->map_get_random_point(p_map, p_naviation_layers, p_uniformly);
 	return v3_to_v2(result);
@@ -463,6 +480,31 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+int64_t GodotNavigationServer2D::query_paths_async(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), -1, "The number of path query parameters and results must match.");
+
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	LocalVector<Ref<RefCounted>> query_results;
+	parameters.resize(p_query_parameters.size());
+	query_results.resize(p_query_results.size());
+
+	for (uint32_t i = 0; i < parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		ERR_FAIL_COND_V(query_parameters.is_null(), -1);
+		ERR_FAIL_COND_V(query_result.is_null(), -1);
+
+		parameters[i] = query_parameters->get_parameters();
+		query_results[i] = query_result;
+	}
+
+	return NavigationServer3D::get_singleton()->_query_paths_async(parameters, query_results, p_callback);
+}
+
+bool GodotNavigationServer2D::is_path_query_finished(int64_t p_query_id) const {
+	return NavigationServer3D::get_singleton()->is_path_query_finished(p_query_id);
+}
+
 RID GodotNavigationServer2D::source_geometry_parser_create() {
 #ifdef CLIPPER2_ENABLED
 	if (navmesh_generator_2d) {
@@ -59,9 +59,105 @@ bool NavMeshGenerator2D::baking_use_multiple_threads = true;
 bool NavMeshGenerator2D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationPolygon>> NavMeshGenerator2D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator2D::NavMeshGeneratorTask2D *> NavMeshGenerator2D::generator_tasks;
+HashMap<WorkerThreadPool::TaskID, NavMeshGenerator2D::NavMeshGeneratorParseTask2D *> NavMeshGenerator2D::generator_parse_tasks;
 RID_Owner<NavMeshGenerator2D::NavMeshGeometryParser2D> NavMeshGenerator2D::generator_parser_owner;
 LocalVector<NavMeshGenerator2D::NavMeshGeometryParser2D *> NavMeshGenerator2D::generator_parsers;
 
+// The mesh geometry that the SceneTree parse collects from the nodes on the main thread.
+// Merging the mesh triangles into outlines does not touch any node, so it can be done on worker threads.
+struct NavMeshGeometrySnapshot2D {
+	struct SnapshotMesh {
+		LocalVector<RenderingServer::SurfaceData> surfaces;
+		LocalVector<Array> surface_arrays;
+		LocalVector<Vector<Vector2>> outlines;
+	};
+
+	struct MeshInstance {
+		uint32_t mesh_index = 0;
+		Transform2D transform;
+	};
+
+	// The parsed items in SceneTree order, so the outlines end up in the same order as when they were added directly.
+	struct Item {
+		enum Type {
+			MESH_INSTANCE,
+			GEOMETRY,
+		};
+
+		Type type = MESH_INSTANCE;
+		uint32_t index = 0;
+	};
+
+	Transform2D root_node_transform;
+
+	HashMap<Ref<Mesh>, uint32_t> mesh_indices;
+	LocalVector<SnapshotMesh> meshes;
+	LocalVector<MeshInstance> mesh_instances;
+	LocalVector<Ref<NavigationMeshSourceGeometryData2D>> geometries;
+	LocalVector<Item> items;
+
+	// What the other node parsers and custom parsers add for the node that is currently parsed.
+	Ref<NavigationMeshSourceGeometryData2D> node_geometry;
+
+	SafeNumeric<uint32_t> next_mesh;
+
+	void add_mesh_instance(uint32_t p_mesh_index, const Transform2D &p_transform) {
+		items.push_back({ Item::MESH_INSTANCE, mesh_instances.size() });
+		mesh_instances.push_back({ p_mesh_index, p_transform });
+	}
+
+	const Ref<NavigationMeshSourceGeometryData2D> &begin_node_geometry() {
+		if (node_geometry.is_null()) {
+			node_geometry.instantiate();
+			node_geometry->root_node_transform = root_node_transform;
+		}
+		return node_geometry;
+	}
+
+	void end_node_geometry() {
+		if (node_geometry->_get_traversable_outlines().is_empty() && node_geometry->_get_obstruction_outlines().is_empty() && node_geometry->_get_projected_obstructions().is_empty()) {
+			// Reused for the next node.
+			return;
+		}
+		items.push_back({ Item::GEOMETRY, geometries.size() });
+		geometries.push_back(node_geometry);
+		node_geometry.unref();
+	}
+};
+
+static uint32_t generator_snapshot_mesh(NavMeshGeometrySnapshot2D *p_snapshot, const Ref<Mesh> &p_mesh) {
+	const uint32_t *mesh_index = p_snapshot->mesh_indices.getptr(p_mesh);
+	if (mesh_index) {
+		return *mesh_index;
+	}
+
+	NavMeshGeometrySnapshot2D::SnapshotMesh snapshot_mesh;
+
+	// Only the readback from the RenderingServer needs the main thread, the surfaces are decoded later.
+	const bool is_rendering_server_mesh = Object::cast_to<ArrayMesh>(*p_mesh) != nullptr;
+
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		if (!(p_mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
+			continue;
+		}
+
+		if (is_rendering_server_mesh) {
+			snapshot_mesh.surfaces.push_back(RS::get_singleton()->mesh_get_surface(p_mesh->get_rid(), i));
+		} else {
+			snapshot_mesh.surface_arrays.push_back(p_mesh->surface_get_arrays(i));
+		}
+	}
+
+	const uint32_t new_mesh_index = p_snapshot->meshes.size();
+	p_snapshot->meshes.push_back(snapshot_mesh);
+	p_snapshot->mesh_indices.insert(p_mesh, new_mesh_index);
+	return new_mesh_index;
+}
+
 NavMeshGenerator2D *NavMeshGenerator2D::get_singleton() {
 	return singleton;
 }
@@ -83,7 +179,7 @@ NavMeshGenerator2D::~NavMeshGenerator2D() {
 }
 
 void NavMeshGenerator2D::sync() {
-	if (generator_tasks.size() == 0) {
+	if (generator_tasks.size() == 0 && generator_parse_tasks.size() == 0) {
 		return;
 	}
 
@@ -111,6 +207,28 @@ void NavMeshGenerator2D::sync() {
 	for (WorkerThreadPool::TaskID finished_task_id : finished_task_ids) {
 		generator_tasks.erase(finished_task_id);
 	}
+	finished_task_ids.clear();
+
+	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask2D *> &E : generator_parse_tasks) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(E.key)) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
+			finished_task_ids.push_back(E.key);
+
+			NavMeshGeneratorParseTask2D *parse_task = E.value;
+			memdelete(parse_task->snapshot);
+
+			// Cleared first so the callback can start the bake.
+			baking_navmeshes.erase(parse_task->navigation_mesh);
+			if (parse_task->callback.is_valid()) {
+				generator_emit_callback(parse_task->callback);
+			}
+			memdelete(parse_task);
+		}
+	}
+
+	for (WorkerThreadPool::TaskID finished_task_id : finished_task_ids) {
+		generator_parse_tasks.erase(finished_task_id);
+	}
 
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
@@ -129,6 +247,14 @@ void NavMeshGenerator2D::cleanup() {
 	}
 	generator_tasks.clear();
 
+	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask2D *> &E : generator_parse_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
+		NavMeshGeneratorParseTask2D *parse_task = E.value;
+		memdelete(parse_task->snapshot);
+		memdelete(parse_task);
+	}
+	generator_parse_tasks.clear();
+
 	generator_rid_rwlock.write_lock();
 	for (NavMeshGeometryParser2D *parser : generator_parsers) {
 		generator_parser_owner.free(parser->self);
@@ -151,13 +277,52 @@ void NavMeshGenerator2D::parse_source_geometry_data(Ref<NavigationPolygon> p_nav
 	ERR_FAIL_COND(!p_root_node->is_inside_tree());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
 
-	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_root_node);
+	NavMeshGeometrySnapshot2D *snapshot = memnew(NavMeshGeometrySnapshot2D);
+	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, snapshot, p_root_node);
+	generator_parse_snapshot(p_source_geometry_data, snapshot);
+	memdelete(snapshot);
 
 	if (p_callback.is_valid()) {
 		generator_emit_callback(p_callback);
 	}
 }
 
+void NavMeshGenerator2D::parse_source_geometry_data_async(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_NULL(p_root_node);
+	ERR_FAIL_COND(!p_root_node->is_inside_tree());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_MSG("NavigationPolygon is already baking. Wait for current bake to finish.");
+	}
+
+	if (!use_threads) {
+		parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_root_node, p_callback);
+		return;
+	}
+
+	// Counts as baking until the callback runs, so the same NavigationPolygon can not be parsed or baked again in the meantime.
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	NavMeshGeometrySnapshot2D *snapshot = memnew(NavMeshGeometrySnapshot2D);
+	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, snapshot, p_root_node);
+
+	// Only the SceneTree traversal has to happen on the main thread, the mesh outlines are built from the snapshot in the background.
+	generator_task_mutex.lock();
+	NavMeshGeneratorParseTask2D *parse_task = memnew(NavMeshGeneratorParseTask2D);
+	parse_task->navigation_mesh = p_navigation_mesh;
+	parse_task->source_geometry_data = p_source_geometry_data;
+	parse_task->snapshot = snapshot;
+	parse_task->callback = p_callback;
+	parse_task->thread_task_id = WorkerThreadPool::get_singleton()->add_native_task(&NavMeshGenerator2D::generator_thread_parse, parse_task, NavMeshGenerator2D::baking_use_high_priority_threads, "NavMeshGeneratorParse2D");
+	generator_parse_tasks.insert(parse_task->thread_task_id, parse_task);
+	generator_task_mutex.unlock();
+}
+
 void NavMeshGenerator2D::bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, const Callable &p_callback) {
 	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
@@ -238,125 +403,167 @@ void NavMeshGenerator2D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask2D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator2D::generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_polygon2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_staticbody2d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_tile_map_layer_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_navigationobstacle_node(p_navigation_mesh, p_source_geometry_data, p_node);
+void NavMeshGenerator2D::generator_thread_parse(void *p_arg) {
+	NavMeshGeneratorParseTask2D *parse_task = static_cast<NavMeshGeneratorParseTask2D *>(p_arg);
 
-	generator_rid_rwlock.read_lock();
-	for (const NavMeshGeometryParser2D *parser : generator_parsers) {
-		if (!parser->callback.is_valid()) {
-			continue;
-		}
-		parser->callback.call(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_snapshot(parse_task->source_geometry_data, parse_task->snapshot);
+}
+
+void NavMeshGenerator2D::generator_parse_snapshot(Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, NavMeshGeometrySnapshot2D *p_snapshot) {
+	// The outlines of every mesh are merged once, no matter how many nodes or MultiMesh instances use it.
+	const uint32_t mesh_count = p_snapshot->meshes.size();
+	if (use_threads && mesh_count > 1) {
+		const int task_count = MIN((int)mesh_count - 1, WorkerThreadPool::get_singleton()->get_thread_count());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator2D::generator_decode_snapshot_mesh_task, p_snapshot, task_count, -1, baking_use_high_priority_threads, "NavMeshGeneratorDecodeMeshes2D");
+		generator_decode_snapshot_mesh_task(p_snapshot, 0);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		generator_decode_snapshot_mesh_task(p_snapshot, 0);
 	}
-	generator_rid_rwlock.read_unlock();
 
-	if (p_recurse_children) {
-		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
+	for (const NavMeshGeometrySnapshot2D::Item &item : p_snapshot->items) {
+		if (item.type == NavMeshGeometrySnapshot2D::Item::GEOMETRY) {
+			p_source_geometry_data->merge(p_snapshot->geometries[item.index]);
+			continue;
 		}
-	} else if (Object::cast_to<TileMap>(p_node)) {
-		// Special case for TileMap, so that internal layer get parsed even if p_recurse_children is false.
-		for (int i = 0; i < p_node->get_child_count(); i++) {
-			TileMapLayer *tile_map_layer = Object::cast_to<TileMapLayer>(p_node->get_child(i));
-			if (tile_map_layer && tile_map_layer->get_index_in_tile_map() >= 0) {
-				generator_parse_tile_map_layer_node(p_navigation_mesh, p_source_geometry_data, tile_map_layer);
+
+		const NavMeshGeometrySnapshot2D::MeshInstance &mesh_instance = p_snapshot->mesh_instances[item.index];
+		for (const Vector<Vector2> &mesh_outline : p_snapshot->meshes[mesh_instance.mesh_index].outlines) {
+			Vector<Vector2> shape_outline;
+			shape_outline.resize(mesh_outline.size());
+
+			const Vector2 *mesh_outline_ptr = mesh_outline.ptr();
+			Vector2 *shape_outline_ptrw = shape_outline.ptrw();
+
+			for (int i = 0; i < mesh_outline.size(); i++) {
+				shape_outline_ptrw[i] = mesh_instance.transform.xform(mesh_outline_ptr[i]);
 			}
+
+			p_source_geometry_data->_add_obstruction_outline(shape_outline);
 		}
 	}
 }
 
-void NavMeshGenerator2D::generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
-	MeshInstance2D *mesh_instance = Object::cast_to<MeshInstance2D>(p_node);
+void NavMeshGenerator2D::generator_decode_snapshot_mesh_task(void *p_arg, uint32_t p_index) {
+	NavMeshGeometrySnapshot2D *snapshot = static_cast<NavMeshGeometrySnapshot2D *>(p_arg);
 
-	if (mesh_instance == nullptr) {
-		return;
-	}
+	using namespace Clipper2Lib;
 
-	NavigationPolygon::ParsedGeometryType parsed_geometry_type = p_navigation_mesh->get_parsed_geometry_type();
+	for (uint32_t i = snapshot->next_mesh.postincrement(); i < snapshot->meshes.size(); i = snapshot->next_mesh.postincrement()) {
+		NavMeshGeometrySnapshot2D::SnapshotMesh &snapshot_mesh = snapshot->meshes[i];
 
-	if (!(parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_BOTH)) {
-		return;
-	}
+		for (const RenderingServer::SurfaceData &surface : snapshot_mesh.surfaces) {
+			snapshot_mesh.surface_arrays.push_back(RS::get_singleton()->mesh_create_arrays_from_surface_data(surface));
+		}
+		snapshot_mesh.surfaces.clear();
 
-	Ref<Mesh> mesh = mesh_instance->get_mesh();
-	if (!mesh.is_valid()) {
-		return;
-	}
+		PathsD subject_paths, dummy_clip_paths;
 
-	const Transform2D mesh_instance_xform = p_source_geometry_data->root_node_transform * mesh_instance->get_global_transform();
+		for (const Array &a : snapshot_mesh.surface_arrays) {
+			ERR_CONTINUE(a.size() != Mesh::ARRAY_MAX);
 
-	using namespace Clipper2Lib;
+			Vector<Vector2> mesh_vertices = a[Mesh::ARRAY_VERTEX];
+			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
 
-	PathsD subject_paths, dummy_clip_paths;
+			const int index_count = mesh_indices.is_empty() ? mesh_vertices.size() : mesh_indices.size();
+			ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
 
-	for (int i = 0; i < mesh->get_surface_count(); i++) {
-		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
-			continue;
-		}
+			PathD subject_path;
 
-		if (!(mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
-			continue;
+			if (!mesh_indices.is_empty()) {
+				for (int vertex_index : mesh_indices) {
+					const Vector2 &vertex = mesh_vertices[vertex_index];
+					const PointD &point = PointD(vertex.x, vertex.y);
+					subject_path.push_back(point);
+				}
+			} else {
+				for (const Vector2 &vertex : mesh_vertices) {
+					const PointD &point = PointD(vertex.x, vertex.y);
+					subject_path.push_back(point);
+				}
+			}
+			subject_paths.push_back(subject_path);
 		}
+		snapshot_mesh.surface_arrays.clear();
 
-		PathD subject_path;
+		PathsD path_solution = Union(subject_paths, dummy_clip_paths, FillRule::NonZero);
 
-		int index_count = 0;
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			index_count = mesh->surface_get_array_index_len(i);
-		} else {
-			index_count = mesh->surface_get_array_len(i);
+		//path_solution = RamerDouglasPeucker(path_solution, 0.025);
+
+		for (const PathD &scaled_path : path_solution) {
+			Vector<Vector2> shape_outline;
+			for (const PointD &scaled_point : scaled_path) {
+				shape_outline.push_back(Point2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
+			}
+			snapshot_mesh.outlines.push_back(shape_outline);
 		}
+	}
+}
 
-		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
+void NavMeshGenerator2D::generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node, bool p_recurse_children) {
+	generator_parse_meshinstance2d_node(p_navigation_mesh, p_snapshot, p_node);
+	generator_parse_multimeshinstance2d_node(p_navigation_mesh, p_snapshot, p_node);
 
-		Array a = mesh->surface_get_arrays(i);
+	// Added to the snapshot after the meshes of this node, like they were added before the mesh outlines were built from a snapshot.
+	Ref<NavigationMeshSourceGeometryData2D> node_geometry = p_snapshot->begin_node_geometry();
 
-		Vector<Vector2> mesh_vertices = a[Mesh::ARRAY_VERTEX];
+	generator_parse_polygon2d_node(p_navigation_mesh, node_geometry, p_node);
+	generator_parse_staticbody2d_node(p_navigation_mesh, node_geometry, p_node);
+	generator_parse_tile_map_layer_node(p_navigation_mesh, node_geometry, p_node);
+	generator_parse_navigationobstacle_node(p_navigation_mesh, node_geometry, p_node);
 
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			for (int vertex_index : mesh_indices) {
-				const Vector2 &vertex = mesh_vertices[vertex_index];
-				const PointD &point = PointD(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
-		} else {
-			for (const Vector2 &vertex : mesh_vertices) {
-				const PointD &point = PointD(vertex.x, vertex.y);
-				subject_path.push_back(point);
+	generator_rid_rwlock.read_lock();
+	for (const NavMeshGeometryParser2D *parser : generator_parsers) {
+		if (!parser->callback.is_valid()) {
+			continue;
+		}
+		parser->callback.call(p_navigation_mesh, node_geometry, p_node);
+	}
+	generator_rid_rwlock.read_unlock();
+
+	if (!p_recurse_children && Object::cast_to<TileMap>(p_node)) {
+		// Special case for TileMap, so that internal layer get parsed even if p_recurse_children is false.
+		for (int i = 0; i < p_node->get_child_count(); i++) {
+			TileMapLayer *tile_map_layer = Object::cast_to<TileMapLayer>(p_node->get_child(i));
+			if (tile_map_layer && tile_map_layer->get_index_in_tile_map() >= 0) {
+				generator_parse_tile_map_layer_node(p_navigation_mesh, node_geometry, tile_map_layer);
 			}
 		}
-		subject_paths.push_back(subject_path);
 	}
 
-	PathsD path_solution;
+	p_snapshot->end_node_geometry();
 
-	path_solution = Union(subject_paths, dummy_clip_paths, FillRule::NonZero);
+	if (p_recurse_children) {
+		for (int i = 0; i < p_node->get_child_count(); i++) {
+			generator_parse_geometry_node(p_navigation_mesh, p_snapshot, p_node->get_child(i), p_recurse_children);
+		}
+	}
+}
 
-	//path_solution = RamerDouglasPeucker(path_solution, 0.025);
+void NavMeshGenerator2D::generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node) {
+	MeshInstance2D *mesh_instance = Object::cast_to<MeshInstance2D>(p_node);
 
-	Vector<Vector<Vector2>> polypaths;
+	if (mesh_instance == nullptr) {
+		return;
+	}
 
-	for (const PathD &scaled_path : path_solution) {
-		Vector<Vector2> shape_outline;
-		for (const PointD &scaled_point : scaled_path) {
-			shape_outline.push_back(Point2(static_cast<real_t>(scaled_point.x), static_cast<real_t>(scaled_point.y)));
-		}
+	NavigationPolygon::ParsedGeometryType parsed_geometry_type = p_navigation_mesh->get_parsed_geometry_type();
 
-		for (int i = 0; i < shape_outline.size(); i++) {
-			shape_outline.write[i] = mesh_instance_xform.xform(shape_outline[i]);
-		}
+	if (!(parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationPolygon::PARSED_GEOMETRY_BOTH)) {
+		return;
+	}
 
-		p_source_geometry_data->add_obstruction_outline(shape_outline);
+	Ref<Mesh> mesh = mesh_instance->get_mesh();
+	if (!mesh.is_valid()) {
+		return;
 	}
+
+	const Transform2D mesh_instance_xform = p_snapshot->root_node_transform * mesh_instance->get_global_transform();
+
+	p_snapshot->add_mesh_instance(generator_snapshot_mesh(p_snapshot, mesh), mesh_instance_xform);
 }
 
-void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node) {
 	MultiMeshInstance2D *multimesh_instance = Object::cast_to<MultiMeshInstance2D>(p_node);
 
 	if (multimesh_instance == nullptr) {
@@ -378,76 +585,17 @@ void NavMeshGenerator2D::generator_parse_multimeshinstance2d_node(const Ref<Navi
 		return;
 	}
 
-	using namespace Clipper2Lib;
-
-	PathsD mesh_subject_paths, dummy_clip_paths;
-
-	for (int i = 0; i < mesh->get_surface_count(); i++) {
-		if (mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
-			continue;
-		}
-
-		if (!(mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_2D_VERTICES)) {
-			continue;
-		}
-
-		PathD subject_path;
-
-		int index_count = 0;
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			index_count = mesh->surface_get_array_index_len(i);
-		} else {
-			index_count = mesh->surface_get_array_len(i);
-		}
-
-		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
-
-		Array a = mesh->surface_get_arrays(i);
-
-		Vector<Vector2> mesh_vertices = a[Mesh::ARRAY_VERTEX];
-
-		if (mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			for (int vertex_index : mesh_indices) {
-				const Vector2 &vertex = mesh_vertices[vertex_index];
-				const PointD &point = PointD(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
-		} else {
-			for (const Vector2 &vertex : mesh_vertices) {
-				const PointD &point = PointD(vertex.x, vertex.y);
-				subject_path.push_back(point);
-			}
-		}
-		mesh_subject_paths.push_back(subject_path);
-	}
-
-	PathsD mesh_path_solution = Union(mesh_subject_paths, dummy_clip_paths, FillRule::NonZero);
-
-	//path_solution = RamerDouglasPeucker(path_solution, 0.025);
+	const uint32_t mesh_index = generator_snapshot_mesh(p_snapshot, mesh);
 
 	int multimesh_instance_count = multimesh->get_visible_instance_count();
 	if (multimesh_instance_count == -1) {
 		multimesh_instance_count = multimesh->get_instance_count();
 	}
 
-	const Transform2D multimesh_instance_xform = p_source_geometry_data->root_node_transform * multimesh_instance->get_global_transform();
+	const Transform2D multimesh_instance_xform = p_snapshot->root_node_transform * multimesh_instance->get_global_transform();
 
 	for (int i = 0; i < multimesh_instance_count; i++) {
-		const Transform2D multimesh_instance_mesh_instance_xform = multimesh_instance_xform * multimesh->get_instance_transform_2d(i);
-
-		for (const PathD &mesh_path : mesh_path_solution) {
-			Vector<Vector2> shape_outline;
-
-			for (const PointD &mesh_path_point : mesh_path) {
-				shape_outline.push_back(Point2(static_cast<real_t>(mesh_path_point.x), static_cast<real_t>(mesh_path_point.y)));
-			}
-
-			for (int j = 0; j < shape_outline.size(); j++) {
-				shape_outline.write[j] = multimesh_instance_mesh_instance_xform.xform(shape_outline[j]);
-			}
-			p_source_geometry_data->add_obstruction_outline(shape_outline);
-		}
+		p_snapshot->add_mesh_instance(mesh_index, multimesh_instance_xform * multimesh->get_instance_transform_2d(i));
 	}
 }
 
@@ -738,7 +886,7 @@ void NavMeshGenerator2D::generator_parse_navigationobstacle_node(const Ref<Navig
 	p_source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_carve_navigation_mesh());
 }
 
-void NavMeshGenerator2D::generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node) {
+void NavMeshGenerator2D::generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_root_node) {
 	List<Node *> parse_nodes;
 
 	if (p_navigation_mesh->get_source_geometry_mode() == NavigationPolygon::SOURCE_GEOMETRY_ROOT_NODE_CHILDREN) {
@@ -754,11 +902,12 @@ void NavMeshGenerator2D::generator_parse_source_geometry_data(Ref<NavigationPoly
 
 	p_source_geometry_data->clear();
 	p_source_geometry_data->root_node_transform = root_node_transform;
+	p_snapshot->root_node_transform = root_node_transform;
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationPolygon::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
 	for (Node *E : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, E, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, p_snapshot, E, recurse_children);
 	}
 };
 
@@ -40,6 +40,7 @@
 class Node;
 class NavigationPolygon;
 class NavigationMeshSourceGeometryData2D;
+struct NavMeshGeometrySnapshot2D;
 
 class NavMeshGenerator2D : public Object {
 	static NavMeshGenerator2D *singleton;
@@ -79,14 +80,28 @@ class NavMeshGenerator2D : public Object {
 
 	static void generator_thread_bake(void *p_arg);
 
+	struct NavMeshGeneratorParseTask2D {
+		Ref<NavigationPolygon> navigation_mesh;
+		Ref<NavigationMeshSourceGeometryData2D> source_geometry_data;
+		NavMeshGeometrySnapshot2D *snapshot = nullptr;
+		Callable callback;
+		WorkerThreadPool::TaskID thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	static HashMap<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask2D *> generator_parse_tasks;
+
+	static void generator_thread_parse(void *p_arg);
+
 	static HashSet<Ref<NavigationPolygon>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
-	static void generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node);
+	static void generator_parse_geometry_node(Ref<NavigationPolygon> p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node, bool p_recurse_children);
+	static void generator_parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_root_node);
+	static void generator_parse_snapshot(Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, NavMeshGeometrySnapshot2D *p_snapshot);
+	static void generator_decode_snapshot_mesh_task(void *p_arg, uint32_t p_index);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data);
 
-	static void generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_meshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node);
+	static void generator_parse_multimeshinstance2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, NavMeshGeometrySnapshot2D *p_snapshot, Node *p_node);
 	static void generator_parse_polygon2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_staticbody2d_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_tile_map_layer_node(const Ref<NavigationPolygon> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_node);
@@ -102,6 +117,7 @@ public:
 	static void finish();
 
 	static void parse_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
+	static void parse_source_geometry_data_async(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationPolygon> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationPolygon> p_navigation_polygon);
@@ -32,6 +32,7 @@
 
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
+#include "servers/navigation/navigation_path_query_result_2d.h"
 
 #ifndef _3D_DISABLED
 #include "nav_mesh_generator_3d.h"
@@ -272,6 +273,13 @@ RID GodotNavigationServer3D::map_get_closest_point_owner(RID p_map, const Vector
 	return map->get_closest_point_owner(p_point);
 }
 
+Vector3 GodotNavigationServer3D::map_get_flow_field_next_position(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const {
+	const NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, Vector3());
+
+	return map->get_flow_field_next_position(p_origin, p_destination, p_navigation_layers);
+}
+
 TypedArray<RID> GodotNavigationServer3D::map_get_links(RID p_map) const {
 	TypedArray<RID> link_rids;
 	const NavMap *map = map_owner.get_or_null(p_map);
@@ -1111,6 +1119,18 @@ void GodotNavigationServer3D::parse_source_geometry_data(const Ref<NavigationMes
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer3D::parse_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
+#ifndef _3D_DISABLED
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
+	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
+	ERR_FAIL_NULL_MSG(p_root_node, "No parsing root node specified.");
+	ERR_FAIL_COND_MSG(!p_root_node->is_inside_tree(), "The root node needs to be inside the SceneTree.");
+
+	ERR_FAIL_NULL(NavMeshGenerator3D::get_singleton());
+	NavMeshGenerator3D::get_singleton()->parse_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, p_root_node, p_callback);
+#endif // _3D_DISABLED
+}
+
 void GodotNavigationServer3D::bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback) {
 #ifndef _3D_DISABLED
 	ERR_FAIL_COND_MSG(!p_navigation_mesh.is_valid(), "Invalid navigation mesh.");
@@ -1247,16 +1267,27 @@ void GodotNavigationServer3D::set_active(bool p_active) {
 }
 
 void GodotNavigationServer3D::flush_queries() {
-	// In c++ we can't be sure that this is performed in the main thread
-	// even with mutable functions.
-	MutexLock lock(commands_mutex);
-	MutexLock lock2(operations_mutex);
+	LocalVector<Callable> path_query_callbacks;
+	{
+		// In c++ we can't be sure that this is performed in the main thread
+		// even with mutable functions.
+		MutexLock lock(commands_mutex);
+		MutexLock lock2(operations_mutex);
+
+		// The commands can change or free the objects read by the path queries.
+		_finish_path_queries(path_query_callbacks);
+
+		for (SetCommand *command : commands) {
+			command->exec(this);
+			memdelete(command);
+		}
+		commands.clear();
+	}
 
-	for (SetCommand *command : commands) {
-		command->exec(this);
-		memdelete(command);
+	// The callbacks can call back into the server.
+	for (const Callable &callback : path_query_callbacks) {
+		callback.call();
 	}
-	commands.clear();
 }
 
 void GodotNavigationServer3D::map_force_update(RID p_map) {
@@ -1299,39 +1330,50 @@ void GodotNavigationServer3D::process(real_t p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 
-	// In c++ we can't be sure that this is performed in the main thread
-	// even with mutable functions.
-	MutexLock lock(operations_mutex);
-	for (uint32_t i(0); i < active_maps.size(); i++) {
-		active_maps[i]->sync();
-		active_maps[i]->step(p_delta_time);
-		active_maps[i]->dispatch_callbacks();
-
-		_new_pm_region_count += active_maps[i]->get_pm_region_count();
-		_new_pm_agent_count += active_maps[i]->get_pm_agent_count();
-		_new_pm_link_count += active_maps[i]->get_pm_link_count();
-		_new_pm_polygon_count += active_maps[i]->get_pm_polygon_count();
-		_new_pm_edge_count += active_maps[i]->get_pm_edge_count();
-		_new_pm_edge_merge_count += active_maps[i]->get_pm_edge_merge_count();
-		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
-		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
-
-		// Emit a signal if a map changed.
-		const uint32_t new_map_iteration_id = active_maps[i]->get_iteration_id();
-		if (new_map_iteration_id != active_maps_iteration_id[i]) {
-			emit_signal(SNAME("map_changed"), active_maps[i]->get_self());
-			active_maps_iteration_id[i] = new_map_iteration_id;
+	LocalVector<Callable> path_query_callbacks;
+	{
+		// In c++ we can't be sure that this is performed in the main thread
+		// even with mutable functions.
+		MutexLock lock(operations_mutex);
+
+		// Path queries started after the commands were flushed still read the maps that are about to sync.
+		_finish_path_queries(path_query_callbacks);
+
+		for (uint32_t i(0); i < active_maps.size(); i++) {
+			active_maps[i]->sync();
+			active_maps[i]->step(p_delta_time);
+			active_maps[i]->dispatch_callbacks();
+
+			_new_pm_region_count += active_maps[i]->get_pm_region_count();
+			_new_pm_agent_count += active_maps[i]->get_pm_agent_count();
+			_new_pm_link_count += active_maps[i]->get_pm_link_count();
+			_new_pm_polygon_count += active_maps[i]->get_pm_polygon_count();
+			_new_pm_edge_count += active_maps[i]->get_pm_edge_count();
+			_new_pm_edge_merge_count += active_maps[i]->get_pm_edge_merge_count();
+			_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
+			_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
+
+			// Emit a signal if a map changed.
+			const uint32_t new_map_iteration_id = active_maps[i]->get_iteration_id();
+			if (new_map_iteration_id != active_maps_iteration_id[i]) {
+				emit_signal(SNAME("map_changed"), active_maps[i]->get_self());
+				active_maps_iteration_id[i] = new_map_iteration_id;
+			}
 		}
+
+		pm_region_count = _new_pm_region_count;
+		pm_agent_count = _new_pm_agent_count;
+		pm_link_count = _new_pm_link_count;
+		pm_polygon_count = _new_pm_polygon_count;
+		pm_edge_count = _new_pm_edge_count;
+		pm_edge_merge_count = _new_pm_edge_merge_count;
+		pm_edge_connection_count = _new_pm_edge_connection_count;
+		pm_edge_free_count = _new_pm_edge_free_count;
 	}
 
-	pm_region_count = _new_pm_region_count;
-	pm_agent_count = _new_pm_agent_count;
-	pm_link_count = _new_pm_link_count;
-	pm_polygon_count = _new_pm_polygon_count;
-	pm_edge_count = _new_pm_edge_count;
-	pm_edge_merge_count = _new_pm_edge_merge_count;
-	pm_edge_connection_count = _new_pm_edge_connection_count;
-	pm_edge_free_count = _new_pm_edge_free_count;
+	for (const Callable &callback : path_query_callbacks) {
+		callback.call();
+	}
 }
 
 void GodotNavigationServer3D::init() {
@@ -1342,6 +1384,8 @@ void GodotNavigationServer3D::init() {
 
 void GodotNavigationServer3D::finish() {
 	flush_queries();
+	// The callbacks of the last queries can start new ones.
+	_free_path_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->finish();
@@ -1352,17 +1396,21 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_map_path(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_map_path(const NavMap *p_map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1371,7 +1419,7 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1433,6 +1481,118 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+bool GodotNavigationServer3D::is_path_query_finished(int64_t p_query_id) const {
+	MutexLock lock(path_queries_mutex);
+	return !path_queries.has(p_query_id);
+}
+
+int64_t GodotNavigationServer3D::_query_paths_async(const LocalVector<PathQueryParameters> &p_parameters, const LocalVector<Ref<RefCounted>> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V(p_parameters.size() != p_query_results.size(), -1);
+
+	// Hold the maps until the queries are running, so that they all read the same map iteration.
+	MutexLock lock(operations_mutex);
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->parameters = p_parameters;
+	batch->maps.resize(p_parameters.size());
+	for (uint32_t i = 0; i < p_parameters.size(); i++) {
+		batch->maps[i] = map_owner.get_or_null(p_parameters[i].map);
+	}
+	batch->results.resize(p_parameters.size());
+	batch->query_results = p_query_results;
+	batch->callback = p_callback;
+	if (!batch->parameters.is_empty()) {
+		batch->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_path_query_task, batch, batch->parameters.size(), -1, true, SNAME("NavigationPathQuery"));
+	}
+
+	MutexLock queries_lock(path_queries_mutex);
+	const int64_t query_id = ++path_query_id;
+	path_queries.insert(query_id, batch);
+	return query_id;
+}
+
+void GodotNavigationServer3D::_path_query_task(uint32_t p_index, PathQueryBatch *p_batch) {
+	const NavMap *map = p_batch->maps[p_index];
+	ERR_FAIL_NULL(map);
+	p_batch->results[p_index] = _query_map_path(map, p_batch->parameters[p_index]);
+}
+
+void GodotNavigationServer3D::_finish_path_queries(LocalVector<Callable> &r_callbacks) {
+	// Must be called with `operations_mutex` locked, so no batch is started while the queries are finished.
+	// The callbacks are returned, to be called once the locks are released.
+	LocalVector<int64_t> query_ids;
+	{
+		MutexLock lock(path_queries_mutex);
+		if (path_queries.is_empty()) {
+			return;
+		}
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_queries) {
+			query_ids.push_back(E.key);
+		}
+	}
+
+	for (int64_t query_id : query_ids) {
+		PathQueryBatch *batch = nullptr;
+		{
+			MutexLock lock(path_queries_mutex);
+			batch = path_queries[query_id];
+		}
+
+		if (batch->group_task != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_task);
+		}
+
+		for (uint32_t i = 0; i < batch->results.size(); i++) {
+			const PathQueryResult &result = batch->results[i];
+
+			Ref<NavigationPathQueryResult3D> query_result_3d = batch->query_results[i];
+			if (query_result_3d.is_valid()) {
+				query_result_3d->set_path(result.path);
+				query_result_3d->set_path_types(result.path_types);
+				query_result_3d->set_path_rids(result.path_rids);
+				query_result_3d->set_path_owner_ids(result.path_owner_ids);
+				continue;
+			}
+
+			Ref<NavigationPathQueryResult2D> query_result_2d = batch->query_results[i];
+			if (query_result_2d.is_valid()) {
+				Vector<Vector2> path_2d;
+				path_2d.resize(result.path.size());
+				Vector2 *w = path_2d.ptrw();
+				for (int j = 0; j < result.path.size(); j++) {
+					w[j] = Vector2(result.path[j].x, result.path[j].z);
+				}
+				query_result_2d->set_path(path_2d);
+				query_result_2d->set_path_types(result.path_types);
+				query_result_2d->set_path_rids(result.path_rids);
+				query_result_2d->set_path_owner_ids(result.path_owner_ids);
+			}
+		}
+
+		{
+			MutexLock lock(path_queries_mutex);
+			path_queries.erase(query_id);
+		}
+
+		if (batch->callback.is_valid()) {
+			r_callbacks.push_back(batch->callback);
+		}
+		memdelete(batch);
+	}
+}
+
+void GodotNavigationServer3D::_free_path_queries() {
+	MutexLock lock(operations_mutex);
+	MutexLock queries_lock(path_queries_mutex);
+	for (const KeyValue<int64_t, PathQueryBatch *> &E : path_queries) {
+		if (E.value->group_task != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.value->group_task);
+		}
+		memdelete(E.value);
+	}
+	path_queries.clear();
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
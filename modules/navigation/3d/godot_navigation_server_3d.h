@@ -37,6 +37,8 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -82,6 +84,21 @@ class GodotNavigationServer3D : public NavigationServer3D {
 	LocalVector<NavMap *> active_maps;
 	LocalVector<uint32_t> active_maps_iteration_id;
 
+	struct PathQueryBatch {
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		/// Maps of the queries, resolved when the batch is started since the RID owner is not safe to read from the tasks.
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		LocalVector<Ref<RefCounted>> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_task = -1;
+	};
+
+	/// Guards the path query batches, the maps are guarded by `operations_mutex`.
+	mutable Mutex path_queries_mutex;
+	int64_t path_query_id = 0;
+	HashMap<int64_t, PathQueryBatch *> path_queries;
+
 #ifndef _3D_DISABLED
 	NavMeshGenerator3D *navmesh_generator_3d = nullptr;
 #endif // _3D_DISABLED
@@ -136,6 +153,8 @@ public:
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const override;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const override;
 
+	virtual Vector3 map_get_flow_field_next_position(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers = 1) const override;
+
 	virtual TypedArray<RID> map_get_links(RID p_map) const override;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const override;
 	virtual TypedArray<RID> map_get_agents(RID p_map) const override;
@@ -260,6 +279,7 @@ public:
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
+	virtual void parse_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const override;
@@ -285,12 +305,19 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual bool is_path_query_finished(int64_t p_query_id) const override;
+	virtual int64_t _query_paths_async(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, const LocalVector<Ref<RefCounted>> &p_query_results, const Callable &p_callback) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	NavigationUtilities::PathQueryResult _query_map_path(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
+	void _path_query_task(uint32_t p_index, PathQueryBatch *p_batch);
+	void _finish_path_queries(LocalVector<Callable> &r_callbacks);
+	void _free_path_queries();
 };
 
 #undef COMMAND_1
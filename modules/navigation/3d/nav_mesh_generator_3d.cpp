@@ -32,6 +32,7 @@
 
 #include "nav_mesh_generator_3d.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/math/convex_hull.h"
 #include "core/os/thread.h"
@@ -72,9 +73,226 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorParseTask3D *> NavMeshGenerator3D::generator_parse_tasks;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D> NavMeshGenerator3D::tile_caches;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
+// What the SceneTree parse collects from the nodes on the main thread.
+// Turning it into source geometry does not touch any node, so it can be done on worker threads.
+struct NavMeshGeometrySnapshot3D {
+	static const uint32_t ITEMS_PER_CHUNK = 64;
+
+	struct SnapshotMesh {
+		LocalVector<RenderingServer::SurfaceData> surfaces;
+		LocalVector<Array> surface_arrays;
+	};
+
+	struct MeshInstance {
+		uint32_t mesh_index = 0;
+		Transform3D transform;
+	};
+
+	struct Shape {
+		PhysicsServer3D::ShapeType type = PhysicsServer3D::SHAPE_CUSTOM;
+		Variant data;
+		Transform3D transform;
+	};
+
+	// The parsed items in SceneTree order, so the geometry ends up in the same order as when it was added directly.
+	struct Item {
+		enum Type {
+			MESH_INSTANCE,
+			SHAPE,
+			GEOMETRY,
+		};
+
+		Type type = MESH_INSTANCE;
+		uint32_t index = 0;
+	};
+
+	Transform3D root_node_transform;
+
+	HashMap<Ref<Mesh>, uint32_t> mesh_indices;
+	LocalVector<SnapshotMesh> meshes;
+	LocalVector<MeshInstance> mesh_instances;
+	LocalVector<Shape> shapes;
+	LocalVector<Ref<NavigationMeshSourceGeometryData3D>> geometries;
+	LocalVector<Item> items;
+
+	// What obstacles and custom parsers add for the node that is currently parsed.
+	Ref<NavigationMeshSourceGeometryData3D> node_geometry;
+
+	SafeNumeric<uint32_t> next_mesh;
+	SafeNumeric<uint32_t> next_chunk;
+	LocalVector<Ref<NavigationMeshSourceGeometryData3D>> chunks;
+
+	void add_mesh_instance(uint32_t p_mesh_index, const Transform3D &p_transform) {
+		items.push_back({ Item::MESH_INSTANCE, mesh_instances.size() });
+		mesh_instances.push_back({ p_mesh_index, p_transform });
+	}
+
+	void add_shape(PhysicsServer3D::ShapeType p_type, const Variant &p_data, const Transform3D &p_transform) {
+		items.push_back({ Item::SHAPE, shapes.size() });
+		shapes.push_back({ p_type, p_data, p_transform });
+	}
+
+	const Ref<NavigationMeshSourceGeometryData3D> &begin_node_geometry() {
+		if (node_geometry.is_null()) {
+			node_geometry.instantiate();
+			node_geometry->root_node_transform = root_node_transform;
+		}
+		return node_geometry;
+	}
+
+	void end_node_geometry() {
+		if (node_geometry->get_vertices().is_empty() && node_geometry->_get_projected_obstructions().is_empty()) {
+			// Reused for the next node.
+			return;
+		}
+		items.push_back({ Item::GEOMETRY, geometries.size() });
+		geometries.push_back(node_geometry);
+		node_geometry.unref();
+	}
+};
+
+static uint32_t generator_snapshot_mesh(NavMeshGeometrySnapshot3D *p_snapshot, const Ref<Mesh> &p_mesh) {
+	const uint32_t *mesh_index = p_snapshot->mesh_indices.getptr(p_mesh);
+	if (mesh_index) {
+		return *mesh_index;
+	}
+
+#ifdef DEBUG_ENABLED
+	if (!Engine::get_singleton()->is_editor_hint()) {
+		WARN_PRINT_ONCE("Source geometry parsing for navigation mesh baking had to parse RenderingServer meshes at runtime.\n\
+		This poses a significant performance issues as visual meshes store geometry data on the GPU and transferring this data back to the CPU blocks the rendering.\n\
+		For runtime (re)baking navigation meshes use and parse collision shapes as source geometry or create geometry data procedurally in scripts.");
+	}
+#endif
+
+	NavMeshGeometrySnapshot3D::SnapshotMesh snapshot_mesh;
+
+	// Only the readback from the RenderingServer needs the main thread, the surfaces are decoded later.
+	const bool is_rendering_server_mesh = Object::cast_to<ArrayMesh>(*p_mesh) || Object::cast_to<PrimitiveMesh>(*p_mesh);
+
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		if (is_rendering_server_mesh) {
+			snapshot_mesh.surfaces.push_back(RS::get_singleton()->mesh_get_surface(p_mesh->get_rid(), i));
+		} else {
+			snapshot_mesh.surface_arrays.push_back(p_mesh->surface_get_arrays(i));
+		}
+	}
+
+	const uint32_t new_mesh_index = p_snapshot->meshes.size();
+	p_snapshot->meshes.push_back(snapshot_mesh);
+	p_snapshot->mesh_indices.insert(p_mesh, new_mesh_index);
+	return new_mesh_index;
+}
+
+static void generator_parse_shape_data(const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, PhysicsServer3D::ShapeType p_shape_type, const Variant &p_shape_data, const Transform3D &p_xform) {
+	switch (p_shape_type) {
+		case PhysicsServer3D::SHAPE_SPHERE: {
+			real_t radius = p_shape_data;
+			Array arr;
+			arr.resize(RS::ARRAY_MAX);
+			SphereMesh::create_mesh_array(arr, radius, radius * 2.0);
+			p_source_geometry_data->add_mesh_array(arr, p_xform);
+		} break;
+		case PhysicsServer3D::SHAPE_BOX: {
+			Vector3 extents = p_shape_data;
+			Array arr;
+			arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(arr, extents * 2.0);
+			p_source_geometry_data->add_mesh_array(arr, p_xform);
+		} break;
+		case PhysicsServer3D::SHAPE_CAPSULE: {
+			Dictionary dict = p_shape_data;
+			real_t radius = dict["radius"];
+			real_t height = dict["height"];
+			Array arr;
+			arr.resize(RS::ARRAY_MAX);
+			CapsuleMesh::create_mesh_array(arr, radius, height);
+			p_source_geometry_data->add_mesh_array(arr, p_xform);
+		} break;
+		case PhysicsServer3D::SHAPE_CYLINDER: {
+			Dictionary dict = p_shape_data;
+			real_t radius = dict["radius"];
+			real_t height = dict["height"];
+			Array arr;
+			arr.resize(RS::ARRAY_MAX);
+			CylinderMesh::create_mesh_array(arr, radius, radius, height);
+			p_source_geometry_data->add_mesh_array(arr, p_xform);
+		} break;
+		case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
+			PackedVector3Array vertices = p_shape_data;
+			Geometry3D::MeshData md;
+
+			Error err = ConvexHullComputer::convex_hull(vertices, md);
+
+			if (err == OK) {
+				PackedVector3Array faces;
+
+				for (const Geometry3D::MeshData::Face &face : md.faces) {
+					for (uint32_t k = 2; k < face.indices.size(); ++k) {
+						faces.push_back(md.vertices[face.indices[0]]);
+						faces.push_back(md.vertices[face.indices[k - 1]]);
+						faces.push_back(md.vertices[face.indices[k]]);
+					}
+				}
+
+				p_source_geometry_data->add_faces(faces, p_xform);
+			}
+		} break;
+		case PhysicsServer3D::SHAPE_CONCAVE_POLYGON: {
+			Dictionary dict = p_shape_data;
+			PackedVector3Array faces = Variant(dict["faces"]);
+			p_source_geometry_data->add_faces(faces, p_xform);
+		} break;
+		case PhysicsServer3D::SHAPE_HEIGHTMAP: {
+			Dictionary dict = p_shape_data;
+			///< dict( int:"width", int:"depth",float:"cell_size", float_array:"heights"
+			int heightmap_depth = dict["depth"];
+			int heightmap_width = dict["width"];
+
+			if (heightmap_depth >= 2 && heightmap_width >= 2) {
+				const Vector<real_t> &map_data = dict["heights"];
+
+				Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
+				Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
+
+				Vector<Vector3> vertex_array;
+				vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
+				Vector3 *vertex_array_ptrw = vertex_array.ptrw();
+				const real_t *map_data_ptr = map_data.ptr();
+				int vertex_index = 0;
+
+				for (int d = 0; d < heightmap_depth - 1; d++) {
+					for (int w = 0; w < heightmap_width - 1; w++) {
+						vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
+						vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
+						vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
+						vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
+						vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
+						vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
+						vertex_index += 6;
+					}
+				}
+				if (vertex_array.size() > 0) {
+					p_source_geometry_data->add_faces(vertex_array, p_xform);
+				}
+			}
+		} break;
+		default: {
+			WARN_PRINT("Unsupported collision shape type.");
+		} break;
+	}
+}
+
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
 }
@@ -96,7 +314,7 @@ NavMeshGenerator3D::~NavMeshGenerator3D() {
 }
 
 void NavMeshGenerator3D::sync() {
-	if (generator_tasks.size() == 0) {
+	if (generator_tasks.size() == 0 && generator_parse_tasks.size() == 0) {
 		return;
 	}
 
@@ -124,6 +342,28 @@ void NavMeshGenerator3D::sync() {
 	for (WorkerThreadPool::TaskID finished_task_id : finished_task_ids) {
 		generator_tasks.erase(finished_task_id);
 	}
+	finished_task_ids.clear();
+
+	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask3D *> &E : generator_parse_tasks) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(E.key)) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
+			finished_task_ids.push_back(E.key);
+
+			NavMeshGeneratorParseTask3D *parse_task = E.value;
+			memdelete(parse_task->snapshot);
+
+			// Cleared first so the callback can start the bake.
+			baking_navmeshes.erase(parse_task->navigation_mesh);
+			if (parse_task->callback.is_valid()) {
+				generator_emit_callback(parse_task->callback);
+			}
+			memdelete(parse_task);
+		}
+	}
+
+	for (WorkerThreadPool::TaskID finished_task_id : finished_task_ids) {
+		generator_parse_tasks.erase(finished_task_id);
+	}
 
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
@@ -142,6 +382,18 @@ void NavMeshGenerator3D::cleanup() {
 	}
 	generator_tasks.clear();
 
+	for (KeyValue<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask3D *> &E : generator_parse_tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E.key);
+		NavMeshGeneratorParseTask3D *parse_task = E.value;
+		memdelete(parse_task->snapshot);
+		memdelete(parse_task);
+	}
+	generator_parse_tasks.clear();
+
+	tile_cache_mutex.lock();
+	tile_caches.clear();
+	tile_cache_mutex.unlock();
+
 	generator_rid_rwlock.write_lock();
 	for (NavMeshGeometryParser3D *parser : generator_parsers) {
 		generator_parser_owner.free(parser->self);
@@ -164,13 +416,52 @@ void NavMeshGenerator3D::parse_source_geometry_data(Ref<NavigationMesh> p_naviga
 	ERR_FAIL_COND(!p_root_node->is_inside_tree());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
 
-	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_root_node);
+	NavMeshGeometrySnapshot3D *snapshot = memnew(NavMeshGeometrySnapshot3D);
+	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, snapshot, p_root_node);
+	generator_parse_snapshot(p_source_geometry_data, snapshot);
+	memdelete(snapshot);
 
 	if (p_callback.is_valid()) {
 		generator_emit_callback(p_callback);
 	}
 }
 
+void NavMeshGenerator3D::parse_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
+	ERR_FAIL_NULL(p_root_node);
+	ERR_FAIL_COND(!p_root_node->is_inside_tree());
+	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
+
+	if (is_baking(p_navigation_mesh)) {
+		ERR_FAIL_MSG("NavigationMesh is already baking. Wait for current bake to finish.");
+	}
+
+	if (!use_threads) {
+		parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, p_root_node, p_callback);
+		return;
+	}
+
+	// Counts as baking until the callback runs, so the same NavigationMesh can not be parsed or baked again in the meantime.
+	baking_navmesh_mutex.lock();
+	baking_navmeshes.insert(p_navigation_mesh);
+	baking_navmesh_mutex.unlock();
+
+	NavMeshGeometrySnapshot3D *snapshot = memnew(NavMeshGeometrySnapshot3D);
+	generator_parse_source_geometry_data(p_navigation_mesh, p_source_geometry_data, snapshot, p_root_node);
+
+	// Only the SceneTree traversal has to happen on the main thread, the geometry is built from the snapshot in the background.
+	generator_task_mutex.lock();
+	NavMeshGeneratorParseTask3D *parse_task = memnew(NavMeshGeneratorParseTask3D);
+	parse_task->navigation_mesh = p_navigation_mesh;
+	parse_task->source_geometry_data = p_source_geometry_data;
+	parse_task->snapshot = snapshot;
+	parse_task->callback = p_callback;
+	parse_task->thread_task_id = WorkerThreadPool::get_singleton()->add_native_task(&NavMeshGenerator3D::generator_thread_parse, parse_task, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorParse3D"));
+	generator_parse_tasks.insert(parse_task->thread_task_id, parse_task);
+	generator_task_mutex.unlock();
+}
+
 void NavMeshGenerator3D::bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback) {
 	ERR_FAIL_COND(!p_navigation_mesh.is_valid());
 	ERR_FAIL_COND(!p_source_geometry_data.is_valid());
@@ -252,35 +543,152 @@ void NavMeshGenerator3D::generator_thread_bake(void *p_arg) {
 	generator_task->status = NavMeshGeneratorTask3D::TaskStatus::BAKING_FINISHED;
 }
 
-void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children) {
-	generator_parse_meshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
-	generator_parse_staticbody3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+void NavMeshGenerator3D::generator_thread_parse(void *p_arg) {
+	NavMeshGeneratorParseTask3D *parse_task = static_cast<NavMeshGeneratorParseTask3D *>(p_arg);
+
+	generator_parse_snapshot(parse_task->source_geometry_data, parse_task->snapshot);
+}
+
+void NavMeshGenerator3D::generator_parse_snapshot(Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, NavMeshGeometrySnapshot3D *p_snapshot) {
+	// Every mesh is decoded once, no matter how many nodes or MultiMesh instances use it.
+	const uint32_t mesh_count = p_snapshot->meshes.size();
+	if (use_threads && mesh_count > 1) {
+		const int task_count = MIN((int)mesh_count - 1, WorkerThreadPool::get_singleton()->get_thread_count());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_decode_snapshot_mesh_task, p_snapshot, task_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorDecodeMeshes3D"));
+		generator_decode_snapshot_mesh_task(p_snapshot, 0);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		generator_decode_snapshot_mesh_task(p_snapshot, 0);
+	}
+
+	const uint32_t item_count = p_snapshot->items.size();
+	const uint32_t chunk_count = (item_count + NavMeshGeometrySnapshot3D::ITEMS_PER_CHUNK - 1) / NavMeshGeometrySnapshot3D::ITEMS_PER_CHUNK;
+	p_snapshot->chunks.resize(chunk_count);
+
+	if (use_threads && chunk_count > 1) {
+		const int task_count = MIN((int)chunk_count - 1, WorkerThreadPool::get_singleton()->get_thread_count());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_parse_snapshot_chunk_task, p_snapshot, task_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorParseChunks3D"));
+		generator_parse_snapshot_chunk_task(p_snapshot, 0);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		generator_parse_snapshot_chunk_task(p_snapshot, 0);
+	}
+
+	// Merged in order so the result does not depend on which chunk finished first.
+	for (const Ref<NavigationMeshSourceGeometryData3D> &chunk : p_snapshot->chunks) {
+		p_source_geometry_data->merge(chunk);
+	}
+	p_snapshot->chunks.clear();
+}
+
+void NavMeshGenerator3D::generator_decode_snapshot_mesh_task(void *p_arg, uint32_t p_index) {
+	NavMeshGeometrySnapshot3D *snapshot = static_cast<NavMeshGeometrySnapshot3D *>(p_arg);
+
+	for (uint32_t i = snapshot->next_mesh.postincrement(); i < snapshot->meshes.size(); i = snapshot->next_mesh.postincrement()) {
+		NavMeshGeometrySnapshot3D::SnapshotMesh &snapshot_mesh = snapshot->meshes[i];
+
+		for (const RenderingServer::SurfaceData &surface : snapshot_mesh.surfaces) {
+			snapshot_mesh.surface_arrays.push_back(RS::get_singleton()->mesh_create_arrays_from_surface_data(surface));
+		}
+		snapshot_mesh.surfaces.clear();
+
+		// Reduced to indexed vertex arrays, which is all that add_mesh_array() reads.
+		LocalVector<Array> surface_arrays;
+		for (const Array &a : snapshot_mesh.surface_arrays) {
+			ERR_CONTINUE(a.size() != Mesh::ARRAY_MAX);
+
+			Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
+			ERR_CONTINUE(mesh_vertices.is_empty());
+
+			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
+			if (mesh_indices.is_empty()) {
+				mesh_indices.resize(mesh_vertices.size());
+				int *mesh_indices_ptrw = mesh_indices.ptrw();
+				for (int j = 0; j < mesh_vertices.size(); j++) {
+					mesh_indices_ptrw[j] = j;
+				}
+			}
+			ERR_CONTINUE((mesh_indices.size() % 3) != 0);
+
+			Array surface_array;
+			surface_array.resize(Mesh::ARRAY_MAX);
+			surface_array[Mesh::ARRAY_VERTEX] = mesh_vertices;
+			surface_array[Mesh::ARRAY_INDEX] = mesh_indices;
+			surface_arrays.push_back(surface_array);
+		}
+		snapshot_mesh.surface_arrays = surface_arrays;
+	}
+}
+
+void NavMeshGenerator3D::generator_parse_snapshot_chunk_task(void *p_arg, uint32_t p_index) {
+	NavMeshGeometrySnapshot3D *snapshot = static_cast<NavMeshGeometrySnapshot3D *>(p_arg);
+
+	const uint32_t item_count = snapshot->items.size();
+
+	for (uint32_t i = snapshot->next_chunk.postincrement(); i < snapshot->chunks.size(); i = snapshot->next_chunk.postincrement()) {
+		Ref<NavigationMeshSourceGeometryData3D> chunk;
+		chunk.instantiate();
+		chunk->root_node_transform = snapshot->root_node_transform;
+
+		const uint32_t item_end = MIN((i + 1) * NavMeshGeometrySnapshot3D::ITEMS_PER_CHUNK, item_count);
+		for (uint32_t item = i * NavMeshGeometrySnapshot3D::ITEMS_PER_CHUNK; item < item_end; item++) {
+			const NavMeshGeometrySnapshot3D::Item &snapshot_item = snapshot->items[item];
+			switch (snapshot_item.type) {
+				case NavMeshGeometrySnapshot3D::Item::MESH_INSTANCE: {
+					const NavMeshGeometrySnapshot3D::MeshInstance &mesh_instance = snapshot->mesh_instances[snapshot_item.index];
+					for (const Array &surface_array : snapshot->meshes[mesh_instance.mesh_index].surface_arrays) {
+						chunk->add_mesh_array(surface_array, mesh_instance.transform);
+					}
+				} break;
+				case NavMeshGeometrySnapshot3D::Item::SHAPE: {
+					const NavMeshGeometrySnapshot3D::Shape &shape = snapshot->shapes[snapshot_item.index];
+					generator_parse_shape_data(chunk, shape.type, shape.data, shape.transform);
+				} break;
+				case NavMeshGeometrySnapshot3D::Item::GEOMETRY: {
+					chunk->merge(snapshot->geometries[snapshot_item.index]);
+				} break;
+			}
+		}
+
+		snapshot->chunks[i] = chunk;
+	}
+}
+
+void NavMeshGenerator3D::generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node, bool p_recurse_children) {
+	generator_parse_meshinstance3d_node(p_navigation_mesh, p_snapshot, p_node);
+	generator_parse_multimeshinstance3d_node(p_navigation_mesh, p_snapshot, p_node);
+	generator_parse_staticbody3d_node(p_navigation_mesh, p_snapshot, p_node);
 #ifdef MODULE_CSG_ENABLED
-	generator_parse_csgshape3d_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_csgshape3d_node(p_navigation_mesh, p_snapshot, p_node);
 #endif
 #ifdef MODULE_GRIDMAP_ENABLED
-	generator_parse_gridmap_node(p_navigation_mesh, p_source_geometry_data, p_node);
+	generator_parse_gridmap_node(p_navigation_mesh, p_snapshot, p_node);
 #endif
-	generator_parse_navigationobstacle_node(p_navigation_mesh, p_source_geometry_data, p_node);
+
+	// Added to the snapshot after the meshes and shapes of this node, like they were added before the geometry was built from a snapshot.
+	Ref<NavigationMeshSourceGeometryData3D> node_geometry = p_snapshot->begin_node_geometry();
+
+	generator_parse_navigationobstacle_node(p_navigation_mesh, node_geometry, p_node);
 
 	generator_rid_rwlock.read_lock();
 	for (const NavMeshGeometryParser3D *parser : generator_parsers) {
 		if (!parser->callback.is_valid()) {
 			continue;
 		}
-		parser->callback.call(p_navigation_mesh, p_source_geometry_data, p_node);
+		parser->callback.call(p_navigation_mesh, node_geometry, p_node);
 	}
 	generator_rid_rwlock.read_unlock();
 
+	p_snapshot->end_node_geometry();
+
 	if (p_recurse_children) {
 		for (int i = 0; i < p_node->get_child_count(); i++) {
-			generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, p_node->get_child(i), p_recurse_children);
+			generator_parse_geometry_node(p_navigation_mesh, p_snapshot, p_node->get_child(i), p_recurse_children);
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node) {
 	MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
 
 	if (mesh_instance) {
@@ -289,13 +697,13 @@ void NavMeshGenerator3D::generator_parse_meshinstance3d_node(const Ref<Navigatio
 		if (parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_MESH_INSTANCES || parsed_geometry_type == NavigationMesh::PARSED_GEOMETRY_BOTH) {
 			Ref<Mesh> mesh = mesh_instance->get_mesh();
 			if (mesh.is_valid()) {
-				p_source_geometry_data->add_mesh(mesh, mesh_instance->get_global_transform());
+				p_snapshot->add_mesh_instance(generator_snapshot_mesh(p_snapshot, mesh), mesh_instance->get_global_transform());
 			}
 		}
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node) {
 	MultiMeshInstance3D *multimesh_instance = Object::cast_to<MultiMeshInstance3D>(p_node);
 
 	if (multimesh_instance) {
@@ -306,12 +714,14 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 			if (multimesh.is_valid()) {
 				Ref<Mesh> mesh = multimesh->get_mesh();
 				if (mesh.is_valid()) {
+					const uint32_t mesh_index = generator_snapshot_mesh(p_snapshot, mesh);
+					const Transform3D multimesh_instance_xform = multimesh_instance->get_global_transform();
 					int n = multimesh->get_visible_instance_count();
 					if (n == -1) {
 						n = multimesh->get_instance_count();
 					}
 					for (int i = 0; i < n; i++) {
-						p_source_geometry_data->add_mesh(mesh, multimesh_instance->get_global_transform() * multimesh->get_instance_transform(i));
+						p_snapshot->add_mesh_instance(mesh_index, multimesh_instance_xform * multimesh->get_instance_transform(i));
 					}
 				}
 			}
@@ -319,7 +729,7 @@ void NavMeshGenerator3D::generator_parse_multimeshinstance3d_node(const Ref<Navi
 	}
 }
 
-void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node) {
 	StaticBody3D *static_body = Object::cast_to<StaticBody3D>(p_node);
 
 	if (static_body) {
@@ -342,97 +752,52 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 
 					const Transform3D transform = static_body->get_global_transform() * static_body->shape_owner_get_transform(shape_owner);
 
+					// Stored in the format of the PhysicsServer3D shape data, so they are built the same way as the GridMap collision shapes.
 					BoxShape3D *box = Object::cast_to<BoxShape3D>(*s);
 					if (box) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						BoxMesh::create_mesh_array(arr, box->get_size());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_BOX, box->get_size() * 0.5, transform);
 					}
 
 					CapsuleShape3D *capsule = Object::cast_to<CapsuleShape3D>(*s);
 					if (capsule) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CapsuleMesh::create_mesh_array(arr, capsule->get_radius(), capsule->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						Dictionary capsule_data;
+						capsule_data["radius"] = capsule->get_radius();
+						capsule_data["height"] = capsule->get_height();
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_CAPSULE, capsule_data, transform);
 					}
 
 					CylinderShape3D *cylinder = Object::cast_to<CylinderShape3D>(*s);
 					if (cylinder) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CylinderMesh::create_mesh_array(arr, cylinder->get_radius(), cylinder->get_radius(), cylinder->get_height());
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						Dictionary cylinder_data;
+						cylinder_data["radius"] = cylinder->get_radius();
+						cylinder_data["height"] = cylinder->get_height();
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_CYLINDER, cylinder_data, transform);
 					}
 
 					SphereShape3D *sphere = Object::cast_to<SphereShape3D>(*s);
 					if (sphere) {
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						SphereMesh::create_mesh_array(arr, sphere->get_radius(), sphere->get_radius() * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, transform);
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_SPHERE, sphere->get_radius(), transform);
 					}
 
 					ConcavePolygonShape3D *concave_polygon = Object::cast_to<ConcavePolygonShape3D>(*s);
 					if (concave_polygon) {
-						p_source_geometry_data->add_faces(concave_polygon->get_faces(), transform);
+						Dictionary concave_polygon_data;
+						concave_polygon_data["faces"] = concave_polygon->get_faces();
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_CONCAVE_POLYGON, concave_polygon_data, transform);
 					}
 
 					ConvexPolygonShape3D *convex_polygon = Object::cast_to<ConvexPolygonShape3D>(*s);
 					if (convex_polygon) {
-						Vector<Vector3> varr = Variant(convex_polygon->get_points());
-						Geometry3D::MeshData md;
-
-						Error err = ConvexHullComputer::convex_hull(varr, md);
-
-						if (err == OK) {
-							PackedVector3Array faces;
-
-							for (const Geometry3D::MeshData::Face &face : md.faces) {
-								for (uint32_t k = 2; k < face.indices.size(); ++k) {
-									faces.push_back(md.vertices[face.indices[0]]);
-									faces.push_back(md.vertices[face.indices[k - 1]]);
-									faces.push_back(md.vertices[face.indices[k]]);
-								}
-							}
-
-							p_source_geometry_data->add_faces(faces, transform);
-						}
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_CONVEX_POLYGON, convex_polygon->get_points(), transform);
 					}
 
 					HeightMapShape3D *heightmap_shape = Object::cast_to<HeightMapShape3D>(*s);
 					if (heightmap_shape) {
-						int heightmap_depth = heightmap_shape->get_map_depth();
-						int heightmap_width = heightmap_shape->get_map_width();
-
-						if (heightmap_depth >= 2 && heightmap_width >= 2) {
-							const Vector<real_t> &map_data = heightmap_shape->get_map_data();
-
-							Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
-							Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
-
-							Vector<Vector3> vertex_array;
-							vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
-							Vector3 *vertex_array_ptrw = vertex_array.ptrw();
-							const real_t *map_data_ptr = map_data.ptr();
-							int vertex_index = 0;
-
-							for (int d = 0; d < heightmap_depth - 1; d++) {
-								for (int w = 0; w < heightmap_width - 1; w++) {
-									vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
-									vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
-									vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_index += 6;
-								}
-							}
-							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, transform);
-							}
-						}
+						Dictionary heightmap_data;
+						heightmap_data["width"] = heightmap_shape->get_map_width();
+						heightmap_data["depth"] = heightmap_shape->get_map_depth();
+						heightmap_data["heights"] = heightmap_shape->get_map_data();
+						p_snapshot->add_shape(PhysicsServer3D::SHAPE_HEIGHTMAP, heightmap_data, transform);
 					}
 				}
 			}
@@ -441,7 +806,7 @@ void NavMeshGenerator3D::generator_parse_staticbody3d_node(const Ref<NavigationM
 }
 
 #ifdef MODULE_CSG_ENABLED
-void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node) {
 	CSGShape3D *csgshape3d = Object::cast_to<CSGShape3D>(p_node);
 
 	if (csgshape3d) {
@@ -454,7 +819,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 			if (!meshes.is_empty()) {
 				Ref<Mesh> mesh = meshes[1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, csg_shape->get_global_transform());
+					p_snapshot->add_mesh_instance(generator_snapshot_mesh(p_snapshot, mesh), csg_shape->get_global_transform());
 				}
 			}
 		}
@@ -463,7 +828,7 @@ void NavMeshGenerator3D::generator_parse_csgshape3d_node(const Ref<NavigationMes
 #endif // MODULE_CSG_ENABLED
 
 #ifdef MODULE_GRIDMAP_ENABLED
-void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node) {
+void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node) {
 	GridMap *gridmap = Object::cast_to<GridMap>(p_node);
 
 	if (gridmap) {
@@ -476,7 +841,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 			for (int i = 0; i < meshes.size(); i += 2) {
 				Ref<Mesh> mesh = meshes[i + 1];
 				if (mesh.is_valid()) {
-					p_source_geometry_data->add_mesh(mesh, xform * (Transform3D)meshes[i]);
+					p_snapshot->add_mesh_instance(generator_snapshot_mesh(p_snapshot, mesh), xform * (Transform3D)meshes[i]);
 				}
 			}
 		}
@@ -485,105 +850,7 @@ void NavMeshGenerator3D::generator_parse_gridmap_node(const Ref<NavigationMesh>
 			Array shapes = gridmap->get_collision_shapes();
 			for (int i = 0; i < shapes.size(); i += 2) {
 				RID shape = shapes[i + 1];
-				PhysicsServer3D::ShapeType type = PhysicsServer3D::get_singleton()->shape_get_type(shape);
-				Variant data = PhysicsServer3D::get_singleton()->shape_get_data(shape);
-
-				switch (type) {
-					case PhysicsServer3D::SHAPE_SPHERE: {
-						real_t radius = data;
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						SphereMesh::create_mesh_array(arr, radius, radius * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_BOX: {
-						Vector3 extents = data;
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						BoxMesh::create_mesh_array(arr, extents * 2.0);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CAPSULE: {
-						Dictionary dict = data;
-						real_t radius = dict["radius"];
-						real_t height = dict["height"];
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CapsuleMesh::create_mesh_array(arr, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CYLINDER: {
-						Dictionary dict = data;
-						real_t radius = dict["radius"];
-						real_t height = dict["height"];
-						Array arr;
-						arr.resize(RS::ARRAY_MAX);
-						CylinderMesh::create_mesh_array(arr, radius, radius, height);
-						p_source_geometry_data->add_mesh_array(arr, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
-						PackedVector3Array vertices = data;
-						Geometry3D::MeshData md;
-
-						Error err = ConvexHullComputer::convex_hull(vertices, md);
-
-						if (err == OK) {
-							PackedVector3Array faces;
-
-							for (const Geometry3D::MeshData::Face &face : md.faces) {
-								for (uint32_t k = 2; k < face.indices.size(); ++k) {
-									faces.push_back(md.vertices[face.indices[0]]);
-									faces.push_back(md.vertices[face.indices[k - 1]]);
-									faces.push_back(md.vertices[face.indices[k]]);
-								}
-							}
-
-							p_source_geometry_data->add_faces(faces, shapes[i]);
-						}
-					} break;
-					case PhysicsServer3D::SHAPE_CONCAVE_POLYGON: {
-						Dictionary dict = data;
-						PackedVector3Array faces = Variant(dict["faces"]);
-						p_source_geometry_data->add_faces(faces, shapes[i]);
-					} break;
-					case PhysicsServer3D::SHAPE_HEIGHTMAP: {
-						Dictionary dict = data;
-						///< dict( int:"width", int:"depth",float:"cell_size", float_array:"heights"
-						int heightmap_depth = dict["depth"];
-						int heightmap_width = dict["width"];
-
-						if (heightmap_depth >= 2 && heightmap_width >= 2) {
-							const Vector<real_t> &map_data = dict["heights"];
-
-							Vector2 heightmap_gridsize(heightmap_width - 1, heightmap_depth - 1);
-							Vector3 start = Vector3(heightmap_gridsize.x, 0, heightmap_gridsize.y) * -0.5;
-
-							Vector<Vector3> vertex_array;
-							vertex_array.resize((heightmap_depth - 1) * (heightmap_width - 1) * 6);
-							Vector3 *vertex_array_ptrw = vertex_array.ptrw();
-							const real_t *map_data_ptr = map_data.ptr();
-							int vertex_index = 0;
-
-							for (int d = 0; d < heightmap_depth - 1; d++) {
-								for (int w = 0; w < heightmap_width - 1; w++) {
-									vertex_array_ptrw[vertex_index] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + w], d);
-									vertex_array_ptrw[vertex_index + 1] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 2] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_array_ptrw[vertex_index + 3] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + w + 1], d);
-									vertex_array_ptrw[vertex_index + 4] = start + Vector3(w + 1, map_data_ptr[(heightmap_width * d) + heightmap_width + w + 1], d + 1);
-									vertex_array_ptrw[vertex_index + 5] = start + Vector3(w, map_data_ptr[(heightmap_width * d) + heightmap_width + w], d + 1);
-									vertex_index += 6;
-								}
-							}
-							if (vertex_array.size() > 0) {
-								p_source_geometry_data->add_faces(vertex_array, shapes[i]);
-							}
-						}
-					} break;
-					default: {
-						WARN_PRINT("Unsupported collision shape type.");
-					} break;
-				}
+				p_snapshot->add_shape(PhysicsServer3D::get_singleton()->shape_get_type(shape), PhysicsServer3D::get_singleton()->shape_get_data(shape), shapes[i]);
 			}
 		}
 	}
@@ -643,7 +910,7 @@ void NavMeshGenerator3D::generator_parse_navigationobstacle_node(const Ref<Navig
 	p_source_geometry_data->add_projected_obstruction(obstruction_shape_vertices, obstacle->get_global_position().y + p_source_geometry_data->root_node_transform.origin.y, obstacle->get_height(), obstacle->get_carve_navigation_mesh());
 }
 
-void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node) {
+void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_root_node) {
 	List<Node *> parse_nodes;
 
 	if (p_navigation_mesh->get_source_geometry_mode() == NavigationMesh::SOURCE_GEOMETRY_ROOT_NODE_CHILDREN) {
@@ -659,11 +926,12 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	p_source_geometry_data->clear();
 	p_source_geometry_data->root_node_transform = root_node_transform;
+	p_snapshot->root_node_transform = root_node_transform;
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
 	for (Node *parse_node : parse_nodes) {
-		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
+		generator_parse_geometry_node(p_navigation_mesh, p_snapshot, parse_node, recurse_children);
 	}
 };
 
@@ -679,13 +947,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -768,6 +1029,19 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		if (Math::fmod(p_navigation_mesh->get_tile_size(), p_navigation_mesh->get_cell_size()) != 0.0) {
+			WARN_PRINT("Property tile_size is ceiled to cell_size voxel units and loses precision.");
+		}
+		generator_bake_tiled(p_navigation_mesh, p_source_geometry_data, cfg);
+		return;
+	}
+
+	// Drop the tiles of a previous tiled bake, they would otherwise be kept in memory for as long as the navigation mesh exists.
+	tile_cache_mutex.lock();
+	tile_caches.erase(p_navigation_mesh->get_instance_id());
+	tile_cache_mutex.unlock();
+
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
 	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
 		ERR_FAIL_MSG("Baking interrupted."
@@ -779,45 +1053,100 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_recast(p_navigation_mesh, p_source_geometry_data, cfg, tris, ntris, AABB(), nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_recast(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const rcConfig &p_config, const int *p_tris, int p_ntris, const AABB &p_walkable_bounds, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const float *verts = vertices.ptr();
+	const int nverts = vertices.size() / 3;
+
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
 	bake_state = "Creating heightfield..."; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_config.width, p_config.height, p_config.bmin, p_config.bmax, p_config.cs, p_config.ch), false);
 
 	bake_state = "Marking walkable triangles..."; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_config.walkableSlopeAngle, verts, nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, verts, nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_config.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_config.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_config.walkableHeight, p_config.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_config.walkableHeight, *hf);
 	}
 
 	bake_state = "Constructing compact heightfield..."; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_config.walkableHeight, p_config.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
+	// Marks everything of the compact heightfield on the XZ plane outside of the given bounds as not walkable.
+	auto mark_outside_bounds = [&](const Vector3 &p_min, const Vector3 &p_max) {
+		const float half_cell = chf->cs * 0.5f;
+		float box_min[3] = { chf->bmin[0], chf->bmin[1], chf->bmin[2] };
+		float box_max[3] = { chf->bmax[0], chf->bmax[1], chf->bmax[2] };
+		for (int axis = 0; axis < 3; axis += 2) {
+			if (p_min[axis] - half_cell > chf->bmin[axis]) {
+				box_max[axis] = p_min[axis] - half_cell;
+				rcMarkBoxArea(&ctx, box_min, box_max, RC_NULL_AREA, *chf);
+				box_max[axis] = chf->bmax[axis];
+			}
+			if (p_max[axis] + half_cell < chf->bmax[axis]) {
+				box_min[axis] = p_max[axis] + half_cell;
+				rcMarkBoxArea(&ctx, box_min, box_max, RC_NULL_AREA, *chf);
+				box_min[axis] = chf->bmin[axis];
+			}
+		}
+	};
+
+	// Only tiles pass walkable bounds. Their height can be zero for flat source geometry, so only the XZ extent is checked.
+	const bool use_walkable_bounds = p_walkable_bounds.size.x > 0.0 && p_walkable_bounds.size.z > 0.0;
+
+	// A tile heightfield reaches past the bake bounds at the edges of the baked area. Those parts need to stay as non-navigable as they are for a single heightfield.
+	if (use_walkable_bounds) {
+		mark_outside_bounds(p_walkable_bounds.position, p_walkable_bounds.get_end());
+	}
+
 	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &projected_obstructions = p_source_geometry_data->_get_projected_obstructions();
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
@@ -839,7 +1168,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Eroding walkable area..."; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_config.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
 	if (!projected_obstructions.is_empty()) {
@@ -858,33 +1187,39 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		}
 	}
 
+	// The tile borders replace the border_size of a single heightfield, so it is carved from the bake bounds instead.
+	if (use_walkable_bounds && p_navigation_mesh->get_border_size() > 0.0) {
+		const real_t border_size = Math::ceil(p_navigation_mesh->get_border_size() / p_config.cs) * p_config.cs;
+		mark_outside_bounds(p_walkable_bounds.position + Vector3(border_size, 0.0, border_size), p_walkable_bounds.get_end() - Vector3(border_size, 0.0, border_size));
+	}
+
 	bake_state = "Partitioning..."; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_config.borderSize, p_config.minRegionArea, p_config.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_config.borderSize, p_config.minRegionArea, p_config.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_config.borderSize, p_config.minRegionArea), false);
 	}
 
 	bake_state = "Creating contours..."; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_config.maxSimplificationError, p_config.maxEdgeLen, *cset), false);
 
 	bake_state = "Creating polymesh..."; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_config.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_config.detailSampleDist, p_config.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
@@ -893,7 +1228,8 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 
 	bake_state = "Converting to native navigation mesh..."; // step #10
 
-	Vector<Vector3> nav_vertices;
+	r_vertices.clear();
+	r_polygons.clear();
 
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
@@ -907,13 +1243,11 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
 	}
-	p_navigation_mesh->set_vertices(nav_vertices);
-	p_navigation_mesh->clear_polygons();
 
 	for (int i = 0; i < detail_mesh->nmeshes; i++) {
 		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
@@ -933,7 +1267,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			p_navigation_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
@@ -945,6 +1279,446 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	detail_mesh = nullptr;
 
 	bake_state = "Baking finished."; // step #12
+
+	return true;
+}
+
+struct NavMeshGenerator3D::NavMeshTiledBake3D {
+	Ref<NavigationMesh> navigation_mesh;
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+	rcConfig config;
+	AABB bake_bounds;
+	bool use_baking_aabb = false;
+
+	const HashMap<Vector2i, LocalVector<int>> *tile_triangles = nullptr;
+	LocalVector<Vector2i> dirty_tiles;
+	LocalVector<NavMeshTile3D *> dirty_tile_outputs;
+	SafeNumeric<uint32_t> next_dirty_tile;
+};
+
+void NavMeshGenerator3D::generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const rcConfig &p_config) {
+	const Vector<float> &vertices = p_source_geometry_data->get_vertices();
+	const Vector<int> &indices = p_source_geometry_data->get_indices();
+	const float *verts = vertices.ptr();
+	const int *tris = indices.ptr();
+	const int ntris = indices.size() / 3;
+
+	NavMeshTiledBake3D tiled_bake;
+	tiled_bake.navigation_mesh = p_navigation_mesh;
+	tiled_bake.source_geometry_data = p_source_geometry_data;
+	tiled_bake.use_baking_aabb = p_navigation_mesh->get_filter_baking_aabb().has_volume();
+	tiled_bake.bake_bounds = AABB(Vector3(p_config.bmin[0], p_config.bmin[1], p_config.bmin[2]), Vector3(p_config.bmax[0] - p_config.bmin[0], p_config.bmax[1] - p_config.bmin[1], p_config.bmax[2] - p_config.bmin[2]));
+
+	// Same border as the tiled Recast samples use, wide enough for erosion and for region partitioning to agree across tile edges.
+	rcConfig &tile_config = tiled_bake.config;
+	tile_config = p_config;
+	tile_config.tileSize = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / p_config.cs));
+	tile_config.borderSize = p_config.walkableRadius + 3;
+	tile_config.width = tile_config.tileSize + tile_config.borderSize * 2;
+	tile_config.height = tile_config.tileSize + tile_config.borderSize * 2;
+
+	const real_t tile_world_size = tile_config.tileSize * tile_config.cs;
+	const real_t border_world_size = tile_config.borderSize * tile_config.cs;
+
+	// The tile grid is anchored at the world origin instead of the source geometry bounds so tiles keep their coordinates when the baked area grows or shrinks.
+	const Vector2i tile_min = Vector2i((int)Math::floor(p_config.bmin[0] / tile_world_size), (int)Math::floor(p_config.bmin[2] / tile_world_size));
+	const Vector2i tile_max = Vector2i(MAX(tile_min.x, (int)Math::ceil(p_config.bmax[0] / tile_world_size) - 1), MAX(tile_min.y, (int)Math::ceil(p_config.bmax[2] / tile_world_size) - 1));
+
+	uint32_t settings_hash = hash_murmur3_one_32(tile_config.tileSize);
+	settings_hash = hash_murmur3_one_float(tile_config.cs, settings_hash);
+	settings_hash = hash_murmur3_one_float(tile_config.ch, settings_hash);
+	settings_hash = hash_murmur3_one_float(tile_config.walkableSlopeAngle, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.walkableHeight, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.walkableClimb, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.walkableRadius, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.maxEdgeLen, settings_hash);
+	settings_hash = hash_murmur3_one_float(tile_config.maxSimplificationError, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.minRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.mergeRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(tile_config.maxVertsPerPoly, settings_hash);
+	settings_hash = hash_murmur3_one_float(tile_config.detailSampleDist, settings_hash);
+	settings_hash = hash_murmur3_one_float(tile_config.detailSampleMaxError, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_navigation_mesh->get_border_size(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(tiled_bake.use_baking_aabb, settings_hash);
+	if (tiled_bake.use_baking_aabb) {
+		settings_hash = hash_murmur3_one_float(tiled_bake.bake_bounds.position.y, settings_hash);
+		settings_hash = hash_murmur3_one_float(tiled_bake.bake_bounds.size.y, settings_hash);
+	}
+
+	// Sort the triangles into every tile that they overlap, including the tile borders.
+	HashMap<Vector2i, LocalVector<int>> tile_triangles;
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+		const float min_x = MIN(v0[0], MIN(v1[0], v2[0]));
+		const float max_x = MAX(v0[0], MAX(v1[0], v2[0]));
+		const float min_z = MIN(v0[2], MIN(v1[2], v2[2]));
+		const float max_z = MAX(v0[2], MAX(v1[2], v2[2]));
+
+		const int from_x = MAX(tile_min.x, (int)Math::floor((min_x - border_world_size) / tile_world_size));
+		const int to_x = MIN(tile_max.x, (int)Math::floor((max_x + border_world_size) / tile_world_size));
+		const int from_z = MAX(tile_min.y, (int)Math::floor((min_z - border_world_size) / tile_world_size));
+		const int to_z = MIN(tile_max.y, (int)Math::floor((max_z + border_world_size) / tile_world_size));
+
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				tile_triangles[Vector2i(x, z)].push_back(i);
+			}
+		}
+	}
+	tiled_bake.tile_triangles = &tile_triangles;
+
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &projected_obstructions = p_source_geometry_data->_get_projected_obstructions();
+	LocalVector<Rect2> projected_obstruction_rects;
+	projected_obstruction_rects.resize(projected_obstructions.size());
+	for (int i = 0; i < projected_obstructions.size(); i++) {
+		const Vector<float> &obstruction_vertices = projected_obstructions[i].vertices;
+		Rect2 rect;
+		for (int j = 0; j + 2 < obstruction_vertices.size(); j += 3) {
+			const Vector2 point = Vector2(obstruction_vertices[j], obstruction_vertices[j + 2]);
+			if (j == 0) {
+				rect.position = point;
+			} else {
+				rect.expand_to(point);
+			}
+		}
+		projected_obstruction_rects[i] = rect;
+	}
+
+	const ObjectID navigation_mesh_id = p_navigation_mesh->get_instance_id();
+	NavMeshTileCache3D tile_cache;
+	tile_cache_mutex.lock();
+	{
+		// Forget the tiles of navigation meshes that were freed since their last bake.
+		LocalVector<ObjectID> freed_navigation_meshes;
+		for (const KeyValue<ObjectID, NavMeshTileCache3D> &E : tile_caches) {
+			if (ObjectDB::get_instance(E.key) == nullptr) {
+				freed_navigation_meshes.push_back(E.key);
+			}
+		}
+		for (const ObjectID &freed_navigation_mesh : freed_navigation_meshes) {
+			tile_caches.erase(freed_navigation_mesh);
+		}
+
+		const NavMeshTileCache3D *cached_tiles = tile_caches.getptr(navigation_mesh_id);
+		if (cached_tiles && cached_tiles->settings_hash == settings_hash) {
+			tile_cache = *cached_tiles;
+		}
+	}
+	tile_cache_mutex.unlock();
+
+	NavMeshTileCache3D baked_tiles;
+	baked_tiles.settings_hash = settings_hash;
+
+	for (const KeyValue<Vector2i, LocalVector<int>> &E : tile_triangles) {
+		const Rect2 tile_rect = Rect2(E.key.x * tile_world_size - border_world_size, E.key.y * tile_world_size - border_world_size, tile_world_size + border_world_size * 2.0, tile_world_size + border_world_size * 2.0);
+
+		uint32_t tile_hash = hash_murmur3_one_32(E.value.size(), settings_hash);
+		for (int triangle : E.value) {
+			for (int i = 0; i < 3; i++) {
+				const float *v = &verts[tris[triangle * 3 + i] * 3];
+				tile_hash = hash_murmur3_one_float(v[0], tile_hash);
+				tile_hash = hash_murmur3_one_float(v[1], tile_hash);
+				tile_hash = hash_murmur3_one_float(v[2], tile_hash);
+			}
+		}
+		for (int i = 0; i < projected_obstructions.size(); i++) {
+			if (!projected_obstruction_rects[i].intersects(tile_rect, true)) {
+				continue;
+			}
+			const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction = projected_obstructions[i];
+			for (float value : projected_obstruction.vertices) {
+				tile_hash = hash_murmur3_one_float(value, tile_hash);
+			}
+			tile_hash = hash_murmur3_one_float(projected_obstruction.elevation, tile_hash);
+			tile_hash = hash_murmur3_one_float(projected_obstruction.height, tile_hash);
+			tile_hash = hash_murmur3_one_32(projected_obstruction.carve, tile_hash);
+		}
+		// Tiles at the edge of the baked area are clipped by the bake bounds.
+		const Rect2 bake_rect = Rect2(tiled_bake.bake_bounds.position.x, tiled_bake.bake_bounds.position.z, tiled_bake.bake_bounds.size.x, tiled_bake.bake_bounds.size.z);
+		const Rect2 clipped_rect = tile_rect.intersection(bake_rect);
+		tile_hash = hash_murmur3_one_real(clipped_rect.position.x, tile_hash);
+		tile_hash = hash_murmur3_one_real(clipped_rect.position.y, tile_hash);
+		tile_hash = hash_murmur3_one_real(clipped_rect.size.x, tile_hash);
+		tile_hash = hash_murmur3_one_real(clipped_rect.size.y, tile_hash);
+		tile_hash = hash_fmix32(tile_hash);
+
+		const NavMeshTile3D *cached_tile = tile_cache.tiles.getptr(E.key);
+		if (cached_tile && cached_tile->hash == tile_hash) {
+			baked_tiles.tiles.insert(E.key, *cached_tile);
+			continue;
+		}
+
+		NavMeshTile3D &tile = baked_tiles.tiles[E.key];
+		tile.hash = tile_hash;
+		tiled_bake.dirty_tiles.push_back(E.key);
+	}
+
+	for (const Vector2i &dirty_tile : tiled_bake.dirty_tiles) {
+		tiled_bake.dirty_tile_outputs.push_back(baked_tiles.tiles.getptr(dirty_tile));
+	}
+
+	const uint32_t dirty_tile_count = tiled_bake.dirty_tiles.size();
+	if (use_threads && dirty_tile_count > 1) {
+		const int task_count = MIN((int)dirty_tile_count - 1, WorkerThreadPool::get_singleton()->get_thread_count());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_bake_tile_task, &tiled_bake, task_count, -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		// Takes part in the bake instead of blocking, which keeps baking from a worker thread safe when no other thread is free.
+		generator_bake_tile_task(&tiled_bake, 0);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		generator_bake_tile_task(&tiled_bake, 0);
+	}
+
+	generator_stitch_tiles(p_navigation_mesh, tile_config, baked_tiles.tiles);
+
+	tile_cache_mutex.lock();
+	tile_caches[navigation_mesh_id] = baked_tiles;
+	tile_cache_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_bake_tile_task(void *p_arg, uint32_t p_index) {
+	NavMeshTiledBake3D *tiled_bake = static_cast<NavMeshTiledBake3D *>(p_arg);
+
+	const Vector<float> &vertices = tiled_bake->source_geometry_data->get_vertices();
+	const Vector<int> &indices = tiled_bake->source_geometry_data->get_indices();
+
+	// Every task keeps claiming tiles until none are left, so the amount of tasks does not need to match the amount of tiles.
+	for (uint32_t i = tiled_bake->next_dirty_tile.postincrement(); i < tiled_bake->dirty_tiles.size(); i = tiled_bake->next_dirty_tile.postincrement()) {
+		const Vector2i &tile_coords = tiled_bake->dirty_tiles[i];
+		const LocalVector<int> &triangles = (*tiled_bake->tile_triangles)[tile_coords];
+		NavMeshTile3D *tile = tiled_bake->dirty_tile_outputs[i];
+
+		rcConfig config = tiled_bake->config;
+		config.bmin[0] = (tile_coords.x * config.tileSize - config.borderSize) * config.cs;
+		config.bmin[2] = (tile_coords.y * config.tileSize - config.borderSize) * config.cs;
+		config.bmax[0] = ((tile_coords.x + 1) * config.tileSize + config.borderSize) * config.cs;
+		config.bmax[2] = ((tile_coords.y + 1) * config.tileSize + config.borderSize) * config.cs;
+
+		LocalVector<int> tile_tris;
+		tile_tris.resize(triangles.size() * 3);
+		float min_y = FLT_MAX;
+		float max_y = -FLT_MAX;
+		for (uint32_t j = 0; j < triangles.size(); j++) {
+			for (int k = 0; k < 3; k++) {
+				const int index = indices[triangles[j] * 3 + k];
+				tile_tris[j * 3 + k] = index;
+				min_y = MIN(min_y, vertices[index * 3 + 1]);
+				max_y = MAX(max_y, vertices[index * 3 + 1]);
+			}
+		}
+		if (tiled_bake->use_baking_aabb) {
+			min_y = MAX(min_y, tiled_bake->config.bmin[1]);
+			max_y = MIN(max_y, tiled_bake->config.bmax[1]);
+		}
+		if (min_y > max_y) {
+			continue;
+		}
+		// Snapped to the cell height so that the voxel layers of all tiles line up.
+		config.bmin[1] = Math::floor(min_y / config.ch) * config.ch;
+		config.bmax[1] = max_y;
+
+		if (!generator_bake_recast(tiled_bake->navigation_mesh, tiled_bake->source_geometry_data, config, tile_tris.ptr(), triangles.size(), tiled_bake->bake_bounds, tile->vertices, tile->polygons)) {
+			tile->vertices.clear();
+			tile->polygons.clear();
+		}
+	}
+}
+
+void NavMeshGenerator3D::generator_stitch_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_tile_config, const HashMap<Vector2i, NavMeshTile3D> &p_tiles) {
+	const real_t cell_size = p_tile_config.cs;
+	const real_t snap_epsilon = cell_size * 0.01;
+	// Both sides of a seam sample their heights separately, so shared vertices can differ a little on the Y axis.
+	const real_t height_tolerance = (p_tile_config.walkableClimb + 1) * p_tile_config.ch;
+
+	LocalVector<Vector2i> tile_coords;
+	for (const KeyValue<Vector2i, NavMeshTile3D> &E : p_tiles) {
+		tile_coords.push_back(E.key);
+	}
+	tile_coords.sort();
+
+	LocalVector<Vector3> stitch_vertices;
+	LocalVector<LocalVector<int>> stitch_polygons;
+	for (const Vector2i &coords : tile_coords) {
+		const NavMeshTile3D &tile = p_tiles[coords];
+		const int vertex_offset = stitch_vertices.size();
+		for (Vector3 vertex : tile.vertices) {
+			// Snap to the cell grid so that vertices on tile seams land exactly on them.
+			for (int axis = 0; axis < 3; axis += 2) {
+				const real_t grid = Math::round(vertex[axis] / cell_size) * cell_size;
+				if (Math::abs(vertex[axis] - grid) <= snap_epsilon) {
+					vertex[axis] = grid;
+				}
+			}
+			stitch_vertices.push_back(vertex);
+		}
+		for (const Vector<int> &polygon : tile.polygons) {
+			LocalVector<int> stitch_polygon;
+			for (int index : polygon) {
+				stitch_polygon.push_back(index + vertex_offset);
+			}
+			stitch_polygons.push_back(stitch_polygon);
+		}
+	}
+
+	// Returns the seam a vertex lies on for the given axis, or false if it is inside of a tile.
+	auto get_seam = [&](const Vector3 &p_vertex, int p_axis, Vector2i &r_seam) -> bool {
+		const real_t grid = Math::round(p_vertex[p_axis] / cell_size);
+		if (Math::abs(p_vertex[p_axis] - grid * cell_size) > snap_epsilon) {
+			return false;
+		}
+		const int64_t cell = (int64_t)grid;
+		if (cell % p_tile_config.tileSize != 0) {
+			return false;
+		}
+		r_seam = Vector2i(p_axis, (int)(cell / p_tile_config.tileSize));
+		return true;
+	};
+
+	struct SeamVertex {
+		real_t offset = 0.0;
+		int index = -1;
+
+		bool operator<(const SeamVertex &p_other) const { return offset < p_other.offset; }
+	};
+
+	HashMap<Vector2i, LocalVector<SeamVertex>> seams;
+	for (uint32_t i = 0; i < stitch_vertices.size(); i++) {
+		const Vector3 &vertex = stitch_vertices[i];
+		Vector2i seam;
+		if (get_seam(vertex, 0, seam)) {
+			seams[seam].push_back({ vertex.z, (int)i });
+		}
+		if (get_seam(vertex, 2, seam)) {
+			seams[seam].push_back({ vertex.x, (int)i });
+		}
+	}
+
+	// Merge the vertices that both sides of a seam created at the same position.
+	LocalVector<int> vertex_remap;
+	vertex_remap.resize(stitch_vertices.size());
+	for (uint32_t i = 0; i < vertex_remap.size(); i++) {
+		vertex_remap[i] = i;
+	}
+	auto resolve = [&](int p_index) -> int {
+		while (vertex_remap[p_index] != p_index) {
+			p_index = vertex_remap[p_index];
+		}
+		return p_index;
+	};
+
+	for (KeyValue<Vector2i, LocalVector<SeamVertex>> &E : seams) {
+		LocalVector<SeamVertex> &seam_vertices = E.value;
+		seam_vertices.sort();
+		for (uint32_t i = 1; i < seam_vertices.size(); i++) {
+			const int index = resolve(seam_vertices[i].index);
+			for (int j = (int)i - 1; j >= 0 && seam_vertices[i].offset - seam_vertices[j].offset <= snap_epsilon; j--) {
+				const int other_index = resolve(seam_vertices[j].index);
+				if (other_index != index && Math::abs(stitch_vertices[index].y - stitch_vertices[other_index].y) <= height_tolerance) {
+					vertex_remap[index] = other_index;
+					break;
+				}
+			}
+		}
+	}
+
+	for (KeyValue<Vector2i, LocalVector<SeamVertex>> &E : seams) {
+		LocalVector<SeamVertex> merged_seam_vertices;
+		for (const SeamVertex &seam_vertex : E.value) {
+			const int index = resolve(seam_vertex.index);
+			bool merged = false;
+			for (int j = (int)merged_seam_vertices.size() - 1; j >= 0 && seam_vertex.offset - merged_seam_vertices[j].offset <= snap_epsilon; j--) {
+				if (merged_seam_vertices[j].index == index) {
+					merged = true;
+					break;
+				}
+			}
+			if (!merged) {
+				merged_seam_vertices.push_back({ seam_vertex.offset, index });
+			}
+		}
+		E.value = merged_seam_vertices;
+	}
+
+	// Tiles split their shared seams at different points. Edges on a seam get the vertices of the other side inserted so that the edges of both sides match.
+	HashMap<int, int> vertex_to_nav_index;
+	Vector<Vector3> nav_vertices;
+	p_navigation_mesh->clear_polygons();
+
+	for (const LocalVector<int> &stitch_polygon : stitch_polygons) {
+		LocalVector<int> polygon;
+		for (uint32_t i = 0; i < stitch_polygon.size(); i++) {
+			const int from = resolve(stitch_polygon[i]);
+			const int to = resolve(stitch_polygon[(i + 1) % stitch_polygon.size()]);
+			if (polygon.is_empty() || polygon[polygon.size() - 1] != from) {
+				polygon.push_back(from);
+			}
+
+			const Vector3 &from_vertex = stitch_vertices[from];
+			const Vector3 &to_vertex = stitch_vertices[to];
+			for (int axis = 0; axis < 3; axis += 2) {
+				Vector2i from_seam;
+				Vector2i to_seam;
+				if (!get_seam(from_vertex, axis, from_seam) || !get_seam(to_vertex, axis, to_seam) || from_seam != to_seam) {
+					continue;
+				}
+
+				const int offset_axis = axis == 0 ? 2 : 0;
+				const real_t from_offset = from_vertex[offset_axis];
+				const real_t to_offset = to_vertex[offset_axis];
+				const real_t min_offset = MIN(from_offset, to_offset) + snap_epsilon;
+				const real_t max_offset = MAX(from_offset, to_offset) - snap_epsilon;
+				const LocalVector<SeamVertex> &seam_vertices = seams[from_seam];
+
+				LocalVector<int> inserted_vertices;
+				for (const SeamVertex &seam_vertex : seam_vertices) {
+					if (seam_vertex.offset <= min_offset) {
+						continue;
+					}
+					if (seam_vertex.offset >= max_offset) {
+						break;
+					}
+					const real_t weight = (seam_vertex.offset - from_offset) / (to_offset - from_offset);
+					const real_t edge_height = Math::lerp(from_vertex.y, to_vertex.y, weight);
+					if (Math::abs(stitch_vertices[seam_vertex.index].y - edge_height) <= height_tolerance) {
+						inserted_vertices.push_back(seam_vertex.index);
+					}
+				}
+				if (from_offset > to_offset) {
+					inserted_vertices.invert();
+				}
+				for (int inserted_vertex : inserted_vertices) {
+					polygon.push_back(inserted_vertex);
+				}
+			}
+		}
+		if (polygon.size() > 1 && polygon[polygon.size() - 1] == polygon[0]) {
+			polygon.remove_at(polygon.size() - 1);
+		}
+		if (polygon.size() < 3) {
+			continue;
+		}
+
+		Vector<int> nav_indices;
+		nav_indices.resize(polygon.size());
+		for (uint32_t i = 0; i < polygon.size(); i++) {
+			const int *nav_index = vertex_to_nav_index.getptr(polygon[i]);
+			if (nav_index) {
+				nav_indices.write[i] = *nav_index;
+			} else {
+				nav_indices.write[i] = nav_vertices.size();
+				vertex_to_nav_index.insert(polygon[i], nav_vertices.size());
+				nav_vertices.push_back(stitch_vertices[polygon[i]]);
+			}
+		}
+		p_navigation_mesh->add_polygon(nav_indices);
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -41,6 +41,8 @@
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct NavMeshGeometrySnapshot3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -80,20 +82,56 @@ class NavMeshGenerator3D : public Object {
 
 	static void generator_thread_bake(void *p_arg);
 
+	struct NavMeshGeneratorParseTask3D {
+		Ref<NavigationMesh> navigation_mesh;
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
+		NavMeshGeometrySnapshot3D *snapshot = nullptr;
+		Callable callback;
+		WorkerThreadPool::TaskID thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	static HashMap<WorkerThreadPool::TaskID, NavMeshGeneratorParseTask3D *> generator_parse_tasks;
+
+	static void generator_thread_parse(void *p_arg);
+
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
-	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
-	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
-	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	struct NavMeshTile3D {
+		uint32_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshTileCache3D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+	};
 
-	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
-	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	// Tiles of the last tiled bake of each NavigationMesh, used to skip tiles whose source geometry did not change.
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D> tile_caches;
+
+	struct NavMeshTiledBake3D;
+
+	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node, bool p_recurse_children);
+	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_root_node);
+	static void generator_parse_snapshot(Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, NavMeshGeometrySnapshot3D *p_snapshot);
+	static void generator_decode_snapshot_mesh_task(void *p_arg, uint32_t p_index);
+	static void generator_parse_snapshot_chunk_task(void *p_arg, uint32_t p_index);
+	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static bool generator_bake_recast(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const rcConfig &p_config, const int *p_tris, int p_ntris, const AABB &p_walkable_bounds, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+	static void generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const rcConfig &p_config);
+	static void generator_bake_tile_task(void *p_arg, uint32_t p_index);
+	static void generator_stitch_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_tile_config, const HashMap<Vector2i, NavMeshTile3D> &p_tiles);
+
+	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node);
+	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node);
+	static void generator_parse_staticbody3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node);
 #ifdef MODULE_CSG_ENABLED
-	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_csgshape3d_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node);
 #endif // MODULE_CSG_ENABLED
 #ifdef MODULE_GRIDMAP_ENABLED
-	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
+	static void generator_parse_gridmap_node(const Ref<NavigationMesh> &p_navigation_mesh, NavMeshGeometrySnapshot3D *p_snapshot, Node *p_node);
 #endif // MODULE_GRIDMAP_ENABLED
 	static void generator_parse_navigationobstacle_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 
@@ -107,6 +145,7 @@ public:
 	static void finish();
 
 	static void parse_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
+	static void parse_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
@@ -37,6 +37,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/sort_array.h"
 
 #include <Obstacle2d.h>
 
@@ -103,7 +105,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 		return;
 	}
 	use_edge_connections = p_enabled;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -111,7 +113,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 		return;
 	}
 	edge_connection_margin = p_edge_connection_margin;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -158,35 +160,20 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	const gd::Polygon *end_poly = nullptr;
 	Vector3 begin_point;
 	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+	// Find the initial poly and the end poly on this map, only considering polygons in regions with compatible layers.
+	NavPolygonBVH::QueryResult begin_result;
+	_get_closest_point(p_origin, p_navigation_layers, begin_result);
+	if (begin_result.polygon) {
+		begin_poly = begin_result.polygon;
+		begin_point = begin_result.point;
+	}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
+	NavPolygonBVH::QueryResult end_result;
+	_get_closest_point(p_destination, p_navigation_layers, end_result);
+	if (end_result.polygon) {
+		end_poly = end_result.polygon;
+		end_point = end_result.point;
 	}
 
 	// Check for trivial cases
@@ -219,9 +206,15 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// Restrict the search to the clusters along the path found on the cluster graph.
+	LocalVector<uint8_t> corridor;
+	if (!clusters.is_empty()) {
+		_get_cluster_corridor(begin_poly->cluster, end_poly->cluster, p_navigation_layers, corridor);
+	}
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	navigation_polys.reserve(corridor.is_empty() ? pm_polygon_count * 0.75 : hierarchical_cluster_size * 4);
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -256,6 +249,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (!corridor.is_empty() && !corridor[connection.polygon->cluster]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -305,6 +302,23 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
 		if (to_visit.size() == 0) {
+			if (!corridor.is_empty()) {
+				// The end polygon is not reachable within the corridor, search the whole map instead.
+				corridor.clear();
+
+				gd::NavigationPoly np = navigation_polys[0];
+				navigation_polys.clear();
+				navigation_polys.push_back(np);
+				to_visit.push_back(0);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -607,50 +621,14 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 		return Vector3();
 	}
 
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_d = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
-				}
-			}
-		}
-
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
-				}
-			}
-		}
+	// Any intersection with the polygon faces wins over the closest point on the polygon edges.
+	NavPolygonBVH::QueryResult result;
+	region_bvh.intersect_segment(p_from, p_to, result);
+	if (!result.polygon && !p_use_collision) {
+		region_bvh.get_closest_edge_point_to_segment(p_from, p_to, result);
 	}
 
-	return closest_point;
+	return result.point;
 }
 
 Vector3 NavMap::get_closest_point(const Vector3 &p_point) const {
@@ -687,36 +665,38 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
-
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
-			}
-		}
+
+	NavPolygonBVH::QueryResult closest;
+	_get_closest_point(p_point, closest);
+	if (closest.polygon) {
+		result.point = closest.point;
+		result.normal = closest.normal;
+		result.owner = closest.polygon->owner->get_self();
 	}
 
 	return result;
 }
 
+void NavMap::_get_closest_point(const Vector3 &p_point, NavPolygonBVH::QueryResult &r_result) const {
+	region_bvh.get_closest_point(p_point, r_result);
+}
+
+void NavMap::_get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, NavPolygonBVH::QueryResult &r_result) const {
+	region_bvh.get_closest_point(p_point, p_navigation_layers, r_result);
+}
+
 void NavMap::add_region(NavRegion *p_region) {
 	regions.push_back(p_region);
-	regenerate_links = true;
+	region_bvh_dirty = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+		removed_regions.push_back(p_region);
+		// The order of the regions changed.
+		region_bvh_dirty = true;
 	}
 }
 
@@ -785,16 +765,19 @@ void NavMap::set_agent_as_controlled(NavAgent *agent) {
 		return;
 	}
 
+	// The velocity computed before the agent stopped being controlled is outdated.
 	if (agent->get_use_3d_avoidance()) {
 		int64_t agent_3d_index = active_3d_avoidance_agents.find(agent);
 		if (agent_3d_index < 0) {
 			active_3d_avoidance_agents.push_back(agent);
+			agent->get_rvo_agent_3d()->hasStepInputs_ = false;
 			agents_dirty = true;
 		}
 	} else {
 		int64_t agent_2d_index = active_2d_avoidance_agents.find(agent);
 		if (agent_2d_index < 0) {
 			active_2d_avoidance_agents.push_back(agent);
+			agent->get_rvo_agent_2d()->hasStepInputs_ = false;
 			agents_dirty = true;
 		}
 	}
@@ -897,12 +880,42 @@ void NavMap::sync() {
 		for (NavRegion *region : regions) {
 			region->scratch_polygons();
 		}
+		regenerate_connections = true;
+	}
+
+	if (regenerate_connections) {
+		// Stitch all the regions again from scratch.
+		for (NavRegion *region : regions) {
+			region->get_connections().clear();
+		}
+		region_polygons.clear();
+		region_bvh.clear();
+		region_bvh_dirty = true;
+		edge_connections.clear();
+		edge_merge_count = 0;
+		link_connected_polygons.clear();
 		regenerate_links = true;
 	}
 
+	// Only the regions that were removed, added or changed are stitched again.
+	LocalVector<NavRegion *> map_removed_regions;
+	for (NavRegion *region : removed_regions) {
+		if (region_polygons.has(region) && !regions.has(region) && !map_removed_regions.has(region)) {
+			map_removed_regions.push_back(region);
+		}
+	}
+	removed_regions.clear();
+
+	LocalVector<NavRegion *> map_changed_regions;
+	bool navigation_layers_changed = false;
 	for (NavRegion *region : regions) {
-		if (region->sync()) {
-			regenerate_links = true;
+		if (region->check_navigation_layers_dirty()) {
+			navigation_layers_changed = true;
+		}
+		const bool polygons_changed = region->sync();
+		const bool in_map = region_polygons.has(region);
+		if (in_map != region->get_enabled() || (in_map && polygons_changed)) {
+			map_changed_regions.push_back(region);
 		}
 	}
 
@@ -912,304 +925,922 @@ void NavMap::sync() {
 		}
 	}
 
+	if (!map_removed_regions.is_empty() || !map_changed_regions.is_empty()) {
+		// The links may be connected to polygons that are about to be replaced.
+		regenerate_links = true;
+		region_bvh_dirty = true;
+	}
+
+	// Region layers can change without any of the polygons changing.
+	if (navigation_layers_changed) {
+		for (KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+			E.value.bvh.update_navigation_layers();
+		}
+		if (!region_bvh_dirty) {
+			region_bvh.update_navigation_layers();
+		}
+	}
+
 	if (regenerate_links) {
+		_clear_link_connections();
+
+		if (!map_removed_regions.is_empty() || !map_changed_regions.is_empty()) {
+			_update_region_connections(map_removed_regions, map_changed_regions);
+		}
+
+		if (region_bvh_dirty) {
+			_update_region_bvh();
+		}
+
+		_update_link_connections();
+		_update_map_polygons();
+
+		if (use_hierarchical_pathfinding) {
+			_update_clusters();
+		}
+
 		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
+		_new_pm_edge_count = edge_connections.size();
+		_new_pm_edge_merge_count = edge_merge_count;
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
+		for (const KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+			_new_pm_polygon_count += E.value.polygons.size();
+			_new_pm_edge_connection_count += E.key->get_connections().size();
+			_new_pm_edge_free_count += E.value.free_edges.size();
+		}
 
-		// Remove regions connections.
-		for (NavRegion *region : regions) {
-			region->get_connections().clear();
+		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
+		iteration_id = iteration_id % UINT32_MAX + 1;
+	}
+
+	if (region_bvh_dirty) {
+		// Only the order of the regions changed.
+		_update_region_bvh();
+	}
+
+	// The costs and layers the flow fields were built with can change without any of the polygons changing.
+	const uint32_t new_flow_fields_hash = _get_flow_fields_hash();
+	if (new_flow_fields_hash != flow_fields_hash) {
+		_clear_flow_fields();
+		flow_fields_hash = new_flow_fields_hash;
+	}
+
+	regenerate_polygons = false;
+	regenerate_connections = false;
+	regenerate_links = false;
+
+	// Do we have modified obstacle positions?
+	for (NavObstacle *obstacle : obstacles) {
+		if (obstacle->check_dirty()) {
+			obstacles_dirty = true;
 		}
+	}
+	// Do we have modified agent arrays?
+	for (NavAgent *agent : agents) {
+		if (agent->check_dirty()) {
+			agents_dirty = true;
+		}
+	}
 
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+	// Update avoidance worlds.
+	if (obstacles_dirty || agents_dirty) {
+		_update_rvo_simulation();
+	}
+
+	obstacles_dirty = false;
+	agents_dirty = false;
+
+	// Performance Monitor.
+	pm_region_count = _new_pm_region_count;
+	pm_agent_count = _new_pm_agent_count;
+	pm_link_count = _new_pm_link_count;
+	pm_polygon_count = _new_pm_polygon_count;
+	pm_edge_count = _new_pm_edge_count;
+	pm_edge_merge_count = _new_pm_edge_merge_count;
+	pm_edge_connection_count = _new_pm_edge_connection_count;
+	pm_edge_free_count = _new_pm_edge_free_count;
+}
+
+static _FORCE_INLINE_ gd::EdgeKey _get_edge_key(const gd::Polygon &p_polygon, int p_edge) {
+	return gd::EdgeKey(p_polygon.points[p_edge].key, p_polygon.points[(p_edge + 1) % p_polygon.points.size()].key);
+}
+
+static _FORCE_INLINE_ AABB _get_edge_aabb(const gd::Edge::Connection &p_edge, real_t p_margin) {
+	AABB aabb(p_edge.polygon->points[p_edge.edge].pos, Vector3());
+	aabb.expand_to(p_edge.polygon->points[(p_edge.edge + 1) % p_edge.polygon->points.size()].pos);
+	aabb.grow_by(p_margin);
+	return aabb;
+}
+
+bool NavMap::_is_free_edge(const gd::Edge::Connection &p_edge) const {
+	return use_edge_connections && p_edge.polygon->owner->get_use_edge_connections();
+}
+
+bool NavMap::_get_free_edge_connection(const gd::Edge::Connection &p_free_edge, const gd::Edge::Connection &p_other_edge, gd::Edge::Connection &r_connection) const {
+	const Vector3 edge_p1 = p_free_edge.polygon->points[p_free_edge.edge].pos;
+	const Vector3 edge_p2 = p_free_edge.polygon->points[(p_free_edge.edge + 1) % p_free_edge.polygon->points.size()].pos;
+	const Vector3 other_edge_p1 = p_other_edge.polygon->points[p_other_edge.edge].pos;
+	const Vector3 other_edge_p2 = p_other_edge.polygon->points[(p_other_edge.edge + 1) % p_other_edge.polygon->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_to(self1) > edge_connection_margin) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_to(self2) > edge_connection_margin) {
+		return false;
+	}
+
+	// The edges can now be connected.
+	r_connection = p_other_edge;
+	r_connection.pathway_start = (self1 + other1) / 2.0;
+	r_connection.pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+void NavMap::_update_region_connections(const LocalVector<NavRegion *> &p_removed_regions, const LocalVector<NavRegion *> &p_changed_regions) {
+	// Removed regions may already be freed, they are only used as keys.
+	HashSet<const NavBase *> changed_owners;
+	for (NavRegion *region : p_removed_regions) {
+		changed_owners.insert(region);
+	}
+	for (NavRegion *region : p_changed_regions) {
+		changed_owners.insert(region);
+	}
+
+	// Keys of the edges that were added or removed, and which of them were free edges of unchanged regions.
+	HashSet<gd::EdgeKey, gd::EdgeKey> changed_keys;
+	HashSet<gd::EdgeKey, gd::EdgeKey> previously_free_keys;
+
+	// Regions with edge connections that changed.
+	HashSet<NavRegion *> touched_regions;
+
+	// Records the state of the edges with this key before the first change.
+	auto touch_edge_key = [&](const gd::EdgeKey &p_key, const LocalVector<gd::Edge::Connection> &p_edges) {
+		if (changed_keys.has(p_key)) {
+			return;
+		}
+		changed_keys.insert(p_key);
+		if (p_edges.size() == 2) {
+			edge_merge_count -= 1;
+		} else if (p_edges.size() == 1 && !changed_owners.has(p_edges[0].polygon->owner) && _is_free_edge(p_edges[0])) {
+			previously_free_keys.insert(p_key);
+		}
+	};
+
+	// Remove the previous polygons of the changed regions from the edges.
+	LocalVector<AABB> previous_bounds;
+	for (const NavBase *owner : changed_owners) {
+		const RegionPolygons *previous = region_polygons.getptr((NavRegion *)owner);
+		if (!previous) {
+			continue;
+		}
+		previous_bounds.push_back(previous->bounds.grow(edge_connection_margin));
+
+		for (const gd::Polygon &polygon : previous->polygons) {
+			for (uint32_t p = 0; p < polygon.points.size(); p++) {
+				const gd::EdgeKey ek = _get_edge_key(polygon, p);
+				LocalVector<gd::Edge::Connection> *edges = edge_connections.getptr(ek);
+				if (!edges) {
+					continue;
+				}
+				touch_edge_key(ek, *edges);
+				for (uint32_t i = 0; i < edges->size(); i++) {
+					if ((*edges)[i].polygon == &polygon && (*edges)[i].edge == int(p)) {
+						edges->remove_at(i);
+						break;
+					}
+				}
+				if (edges->is_empty()) {
+					edge_connections.erase(ek);
+				}
 			}
-			count += region->get_polygons().size();
 		}
-		polygons.resize(count);
+	}
 
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+	// Unchanged regions close to the previous polygons may have connected their free edges to them.
+	for (KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+		if (changed_owners.has(E.key)) {
+			continue;
+		}
+		bool is_close = false;
+		for (const AABB &bounds : previous_bounds) {
+			if (bounds.intersects_inclusive(E.value.bounds)) {
+				is_close = true;
+				break;
 			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+		}
+		if (!is_close) {
+			continue;
+		}
+
+		for (const gd::Edge::Connection &free_edge : E.value.free_edges) {
+			Vector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+			for (int i = connections.size() - 1; i >= 0; i--) {
+				if (changed_owners.has(connections[i].polygon->owner)) {
+					connections.remove_at(i);
+					touched_regions.insert(E.key);
+				}
 			}
-			count += region->get_polygons().size();
 		}
+	}
 
-		_new_pm_polygon_count = polygons.size();
+	for (const NavBase *owner : changed_owners) {
+		region_polygons.erase((NavRegion *)owner);
+	}
 
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+	// Copy the polygons of the changed regions in the map and group their edges per key.
+	for (NavRegion *region : p_changed_regions) {
+		region->get_connections().clear();
+		if (!region->get_enabled()) {
+			continue;
+		}
+
+		RegionPolygons &map_polygons = region_polygons[region];
+		map_polygons.polygons = region->get_polygons();
+		map_polygons.bvh.build(map_polygons.polygons);
+		touched_regions.insert(region);
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
+		bool has_bounds = false;
+		for (gd::Polygon &polygon : map_polygons.polygons) {
+			for (uint32_t p = 0; p < polygon.points.size(); p++) {
+				if (has_bounds) {
+					map_polygons.bounds.expand_to(polygon.points[p].pos);
+				} else {
+					map_polygons.bounds = AABB(polygon.points[p].pos, Vector3());
+					has_bounds = true;
 				}
-				if (connections[ek].size() <= 1) {
+
+				const gd::EdgeKey ek = _get_edge_key(polygon, p);
+				LocalVector<gd::Edge::Connection> &edges = edge_connections[ek];
+				touch_edge_key(ek, edges);
+				if (edges.size() <= 1) {
 					// Add the polygon/edge tuple to this key.
 					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
+					new_connection.polygon = &polygon;
 					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
+					new_connection.pathway_start = polygon.points[p].pos;
+					new_connection.pathway_end = polygon.points[(p + 1) % polygon.points.size()].pos;
+					edges.push_back(new_connection);
 				} else {
 					// The edge is already connected with another edge, skip.
 					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 				}
 			}
 		}
+	}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
+	// Connect the edges that are shared in different polygons, and collect the edges that became free.
+	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> added_free_edges;
+	HashSet<gd::EdgeKey, gd::EdgeKey> added_free_keys;
+	HashSet<gd::EdgeKey, gd::EdgeKey> removed_free_keys;
+	AABB removed_free_edges_bounds;
+	for (const gd::EdgeKey &ek : changed_keys) {
+		LocalVector<gd::Edge::Connection> *edges = edge_connections.getptr(ek);
+		if (!edges) {
+			continue;
+		}
+
+		const bool was_free = previously_free_keys.has(ek);
+		if (was_free && edges->size() == 1) {
+			// Still the same free edge, keep its connections.
+			continue;
+		}
+
+		if (was_free) {
+			// The free edge of an unchanged region is shared now, its connections to close edges are dropped.
+			for (const gd::Edge::Connection &edge : *edges) {
+				RegionPolygons *owner_polygons = changed_owners.has(edge.polygon->owner) ? nullptr : region_polygons.getptr((NavRegion *)edge.polygon->owner);
+				if (!owner_polygons) {
+					continue;
+				}
+				for (uint32_t i = 0; i < owner_polygons->free_edges.size(); i++) {
+					if (owner_polygons->free_edges[i].polygon == edge.polygon && owner_polygons->free_edges[i].edge == edge.edge) {
+						owner_polygons->free_edges.remove_at_unordered(i);
+						break;
+					}
+				}
+				const AABB edge_aabb = _get_edge_aabb(edge, edge_connection_margin);
+				if (removed_free_keys.is_empty()) {
+					removed_free_edges_bounds = edge_aabb;
+				} else {
+					removed_free_edges_bounds.merge_with(edge_aabb);
 				}
+				removed_free_keys.insert(ek);
+				touched_regions.insert((NavRegion *)edge.polygon->owner);
 			}
 		}
 
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
+		for (const gd::Edge::Connection &edge : *edges) {
+			edge.polygon->edges[edge.edge].connections.clear();
+		}
 
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+		if (edges->size() == 2) {
+			// Connect edge that are shared in different polygons.
+			const gd::Edge::Connection &c1 = (*edges)[0];
+			const gd::Edge::Connection &c2 = (*edges)[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			edge_merge_count += 1;
+		} else if (edges->size() == 1 && _is_free_edge((*edges)[0])) {
+			const gd::Edge::Connection &edge = (*edges)[0];
+			NavRegion *owner = (NavRegion *)edge.polygon->owner;
+			region_polygons[owner].free_edges.push_back(edge);
+			added_free_edges[owner].push_back(edge);
+			added_free_keys.insert(ek);
+		}
+	}
 
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
+	// Drop the connections to the free edges that are shared now.
+	if (!removed_free_keys.is_empty()) {
+		for (KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+			if (!removed_free_edges_bounds.intersects_inclusive(E.value.bounds)) {
+				continue;
+			}
+			for (const gd::Edge::Connection &free_edge : E.value.free_edges) {
+				Vector<gd::Edge::Connection> &connections = free_edge.polygon->edges[free_edge.edge].connections;
+				for (int i = connections.size() - 1; i >= 0; i--) {
+					if (removed_free_keys.has(_get_edge_key(*connections[i].polygon, connections[i].edge))) {
+						connections.remove_at(i);
+						touched_regions.insert(E.key);
+					}
 				}
+			}
+		}
+	}
 
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+	// Find the compatible near edges of the new free edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (KeyValue<NavRegion *, LocalVector<gd::Edge::Connection>> &A : added_free_edges) {
+		touched_regions.insert(A.key);
+
+		// Only regions within the connection margin can hold compatible edges.
+		const AABB region_bounds = region_polygons[A.key].bounds.grow(edge_connection_margin);
+		LocalVector<KeyValue<NavRegion *, RegionPolygons> *> close_regions;
+		for (KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+			if (E.key != A.key && region_bounds.intersects_inclusive(E.value.bounds)) {
+				close_regions.push_back(&E);
+			}
+		}
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		for (const gd::Edge::Connection &free_edge : A.value) {
+			const AABB edge_aabb = _get_edge_aabb(free_edge, edge_connection_margin);
+			for (KeyValue<NavRegion *, RegionPolygons> *E : close_regions) {
+				if (!edge_aabb.intersects_inclusive(E->value.bounds)) {
 					continue;
 				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
+				for (const gd::Edge::Connection &other_edge : E->value.free_edges) {
+					gd::Edge::Connection new_connection;
+					if (_get_free_edge_connection(free_edge, other_edge, new_connection)) {
+						free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+					}
+					// The other direction is handled from the other edge when it is new as well.
+					if (!added_free_keys.has(_get_edge_key(*other_edge.polygon, other_edge.edge)) && _get_free_edge_connection(other_edge, free_edge, new_connection)) {
+						other_edge.polygon->edges[other_edge.edge].connections.push_back(new_connection);
+						touched_regions.insert(E->key);
+					}
 				}
+			}
+		}
+	}
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
+	// Update the region_connection map of the regions that changed.
+	for (NavRegion *region : touched_regions) {
+		const RegionPolygons *map_polygons = region_polygons.getptr(region);
+		if (!map_polygons) {
+			continue;
+		}
+		Vector<gd::Edge::Connection> &region_connections = region->get_connections();
+		region_connections.clear();
+		for (const gd::Edge::Connection &free_edge : map_polygons->free_edges) {
+			region_connections.append_array(free_edge.polygon->edges[free_edge.edge].connections);
+		}
+	}
+}
 
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+void NavMap::_update_region_bvh() {
+	// Regions are ordered like the map regions, so ties between them are broken the way
+	// a linear scan over the polygons of all the regions would.
+	LocalVector<const NavPolygonBVH *> trees;
+	trees.reserve(region_polygons.size());
+	for (uint32_t i = 0; i < regions.size(); i++) {
+		RegionPolygons *map_polygons = region_polygons.getptr(regions[i]);
+		if (map_polygons) {
+			map_polygons->bvh.set_order(i);
+			trees.push_back(&map_polygons->bvh);
+		}
+	}
+	region_bvh.build(trees);
+	region_bvh_dirty = false;
+}
 
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+void NavMap::_clear_link_connections() {
+	// Link connections are the only connections without a source edge.
+	for (gd::Polygon *polygon : link_connected_polygons) {
+		Vector<gd::Edge::Connection> &connections = polygon->edges[0].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].edge == -1) {
+				connections.remove_at(i);
 			}
 		}
+	}
+	link_connected_polygons.clear();
+}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+void NavMap::_update_link_connections() {
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
-				continue;
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		// Pick the polygons that are within our radius of the start and end points.
+		NavPolygonBVH::QueryResult start_result;
+		start_result.distance_squared = link_connection_radius * link_connection_radius;
+		_get_closest_point(start, start_result);
+		gd::Polygon *closest_start_polygon = start_result.polygon;
+		const Vector3 closest_start_point = start_result.point;
+
+		NavPolygonBVH::QueryResult end_result;
+		end_result.distance_squared = link_connection_radius * link_connection_radius;
+		_get_closest_point(end, end_result);
+		gd::Polygon *closest_end_polygon = end_result.polygon;
+		const Vector3 closest_end_point = end_result.point;
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.owner = link;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			Vector3 center;
+			for (int p = 0; p < 4; ++p) {
+				center += new_polygon.points[p].pos;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			new_polygon.center = center / real_t(new_polygon.points.size());
+			new_polygon.clockwise = true;
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_start_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back(closest_end_polygon);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
 			}
+		}
+	}
+
+	// Drop the polygons of the links that are not connected anymore.
+	link_polygons.resize(link_poly_idx);
+}
+
+void NavMap::_update_map_polygons() {
+	map_polygons.clear();
+	for (KeyValue<NavRegion *, RegionPolygons> &E : region_polygons) {
+		for (gd::Polygon &polygon : E.value.polygons) {
+			polygon.id = map_polygons.size();
+			map_polygons.push_back(&polygon);
+		}
+	}
+	for (gd::Polygon &polygon : link_polygons) {
+		polygon.id = map_polygons.size();
+		map_polygons.push_back(&polygon);
+	}
+}
+
+void NavMap::_update_clusters() {
+	clusters.clear();
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
+	for (gd::Polygon *polygon : map_polygons) {
+		polygon->cluster = UINT32_MAX;
+	}
+
+	// Grow the clusters breadth first over the connections between polygons of the same owner.
+	LocalVector<gd::Polygon *> cluster_polygons;
+	for (gd::Polygon *seed : map_polygons) {
+		if (seed->cluster != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster_id = clusters.size();
+		clusters.push_back(Cluster());
+		Cluster &cluster = clusters[cluster_id];
+		cluster.owner = seed->owner;
+
+		cluster_polygons.clear();
+		cluster_polygons.push_back(seed);
+		seed->cluster = cluster_id;
+
+		for (uint32_t i = 0; i < cluster_polygons.size(); i++) {
+			const gd::Polygon *polygon = cluster_polygons[i];
+			cluster.center += polygon->center;
+
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					if (cluster_polygons.size() >= hierarchical_cluster_size) {
+						break;
+					}
+					if (connection.polygon->cluster == UINT32_MAX && connection.polygon->owner == cluster.owner) {
+						connection.polygon->cluster = cluster_id;
+						cluster_polygons.push_back(connection.polygon);
 					}
 				}
 			}
+		}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
+		cluster.center /= real_t(cluster_polygons.size());
+	}
+
+	// Connect the clusters that have connected polygons.
+	for (const gd::Polygon *polygon : map_polygons) {
+		Cluster &cluster = clusters[polygon->cluster];
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t other_cluster = connection.polygon->cluster;
+				if (other_cluster == polygon->cluster) {
+					continue;
 				}
 
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
+				bool is_connected = false;
+				for (const ClusterConnection &cluster_connection : cluster.connections) {
+					if (cluster_connection.cluster == other_cluster) {
+						is_connected = true;
+						break;
+					}
+				}
+				if (!is_connected) {
+					ClusterConnection cluster_connection;
+					cluster_connection.cluster = other_cluster;
+					cluster_connection.distance = cluster.center.distance_to(clusters[other_cluster].center);
+					cluster.connections.push_back(cluster_connection);
 				}
 			}
 		}
+	}
+}
 
-		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
-		iteration_id = iteration_id % UINT32_MAX + 1;
+bool NavMap::_get_cluster_corridor(uint32_t p_from_cluster, uint32_t p_to_cluster, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const {
+	struct OpenCluster {
+		real_t cost = 0.0;
+		uint32_t cluster = 0;
+	};
+
+	struct OpenClusterComparator {
+		_FORCE_INLINE_ bool operator()(const OpenCluster &p_a, const OpenCluster &p_b) const {
+			return p_a.cost > p_b.cost;
+		}
+	};
+
+	const Vector3 &target = clusters[p_to_cluster].center;
+
+	LocalVector<real_t> traveled_distances;
+	LocalVector<uint32_t> back_clusters;
+	traveled_distances.resize(clusters.size());
+	back_clusters.resize(clusters.size());
+	for (uint32_t i = 0; i < clusters.size(); i++) {
+		traveled_distances[i] = FLT_MAX;
+		back_clusters[i] = UINT32_MAX;
 	}
 
-	// Do we have modified obstacle positions?
-	for (NavObstacle *obstacle : obstacles) {
-		if (obstacle->check_dirty()) {
-			obstacles_dirty = true;
+	SortArray<OpenCluster, OpenClusterComparator> sorter;
+	LocalVector<OpenCluster> open_list;
+
+	traveled_distances[p_from_cluster] = 0.0;
+	open_list.push_back({ clusters[p_from_cluster].center.distance_to(target) * clusters[p_from_cluster].owner->get_travel_cost(), p_from_cluster });
+
+	bool found_route = false;
+	while (!open_list.is_empty()) {
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		const OpenCluster current = open_list[open_list.size() - 1];
+		open_list.remove_at(open_list.size() - 1);
+
+		if (current.cluster == p_to_cluster) {
+			found_route = true;
+			break;
+		}
+
+		const Cluster &cluster = clusters[current.cluster];
+		const real_t traveled_distance = traveled_distances[current.cluster];
+		if (current.cost > traveled_distance + cluster.center.distance_to(target) * cluster.owner->get_travel_cost()) {
+			// Outdated entry, the cluster was reached with a lower cost since.
+			continue;
+		}
+
+		for (const ClusterConnection &connection : cluster.connections) {
+			const Cluster &other_cluster = clusters[connection.cluster];
+			if ((p_navigation_layers & other_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			real_t new_distance = traveled_distance + connection.distance * cluster.owner->get_travel_cost();
+			if (other_cluster.owner != cluster.owner) {
+				new_distance += other_cluster.owner->get_enter_cost();
+			}
+			if (new_distance >= traveled_distances[connection.cluster]) {
+				continue;
+			}
+
+			traveled_distances[connection.cluster] = new_distance;
+			back_clusters[connection.cluster] = current.cluster;
+			open_list.push_back({ new_distance + other_cluster.center.distance_to(target) * other_cluster.owner->get_travel_cost(), connection.cluster });
+			sorter.push_heap(0, open_list.size() - 1, 0, open_list[open_list.size() - 1], open_list.ptr());
 		}
 	}
-	// Do we have modified agent arrays?
-	for (NavAgent *agent : agents) {
-		if (agent->check_dirty()) {
-			agents_dirty = true;
+
+	if (!found_route) {
+		return false;
+	}
+
+	// The corridor holds the clusters along the route and their neighbors, which leaves room for the refined path to cut corners.
+	r_corridor.resize(clusters.size());
+	memset(r_corridor.ptr(), 0, r_corridor.size());
+	for (uint32_t cluster_id = p_to_cluster; cluster_id != UINT32_MAX; cluster_id = back_clusters[cluster_id]) {
+		r_corridor[cluster_id] = 1;
+		for (const ClusterConnection &connection : clusters[cluster_id].connections) {
+			r_corridor[connection.cluster] = 1;
 		}
 	}
+	return true;
+}
 
-	// Update avoidance worlds.
-	if (obstacles_dirty || agents_dirty) {
-		_update_rvo_simulation();
+uint32_t NavMap::_get_flow_fields_hash() const {
+	uint32_t hash = hash_murmur3_one_32(iteration_id);
+	for (const NavRegion *region : regions) {
+		hash = hash_murmur3_one_32(region->get_navigation_layers(), hash);
+		hash = hash_murmur3_one_real(region->get_enter_cost(), hash);
+		hash = hash_murmur3_one_real(region->get_travel_cost(), hash);
 	}
+	for (const NavLink *link : links) {
+		hash = hash_murmur3_one_32(link->get_navigation_layers(), hash);
+		hash = hash_murmur3_one_real(link->get_enter_cost(), hash);
+		hash = hash_murmur3_one_real(link->get_travel_cost(), hash);
+	}
+	return hash_fmix32(hash);
+}
 
-	regenerate_polygons = false;
-	regenerate_links = false;
-	obstacles_dirty = false;
-	agents_dirty = false;
+void NavMap::_clear_flow_fields() {
+	MutexLock lock(flow_fields_mutex);
+	for (FlowField *flow_field : flow_fields) {
+		memdelete(flow_field);
+	}
+	flow_fields.clear();
+}
 
-	// Performance Monitor.
-	pm_region_count = _new_pm_region_count;
-	pm_agent_count = _new_pm_agent_count;
-	pm_link_count = _new_pm_link_count;
-	pm_polygon_count = _new_pm_polygon_count;
-	pm_edge_count = _new_pm_edge_count;
-	pm_edge_merge_count = _new_pm_edge_merge_count;
-	pm_edge_connection_count = _new_pm_edge_connection_count;
-	pm_edge_free_count = _new_pm_edge_free_count;
+Vector3 NavMap::get_flow_field_next_position(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const {
+	RWLockRead read_lock(map_rwlock);
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector3();
+	}
+
+	NavPolygonBVH::QueryResult begin_result;
+	_get_closest_point(p_origin, p_navigation_layers, begin_result);
+	if (!begin_result.polygon) {
+		return Vector3();
+	}
+
+	MutexLock lock(flow_fields_mutex);
+	const FlowField *flow_field = _get_flow_field(p_destination, p_navigation_layers);
+	if (!flow_field) {
+		return begin_result.point;
+	}
+
+	// Agents standing on the way out of their polygon are given the next waypoint already,
+	// as they may still be closest to the polygon they are leaving.
+	const real_t arrival_distance_squared = cell_size * cell_size;
+	uint32_t polygon_id = begin_result.polygon->id;
+	while (polygon_id != flow_field->destination_polygon->id) {
+		const uint32_t next_polygon_id = flow_field->next_polygons[polygon_id];
+		if (next_polygon_id == UINT32_MAX) {
+			// The destination cannot be reached from here.
+			return begin_result.point;
+		}
+		const Vector3 &waypoint = flow_field->waypoints[polygon_id];
+		if (begin_result.point.distance_squared_to(waypoint) > arrival_distance_squared) {
+			return waypoint;
+		}
+		polygon_id = next_polygon_id;
+	}
+	return flow_field->destination_point;
+}
+
+const NavMap::FlowField *NavMap::_get_flow_field(const Vector3 &p_destination, uint32_t p_navigation_layers) const {
+	flow_fields_query_count++;
+
+	for (FlowField *flow_field : flow_fields) {
+		if (flow_field->destination == p_destination && flow_field->navigation_layers == p_navigation_layers) {
+			flow_field->last_used = flow_fields_query_count;
+			return flow_field;
+		}
+	}
+
+	NavPolygonBVH::QueryResult end_result;
+	_get_closest_point(p_destination, p_navigation_layers, end_result);
+	if (!end_result.polygon) {
+		return nullptr;
+	}
+
+	// Replace the least recently used flow field when the cache is full.
+	FlowField *flow_field = nullptr;
+	if (flow_fields.size() < MAX_FLOW_FIELDS) {
+		flow_field = memnew(FlowField);
+		flow_fields.push_back(flow_field);
+	} else {
+		flow_field = flow_fields[0];
+		for (FlowField *other_flow_field : flow_fields) {
+			if (other_flow_field->last_used < flow_field->last_used) {
+				flow_field = other_flow_field;
+			}
+		}
+	}
+
+	flow_field->destination = p_destination;
+	flow_field->navigation_layers = p_navigation_layers;
+	flow_field->last_used = flow_fields_query_count;
+	flow_field->destination_polygon = end_result.polygon;
+	flow_field->destination_point = end_result.point;
+	_build_flow_field(*flow_field);
+	return flow_field;
+}
+
+void NavMap::_build_flow_field(FlowField &r_flow_field) const {
+	struct IncomingConnection {
+		uint32_t polygon = 0;
+		const gd::Edge::Connection *connection = nullptr;
+	};
+
+	struct OpenPolygon {
+		real_t cost = 0.0;
+		uint32_t polygon = 0;
+	};
+
+	struct OpenPolygonComparator {
+		_FORCE_INLINE_ bool operator()(const OpenPolygon &p_a, const OpenPolygon &p_b) const {
+			return p_a.cost > p_b.cost;
+		}
+	};
+
+	const uint32_t polygon_count = map_polygons.size();
+
+	// The field is grown backwards from the destination, which follows the connections leading into each polygon.
+	LocalVector<uint32_t> incoming_offsets;
+	incoming_offsets.resize(polygon_count + 1);
+	memset(incoming_offsets.ptr(), 0, incoming_offsets.size() * sizeof(uint32_t));
+	for (const gd::Polygon *polygon : map_polygons) {
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				incoming_offsets[connection.polygon->id + 1]++;
+			}
+		}
+	}
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		incoming_offsets[i + 1] += incoming_offsets[i];
+	}
+
+	LocalVector<IncomingConnection> incoming_connections;
+	incoming_connections.resize(incoming_offsets[polygon_count]);
+	LocalVector<uint32_t> incoming_counts;
+	incoming_counts.resize(polygon_count);
+	memset(incoming_counts.ptr(), 0, incoming_counts.size() * sizeof(uint32_t));
+	for (const gd::Polygon *polygon : map_polygons) {
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const uint32_t to_polygon = connection.polygon->id;
+				IncomingConnection &incoming_connection = incoming_connections[incoming_offsets[to_polygon] + incoming_counts[to_polygon]++];
+				incoming_connection.polygon = polygon->id;
+				incoming_connection.connection = &connection;
+			}
+		}
+	}
+
+	r_flow_field.next_polygons.resize(polygon_count);
+	r_flow_field.waypoints.resize(polygon_count);
+	r_flow_field.costs.resize(polygon_count);
+	for (uint32_t i = 0; i < polygon_count; i++) {
+		r_flow_field.next_polygons[i] = UINT32_MAX;
+		r_flow_field.costs[i] = FLT_MAX;
+	}
+
+	const uint32_t destination_id = r_flow_field.destination_polygon->id;
+	r_flow_field.waypoints[destination_id] = r_flow_field.destination_point;
+	r_flow_field.costs[destination_id] = 0.0;
+
+	SortArray<OpenPolygon, OpenPolygonComparator> sorter;
+	LocalVector<OpenPolygon> open_list;
+	open_list.push_back({ 0.0, destination_id });
+
+	while (!open_list.is_empty()) {
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		const OpenPolygon current = open_list[open_list.size() - 1];
+		open_list.remove_at(open_list.size() - 1);
+
+		if (current.cost > r_flow_field.costs[current.polygon]) {
+			// Outdated entry, the polygon was reached with a lower cost since.
+			continue;
+		}
+
+		const gd::Polygon *polygon = map_polygons[current.polygon];
+		const Vector3 waypoint = r_flow_field.waypoints[current.polygon];
+
+		for (uint32_t i = incoming_offsets[current.polygon]; i < incoming_offsets[current.polygon + 1]; i++) {
+			const IncomingConnection &incoming_connection = incoming_connections[i];
+			const gd::Polygon *from_polygon = map_polygons[incoming_connection.polygon];
+
+			// Only consider polygons in regions with compatible layers.
+			if ((r_flow_field.navigation_layers & from_polygon->owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			// The agents leave the polygon through the closest point of the gateway, as seen from the next waypoint.
+			Vector3 pathway[2] = { incoming_connection.connection->pathway_start, incoming_connection.connection->pathway_end };
+			const Vector3 from_waypoint = Geometry3D::get_closest_point_to_segment(waypoint, pathway);
+			real_t cost = current.cost + from_waypoint.distance_to(waypoint) * polygon->owner->get_travel_cost();
+			if (from_polygon->owner != polygon->owner) {
+				cost += polygon->owner->get_enter_cost();
+			}
+			if (cost >= r_flow_field.costs[incoming_connection.polygon]) {
+				continue;
+			}
+
+			r_flow_field.next_polygons[incoming_connection.polygon] = current.polygon;
+			r_flow_field.waypoints[incoming_connection.polygon] = from_waypoint;
+			r_flow_field.costs[incoming_connection.polygon] = cost;
+			open_list.push_back({ cost, incoming_connection.polygon });
+			sorter.push_heap(0, open_list.size() - 1, 0, open_list[open_list.size() - 1], open_list.ptr());
+		}
+	}
 }
 
 void NavMap::_update_rvo_obstacles_tree_2d() {
@@ -1290,6 +1921,12 @@ void NavMap::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
+uint32_t NavMap::_get_rvo_agent_subtree_size(uint32_t p_agent_count) const {
+	// Enough subtrees to keep every thread busy, but not so small that scheduling them costs more than building them.
+	const uint32_t subtree_count = WorkerThreadPool::get_singleton()->get_thread_count() * 4;
+	return MAX(p_agent_count / subtree_count, 256u);
+}
+
 void NavMap::_update_rvo_agents_tree_2d() {
 	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
 	std::vector<RVO2D::Agent2D *> raw_agents;
@@ -1297,7 +1934,19 @@ void NavMap::_update_rvo_agents_tree_2d() {
 	for (NavAgent *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	const bool use_subtrees = use_threads && avoidance_use_multiple_threads;
+	const uint32_t subtree_size = use_subtrees ? _get_rvo_agent_subtree_size(raw_agents.size()) : 0;
+	if (use_subtrees && raw_agents.size() > subtree_size) {
+		// Only the upper levels of the tree are built here, the subtrees below them are built in parallel.
+		std::vector<RVO2D::KdTree2D::AgentSubtree> subtrees;
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents, subtree_size, subtrees);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_build_rvo_agent_subtree_2d, subtrees.data(), subtrees.size(), -1, true, SNAME("RVOAgentTree2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		rvo_simulation_2d.kdTree_->updateAgentPositions();
+	} else {
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+	}
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
@@ -1307,12 +1956,33 @@ void NavMap::_update_rvo_agents_tree_3d() {
 	for (NavAgent *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	const bool use_subtrees = use_threads && avoidance_use_multiple_threads;
+	const uint32_t subtree_size = use_subtrees ? _get_rvo_agent_subtree_size(raw_agents.size()) : 0;
+	if (use_subtrees && raw_agents.size() > subtree_size) {
+		// Only the upper levels of the tree are built here, the subtrees below them are built in parallel.
+		std::vector<RVO3D::KdTree3D::AgentSubtree> subtrees;
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents, subtree_size, subtrees);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::_build_rvo_agent_subtree_3d, subtrees.data(), subtrees.size(), -1, true, SNAME("RVOAgentTree3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		rvo_simulation_3d.kdTree_->updateAgentPositions();
+	} else {
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+	}
+}
+
+void NavMap::_build_rvo_agent_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentSubtree *p_subtrees) {
+	rvo_simulation_2d.kdTree_->buildAgentSubtree(p_subtrees[p_index]);
+}
+
+void NavMap::_build_rvo_agent_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentSubtree *p_subtrees) {
+	rvo_simulation_3d.kdTree_->buildAgentSubtree(p_subtrees[p_index]);
 }
 
 void NavMap::_update_rvo_simulation() {
 	if (obstacles_dirty) {
 		_update_rvo_obstacles_tree_2d();
+		avoidance_step_dirty = true;
 	}
 	if (agents_dirty) {
 		_update_rvo_agents_tree_2d();
@@ -1321,37 +1991,73 @@ void NavMap::_update_rvo_simulation() {
 }
 
 void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+	RVO2D::Agent2D *rvo_agent = (*(agent + index))->get_rvo_agent_2d();
+	rvo_agent->computeNeighbors(&rvo_simulation_2d);
+	// Agents among unchanged neighbors, which didn't change either, would compute the same velocity again.
+	if (avoidance_step_dirty || !rvo_agent->isNewVelocityValid()) {
+		rvo_agent->computeNewVelocity(&rvo_simulation_2d);
+	}
 }
 
 void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+	RVO3D::Agent3D *rvo_agent = (*(agent + index))->get_rvo_agent_3d();
+	rvo_agent->computeNeighbors(&rvo_simulation_3d);
+	// Agents among unchanged neighbors, which didn't change either, would compute the same velocity again.
+	if (avoidance_step_dirty || !rvo_agent->isNewVelocityValid()) {
+		rvo_agent->computeNewVelocity(&rvo_simulation_3d);
+	}
+}
+
+void NavMap::update_avoidance_agents_2d() {
+	for (NavAgent *agent : active_2d_avoidance_agents) {
+		agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+		agent->update();
+	}
+}
+
+void NavMap::update_avoidance_agents_3d() {
+	for (NavAgent *agent : active_3d_avoidance_agents) {
+		agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+		agent->update();
+	}
 }
 
 void NavMap::step(real_t p_deltatime) {
+	if (deltatime != p_deltatime) {
+		avoidance_step_dirty = true;
+	}
 	deltatime = p_deltatime;
 
 	rvo_simulation_2d.setTimeStep(float(deltatime));
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
+	// The inputs of all the agents are stored before any of them moves, so they can be compared with the ones of their neighbors.
+	if (active_2d_avoidance_agents.size() > 0) {
+		rvo_simulation_2d.kdTree_->updateAgentPositions();
+		for (NavAgent *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->storeStepInputs();
+		}
+	}
+	if (active_3d_avoidance_agents.size() > 0) {
+		rvo_simulation_3d.kdTree_->updateAgentPositions();
+		for (NavAgent *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->storeStepInputs();
+		}
+	}
+
 	if (active_2d_avoidance_agents.size() > 0) {
 		if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
+			for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_2d(i, active_2d_avoidance_agents.ptr());
 			}
 		}
+
+		// The agents only move once all of them computed their new velocity from the same state,
+		// so the result doesn't depend on the order they are computed in.
+		update_avoidance_agents_2d();
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
@@ -1359,14 +2065,17 @@ void NavMap::step(real_t p_deltatime) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
+			for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_3d(i, active_3d_avoidance_agents.ptr());
 			}
 		}
+
+		// The agents only move once all of them computed their new velocity from the same state,
+		// so the result doesn't depend on the order they are computed in.
+		update_avoidance_agents_3d();
 	}
+
+	avoidance_step_dirty = false;
 }
 
 void NavMap::dispatch_callbacks() {
@@ -1420,7 +2129,11 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	hierarchical_cluster_size = MAX(int(GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size")), 1);
 }
 
 NavMap::~NavMap() {
+	_clear_flow_fields();
 }
@@ -31,11 +31,13 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_map_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -72,17 +74,91 @@ class NavMap : public NavRid {
 	real_t link_connection_radius = 1.0;
 
 	bool regenerate_polygons = true;
+	bool regenerate_connections = true;
 	bool regenerate_links = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// Regions removed from the map since the last sync.
+	LocalVector<NavRegion *> removed_regions;
+
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
+	/// Region polygons the links are connected to.
+	LocalVector<gd::Polygon *> link_connected_polygons;
+
+	/// Map polygons of an enabled region, kept with their connections as long as the region does not change.
+	struct RegionPolygons {
+		LocalVector<gd::Polygon> polygons;
+
+		/// Spatial index over the polygons.
+		NavPolygonBVH bvh;
+
+		AABB bounds;
+
+		/// Edges not shared with any other polygon, which can be connected to close edges of other regions.
+		LocalVector<gd::Edge::Connection> free_edges;
+	};
+
 	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	HashMap<NavRegion *, RegionPolygons> region_polygons;
+
+	/// Spatial index over the polygons of all the regions, rebuilt when regions are added, removed or changed.
+	NavMapBVH region_bvh;
+	bool region_bvh_dirty = true;
+
+	/// All the map polygon edges grouped per key.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> edge_connections;
+	int edge_merge_count = 0;
+
+	/// All the region and link polygons of the map, indexed by their id.
+	LocalVector<gd::Polygon *> map_polygons;
+
+	/// Hierarchical path search: connected polygons of the same owner are grouped into clusters,
+	/// the path is first searched on the cluster graph and then refined within the found clusters.
+	bool use_hierarchical_pathfinding = false;
+	uint32_t hierarchical_cluster_size = 64;
+
+	struct ClusterConnection {
+		uint32_t cluster = 0;
+		real_t distance = 0.0;
+	};
+
+	struct Cluster {
+		const NavBase *owner = nullptr;
+		Vector3 center;
+		LocalVector<ClusterConnection> connections;
+	};
+
+	LocalVector<Cluster> clusters;
+
+	/// Flow fields: the way to one destination from every map polygon, computed in a single pass
+	/// and shared by all the agents moving to that destination until the map changes.
+	static const uint32_t MAX_FLOW_FIELDS = 16;
+
+	struct FlowField {
+		Vector3 destination;
+		uint32_t navigation_layers = 0;
+		uint64_t last_used = 0;
+
+		const gd::Polygon *destination_polygon = nullptr;
+		Vector3 destination_point;
+
+		/// Per polygon id: the next polygon toward the destination, the point where it is entered and the cost from that point.
+		LocalVector<uint32_t> next_polygons;
+		LocalVector<Vector3> waypoints;
+		LocalVector<real_t> costs;
+	};
+
+	/// Guards the flow fields, which are built by the queries under the map read lock.
+	mutable Mutex flow_fields_mutex;
+	mutable LocalVector<FlowField *> flow_fields;
+	mutable uint64_t flow_fields_query_count = 0;
+	/// Hash of the map iteration and the region and link costs and layers the flow fields were built with.
+	uint32_t flow_fields_hash = 0;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -104,6 +180,10 @@ class NavMap : public NavRid {
 	/// Are rvo obstacles modified?
 	bool obstacles_dirty = true;
 
+	/// Makes every avoidance agent compute a new velocity in the next step,
+	/// instead of keeping the last one while neither it nor its neighbors changed.
+	bool avoidance_step_dirty = true;
+
 	/// Physics delta time
 	real_t deltatime = 0.0;
 
@@ -171,6 +251,7 @@ public:
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
 	gd::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	RID get_closest_point_owner(const Vector3 &p_point) const;
+	Vector3 get_flow_field_next_position(const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers) const;
 
 	void add_region(NavRegion *p_region);
 	void remove_region(NavRegion *p_region);
@@ -222,12 +303,35 @@ private:
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
+	void update_avoidance_agents_2d();
+	void update_avoidance_agents_3d();
+
+	void _get_closest_point(const Vector3 &p_point, NavPolygonBVH::QueryResult &r_result) const;
+	void _get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, NavPolygonBVH::QueryResult &r_result) const;
+
+	bool _is_free_edge(const gd::Edge::Connection &p_edge) const;
+	bool _get_free_edge_connection(const gd::Edge::Connection &p_free_edge, const gd::Edge::Connection &p_other_edge, gd::Edge::Connection &r_connection) const;
+	void _update_region_connections(const LocalVector<NavRegion *> &p_removed_regions, const LocalVector<NavRegion *> &p_changed_regions);
+	void _update_region_bvh();
+	void _clear_link_connections();
+	void _update_link_connections();
+	void _update_map_polygons();
+	void _update_clusters();
+	bool _get_cluster_corridor(uint32_t p_from_cluster, uint32_t p_to_cluster, uint32_t p_navigation_layers, LocalVector<uint8_t> &r_corridor) const;
+
+	uint32_t _get_flow_fields_hash() const;
+	void _clear_flow_fields();
+	const FlowField *_get_flow_field(const Vector3 &p_destination, uint32_t p_navigation_layers) const;
+	void _build_flow_field(FlowField &r_flow_field) const;
 
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
+	uint32_t _get_rvo_agent_subtree_size(uint32_t p_agent_count) const;
+	void _build_rvo_agent_subtree_2d(uint32_t p_index, RVO2D::KdTree2D::AgentSubtree *p_subtrees);
+	void _build_rvo_agent_subtree_3d(uint32_t p_index, RVO3D::KdTree3D::AgentSubtree *p_subtrees);
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
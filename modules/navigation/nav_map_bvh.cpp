@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  nav_map_bvh.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "nav_map_bvh.h"
+
+#include "core/templates/sort_array.h"
+
+void NavMapBVH::clear() {
+	nodes.clear();
+	items.clear();
+}
+
+void NavMapBVH::build(const LocalVector<const NavPolygonBVH *> &p_trees) {
+	clear();
+
+	for (const NavPolygonBVH *tree : p_trees) {
+		if (!tree->is_empty()) {
+			items.push_back(tree);
+		}
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve((items.size() / LEAF_SIZE + 1) * 2);
+	nodes.resize(1);
+	_build_node(0, 0, items.size());
+}
+
+void NavMapBVH::_build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to) {
+	AABB aabb = items[p_from]->get_aabb();
+	AABB center_bounds(aabb.get_center(), Vector3());
+	uint32_t navigation_layers = 0;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		aabb.merge_with(items[i]->get_aabb());
+		center_bounds.expand_to(items[i]->get_aabb().get_center());
+		navigation_layers |= items[i]->get_navigation_layers();
+	}
+
+	nodes[p_node].aabb = aabb;
+	nodes[p_node].navigation_layers = navigation_layers;
+
+	if (p_to - p_from <= LEAF_SIZE) {
+		nodes[p_node].first = p_from;
+		nodes[p_node].count = p_to - p_from;
+		return;
+	}
+
+	const uint32_t middle = (p_from + p_to) / 2;
+	SortArray<const NavPolygonBVH *, ItemComparator> sorter;
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, middle, items.ptr());
+
+	const uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(first_child, p_from, middle);
+	_build_node(first_child + 1, middle, p_to);
+}
+
+void NavMapBVH::update_navigation_layers() {
+	if (!nodes.is_empty()) {
+		_update_node_navigation_layers(0);
+	}
+}
+
+uint32_t NavMapBVH::_update_node_navigation_layers(uint32_t p_node) {
+	Node &node = nodes[p_node];
+	uint32_t navigation_layers = 0;
+	if (node.count > 0) {
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			navigation_layers |= items[i]->get_navigation_layers();
+		}
+	} else {
+		navigation_layers = _update_node_navigation_layers(node.first) | _update_node_navigation_layers(node.first + 1);
+	}
+	node.navigation_layers = navigation_layers;
+	return navigation_layers;
+}
+
+template <typename D, typename V>
+void NavMapBVH::_query(const D &p_get_node_distance_squared, const V &p_visit, NavPolygonBVH::QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	// Nodes the query must skip report an infinite distance.
+	StackEntry stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, p_get_node_distance_squared(nodes[0]) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		// Trees at the same distance are still visited, they can hold a polygon that wins the tie.
+		if (entry.distance_squared > r_result.distance_squared) {
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				p_visit(items[i]);
+			}
+			continue;
+		}
+
+		// Visit the nearest child first so the other one is more likely to be pruned.
+		const real_t first_distance_squared = p_get_node_distance_squared(nodes[node.first]);
+		const real_t second_distance_squared = p_get_node_distance_squared(nodes[node.first + 1]);
+		ERR_FAIL_COND(stack_size + 2 > STACK_SIZE);
+		if (first_distance_squared <= second_distance_squared) {
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+			stack[stack_size++] = { node.first, first_distance_squared };
+		} else {
+			stack[stack_size++] = { node.first, first_distance_squared };
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+		}
+	}
+}
+
+void NavMapBVH::get_closest_point(const Vector3 &p_point, NavPolygonBVH::QueryResult &r_result) const {
+	_query([&](const Node &p_node) { return NavPolygonBVH::get_aabb_distance_squared(p_node.aabb, p_point); },
+			[&](const NavPolygonBVH *p_tree) { p_tree->get_closest_point(p_point, r_result); },
+			r_result);
+}
+
+void NavMapBVH::get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, NavPolygonBVH::QueryResult &r_result) const {
+	_query([&](const Node &p_node) { return (p_node.navigation_layers & p_navigation_layers) ? NavPolygonBVH::get_aabb_distance_squared(p_node.aabb, p_point) : real_t(INFINITY); },
+			[&](const NavPolygonBVH *p_tree) { p_tree->get_closest_point(p_point, p_navigation_layers, r_result); },
+			r_result);
+}
+
+void NavMapBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, NavPolygonBVH::QueryResult &r_result) const {
+	_query([&](const Node &p_node) { return p_node.aabb.intersects_segment(p_from, p_to) ? NavPolygonBVH::get_aabb_distance_squared(p_node.aabb, p_from) : real_t(INFINITY); },
+			[&](const NavPolygonBVH *p_tree) { p_tree->intersect_segment(p_from, p_to, r_result); },
+			r_result);
+}
+
+void NavMapBVH::get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, NavPolygonBVH::QueryResult &r_result) const {
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	_query([&](const Node &p_node) { return NavPolygonBVH::get_aabb_distance_squared(p_node.aabb, segment_aabb); },
+			[&](const NavPolygonBVH *p_tree) { p_tree->get_closest_edge_point_to_segment(p_from, p_to, r_result); },
+			r_result);
+}
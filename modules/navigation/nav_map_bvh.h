@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  nav_map_bvh.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef NAV_MAP_BVH_H
+#define NAV_MAP_BVH_H
+
+#include "nav_polygon_bvh.h"
+
+/// Tree over the bounds of the polygon trees of a map, so queries only visit the trees that can hold a closer result.
+class NavMapBVH {
+	/// Maximum number of polygon trees stored in a leaf.
+	static const uint32_t LEAF_SIZE = 2;
+	static const uint32_t STACK_SIZE = 64;
+
+	struct Node {
+		AABB aabb;
+
+		/// Union of the navigation layers of every polygon tree below this node.
+		uint32_t navigation_layers = 0;
+
+		/// First item of a leaf, or first child of a branch (the second child follows it).
+		uint32_t first = 0;
+
+		/// Number of items in a leaf, 0 for a branch.
+		uint32_t count = 0;
+	};
+
+	struct ItemComparator {
+		int axis = 0;
+
+		_FORCE_INLINE_ bool operator()(const NavPolygonBVH *p_a, const NavPolygonBVH *p_b) const {
+			return (p_a->get_aabb().position[axis] * 2.0 + p_a->get_aabb().size[axis]) < (p_b->get_aabb().position[axis] * 2.0 + p_b->get_aabb().size[axis]);
+		}
+	};
+
+	struct StackEntry {
+		uint32_t node = 0;
+		real_t distance_squared = 0.0;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<const NavPolygonBVH *> items;
+
+	void _build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to);
+	uint32_t _update_node_navigation_layers(uint32_t p_node);
+
+	template <typename D, typename V>
+	void _query(const D &p_get_node_distance_squared, const V &p_visit, NavPolygonBVH::QueryResult &r_result) const;
+
+public:
+	/// Builds the tree over the non-empty polygon trees, which must stay in place as long as the tree is used.
+	void build(const LocalVector<const NavPolygonBVH *> &p_trees);
+	void clear();
+
+	/// Refreshes the navigation layers from the polygon trees, which must be updated first.
+	void update_navigation_layers();
+
+	/// Same queries as NavPolygonBVH, over all the polygon trees.
+	void get_closest_point(const Vector3 &p_point, NavPolygonBVH::QueryResult &r_result) const;
+	void get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, NavPolygonBVH::QueryResult &r_result) const;
+	void intersect_segment(const Vector3 &p_from, const Vector3 &p_to, NavPolygonBVH::QueryResult &r_result) const;
+	void get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, NavPolygonBVH::QueryResult &r_result) const;
+};
+
+#endif // NAV_MAP_BVH_H
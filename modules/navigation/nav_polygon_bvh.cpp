@@ -0,0 +1,332 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "nav_base.h"
+
+#include "core/math/face3.h"
+#include "core/math/geometry_3d.h"
+#include "core/templates/sort_array.h"
+
+void NavPolygonBVH::clear() {
+	nodes.clear();
+	items.clear();
+	owners.clear();
+}
+
+void NavPolygonBVH::build(LocalVector<gd::Polygon> &p_polygons) {
+	clear();
+
+	items.reserve(p_polygons.size());
+	for (uint32_t polygon_index = 0; polygon_index < p_polygons.size(); polygon_index++) {
+		gd::Polygon &polygon = p_polygons[polygon_index];
+		if (polygon.points.size() < 3) {
+			// No faces to query.
+			continue;
+		}
+
+		// Polygons of the same owner are usually stored next to each other.
+		if (owners.is_empty() || owners[owners.size() - 1].base != polygon.owner) {
+			Owner owner;
+			owner.base = polygon.owner;
+			owner.navigation_layers = polygon.owner->get_navigation_layers();
+			owners.push_back(owner);
+		}
+
+		Item item;
+		item.polygon = &polygon;
+		item.index = polygon_index;
+		item.owner = owners.size() - 1;
+		item.aabb.position = polygon.points[0].pos;
+		for (uint32_t point_index = 1; point_index < polygon.points.size(); point_index++) {
+			item.aabb.expand_to(polygon.points[point_index].pos);
+		}
+		// Navigation meshes are mostly flat, keep some thickness so segments do not slip through.
+		item.aabb.grow_by(CMP_EPSILON);
+		items.push_back(item);
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	nodes.reserve((items.size() / LEAF_SIZE + 1) * 2);
+	nodes.resize(1);
+	_build_node(0, 0, items.size());
+}
+
+void NavPolygonBVH::_build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to) {
+	AABB aabb = items[p_from].aabb;
+	AABB center_bounds(items[p_from].aabb.get_center(), Vector3());
+	uint32_t navigation_layers = 0;
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const Item &item = items[i];
+		aabb.merge_with(item.aabb);
+		center_bounds.expand_to(item.aabb.get_center());
+		navigation_layers |= owners[item.owner].navigation_layers;
+	}
+
+	nodes[p_node].aabb = aabb;
+	nodes[p_node].navigation_layers = navigation_layers;
+
+	if (p_to - p_from <= LEAF_SIZE) {
+		nodes[p_node].first = p_from;
+		nodes[p_node].count = p_to - p_from;
+		return;
+	}
+
+	// Median split along the longest axis of the polygon centers keeps the tree balanced.
+	const uint32_t middle = (p_from + p_to) / 2;
+	SortArray<Item, ItemComparator> sorter;
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	sorter.nth_element(p_from, p_to, middle, items.ptr());
+
+	const uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(first_child, p_from, middle);
+	_build_node(first_child + 1, middle, p_to);
+}
+
+void NavPolygonBVH::update_navigation_layers() {
+	bool changed = false;
+	for (Owner &owner : owners) {
+		const uint32_t navigation_layers = owner.base->get_navigation_layers();
+		if (owner.navigation_layers != navigation_layers) {
+			owner.navigation_layers = navigation_layers;
+			changed = true;
+		}
+	}
+
+	if (changed && !nodes.is_empty()) {
+		_update_node_navigation_layers(0);
+	}
+}
+
+uint32_t NavPolygonBVH::_update_node_navigation_layers(uint32_t p_node) {
+	Node &node = nodes[p_node];
+	uint32_t navigation_layers = 0;
+	if (node.count > 0) {
+		for (uint32_t i = node.first; i < node.first + node.count; i++) {
+			navigation_layers |= owners[items[i].owner].navigation_layers;
+		}
+	} else {
+		navigation_layers = _update_node_navigation_layers(node.first) | _update_node_navigation_layers(node.first + 1);
+	}
+	node.navigation_layers = navigation_layers;
+	return navigation_layers;
+}
+
+void NavPolygonBVH::get_closest_point(const Vector3 &p_point, QueryResult &r_result) const {
+	_get_closest_point(p_point, 0, false, r_result);
+}
+
+void NavPolygonBVH::get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, QueryResult &r_result) const {
+	_get_closest_point(p_point, p_navigation_layers, true, r_result);
+}
+
+void NavPolygonBVH::_get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_navigation_layers, QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	StackEntry stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, get_aabb_distance_squared(nodes[0].aabb, p_point) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distance_squared > r_result.distance_squared) {
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		if (p_use_navigation_layers && (node.navigation_layers & p_navigation_layers) == 0) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Item &item = items[i];
+				if (p_use_navigation_layers && (owners[item.owner].navigation_layers & p_navigation_layers) == 0) {
+					continue;
+				}
+				if (get_aabb_distance_squared(item.aabb, p_point) > r_result.distance_squared) {
+					continue;
+				}
+
+				const gd::Polygon &polygon = *item.polygon;
+				const uint64_t item_order = _get_item_order(item);
+				for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+					const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_squared = point.distance_squared_to(p_point);
+					if (distance_squared < r_result.distance_squared || (distance_squared == r_result.distance_squared && item_order < r_result.order)) {
+						r_result.polygon = item.polygon;
+						r_result.point = point;
+						r_result.normal = face.get_plane().normal;
+						r_result.distance_squared = distance_squared;
+						r_result.order = item_order;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearest child first so the other one is more likely to be pruned.
+		const real_t first_distance_squared = get_aabb_distance_squared(nodes[node.first].aabb, p_point);
+		const real_t second_distance_squared = get_aabb_distance_squared(nodes[node.first + 1].aabb, p_point);
+		ERR_FAIL_COND(stack_size + 2 > STACK_SIZE);
+		if (first_distance_squared <= second_distance_squared) {
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+			stack[stack_size++] = { node.first, first_distance_squared };
+		} else {
+			stack[stack_size++] = { node.first, first_distance_squared };
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+		}
+	}
+}
+
+void NavPolygonBVH::intersect_segment(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	uint32_t stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (get_aabb_distance_squared(node.aabb, p_from) > r_result.distance_squared || !node.aabb.intersects_segment(p_from, p_to)) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Item &item = items[i];
+				if (!item.aabb.intersects_segment(p_from, p_to)) {
+					continue;
+				}
+
+				const gd::Polygon &polygon = *item.polygon;
+				const uint64_t item_order = _get_item_order(item);
+				for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+					const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+					Vector3 intersection;
+					if (!face.intersects_segment(p_from, p_to, &intersection)) {
+						continue;
+					}
+					const real_t distance_squared = intersection.distance_squared_to(p_from);
+					if (distance_squared < r_result.distance_squared || (distance_squared == r_result.distance_squared && item_order < r_result.order)) {
+						r_result.polygon = item.polygon;
+						r_result.point = intersection;
+						r_result.normal = face.get_plane().normal;
+						r_result.distance_squared = distance_squared;
+						r_result.order = item_order;
+					}
+				}
+			}
+			continue;
+		}
+
+		ERR_FAIL_COND(stack_size + 2 > STACK_SIZE);
+		stack[stack_size++] = node.first + 1;
+		stack[stack_size++] = node.first;
+	}
+}
+
+void NavPolygonBVH::get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) const {
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	// The distance to the segment bounds is a lower bound of the distance to the segment.
+	AABB segment_aabb(p_from, Vector3());
+	segment_aabb.expand_to(p_to);
+
+	StackEntry stack[STACK_SIZE];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, get_aabb_distance_squared(nodes[0].aabb, segment_aabb) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distance_squared > r_result.distance_squared) {
+			continue;
+		}
+
+		const Node &node = nodes[entry.node];
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Item &item = items[i];
+				if (get_aabb_distance_squared(item.aabb, segment_aabb) > r_result.distance_squared) {
+					continue;
+				}
+
+				const gd::Polygon &polygon = *item.polygon;
+				const uint64_t item_order = _get_item_order(item);
+				for (uint32_t point_id = 0; point_id < polygon.points.size(); point_id++) {
+					Vector3 a, b;
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							polygon.points[point_id].pos,
+							polygon.points[(point_id + 1) % polygon.points.size()].pos,
+							a,
+							b);
+
+					const real_t distance_squared = a.distance_squared_to(b);
+					if (distance_squared < r_result.distance_squared || (distance_squared == r_result.distance_squared && item_order < r_result.order)) {
+						r_result.polygon = item.polygon;
+						r_result.point = b;
+						r_result.normal = Vector3();
+						r_result.distance_squared = distance_squared;
+						r_result.order = item_order;
+					}
+				}
+			}
+			continue;
+		}
+
+		const real_t first_distance_squared = get_aabb_distance_squared(nodes[node.first].aabb, segment_aabb);
+		const real_t second_distance_squared = get_aabb_distance_squared(nodes[node.first + 1].aabb, segment_aabb);
+		ERR_FAIL_COND(stack_size + 2 > STACK_SIZE);
+		if (first_distance_squared <= second_distance_squared) {
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+			stack[stack_size++] = { node.first, first_distance_squared };
+		} else {
+			stack[stack_size++] = { node.first, first_distance_squared };
+			stack[stack_size++] = { node.first + 1, second_distance_squared };
+		}
+	}
+}
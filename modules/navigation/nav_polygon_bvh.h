@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+class NavPolygonBVH {
+public:
+	struct QueryResult {
+		gd::Polygon *polygon = nullptr;
+		Vector3 point;
+		Vector3 normal;
+
+		/// Squared distance to the query. Queries only accept results closer than the value it holds on entry.
+		real_t distance_squared = FLT_MAX;
+
+		/// Order of the polygon tree, then index of the polygon in it. Breaks ties between polygons at the same distance
+		/// the same way a linear scan over the polygons of every tree in order would.
+		uint64_t order = UINT64_MAX;
+	};
+
+private:
+	/// Maximum number of polygons stored in a leaf.
+	static const uint32_t LEAF_SIZE = 4;
+	static const uint32_t STACK_SIZE = 64;
+
+	struct Node {
+		AABB aabb;
+
+		/// Union of the navigation layers of every polygon below this node.
+		uint32_t navigation_layers = 0;
+
+		/// First item of a leaf, or first child of a branch (the second child follows it).
+		uint32_t first = 0;
+
+		/// Number of items in a leaf, 0 for a branch.
+		uint32_t count = 0;
+	};
+
+	struct Item {
+		gd::Polygon *polygon = nullptr;
+		AABB aabb;
+
+		/// Index of the polygon in the source array, used to break ties the same way a linear scan would.
+		uint32_t index = 0;
+
+		/// Index of the polygon owner in `owners`.
+		uint32_t owner = 0;
+	};
+
+	struct ItemComparator {
+		int axis = 0;
+
+		_FORCE_INLINE_ bool operator()(const Item &p_a, const Item &p_b) const {
+			return (p_a.aabb.position[axis] * 2.0 + p_a.aabb.size[axis]) < (p_b.aabb.position[axis] * 2.0 + p_b.aabb.size[axis]);
+		}
+	};
+
+	struct Owner {
+		const NavBase *base = nullptr;
+		uint32_t navigation_layers = 0;
+	};
+
+	struct StackEntry {
+		uint32_t node = 0;
+		real_t distance_squared = 0.0;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<Item> items;
+	LocalVector<Owner> owners;
+
+	uint32_t order = 0;
+
+	_FORCE_INLINE_ uint64_t _get_item_order(const Item &p_item) const { return (uint64_t(order) << 32) | p_item.index; }
+
+	void _build_node(uint32_t p_node, uint32_t p_from, uint32_t p_to);
+	uint32_t _update_node_navigation_layers(uint32_t p_node);
+	void _get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, bool p_use_navigation_layers, QueryResult &r_result) const;
+
+public:
+	static _FORCE_INLINE_ real_t get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+		return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+	}
+
+	static _FORCE_INLINE_ real_t get_aabb_distance_squared(const AABB &p_a, const AABB &p_b) {
+		const Vector3 a_end = p_a.position + p_a.size;
+		const Vector3 b_end = p_b.position + p_b.size;
+		real_t distance_squared = 0.0;
+		for (int i = 0; i < 3; i++) {
+			const real_t gap = MAX(MAX(p_a.position[i] - b_end[i], p_b.position[i] - a_end[i]), real_t(0.0));
+			distance_squared += gap * gap;
+		}
+		return distance_squared;
+	}
+
+	/// Builds the tree over the polygons, which must stay in place as long as the tree is used.
+	void build(LocalVector<gd::Polygon> &p_polygons);
+	void clear();
+	bool is_empty() const { return nodes.is_empty(); }
+
+	/// Bounds of all the polygons, only valid when the tree is not empty.
+	const AABB &get_aabb() const { return nodes[0].aabb; }
+	/// Union of the navigation layers of all the polygons.
+	uint32_t get_navigation_layers() const { return nodes.is_empty() ? 0 : nodes[0].navigation_layers; }
+
+	void set_order(uint32_t p_order) { order = p_order; }
+	uint32_t get_order() const { return order; }
+
+	/// Refreshes the navigation layers cached from the polygon owners.
+	void update_navigation_layers();
+
+	/// Finds the closest point on any polygon.
+	void get_closest_point(const Vector3 &p_point, QueryResult &r_result) const;
+	/// Finds the closest point on the polygons with compatible navigation layers.
+	void get_closest_point(const Vector3 &p_point, uint32_t p_navigation_layers, QueryResult &r_result) const;
+	/// Finds the intersection of the segment with a polygon face that is the closest to `p_from`.
+	void intersect_segment(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) const;
+	/// Finds the point on the polygon edges that is the closest to the segment.
+	void get_closest_edge_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, QueryResult &r_result) const;
+};
+
+#endif // NAV_POLYGON_BVH_H
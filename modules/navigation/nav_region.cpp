@@ -61,6 +61,19 @@ void NavRegion::set_enabled(bool p_enabled) {
 	polygons_dirty = true;
 };
 
+void NavRegion::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers != p_navigation_layers) {
+		navigation_layers = p_navigation_layers;
+		navigation_layers_dirty = true;
+	}
+}
+
+bool NavRegion::check_navigation_layers_dirty() {
+	const bool was_dirty = navigation_layers_dirty;
+	navigation_layers_dirty = false;
+	return was_dirty;
+}
+
 void NavRegion::set_use_edge_connections(bool p_enabled) {
 	if (use_edge_connections != p_enabled) {
 		use_edge_connections = p_enabled;
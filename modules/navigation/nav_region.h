@@ -46,6 +46,7 @@ class NavRegion : public NavBase {
 	bool use_edge_connections = true;
 
 	bool polygons_dirty = true;
+	bool navigation_layers_dirty = false;
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
@@ -69,6 +70,9 @@ public:
 		return map;
 	}
 
+	void set_navigation_layers(uint32_t p_navigation_layers) override;
+	bool check_navigation_layers_dirty();
+
 	void set_use_edge_connections(bool p_enabled);
 	bool get_use_edge_connections() const {
 		return use_edge_connections;
@@ -114,6 +114,12 @@ struct Polygon {
 	Vector3 center;
 
 	real_t surface_area = 0.0;
+
+	/// The map cluster that contains this `Polygon`, used by the hierarchical path search.
+	uint32_t cluster = UINT32_MAX;
+
+	/// Index of this `Polygon` in the map polygons, set whenever the map connections change.
+	uint32_t id = UINT32_MAX;
 };
 
 struct NavigationPoly {
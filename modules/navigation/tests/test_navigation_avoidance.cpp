@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  test_navigation_avoidance.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "test_navigation_avoidance.h"
+
+#include "../nav_agent.h"
+#include "../nav_map.h"
+#include "../nav_obstacle.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavigationAvoidance {
+
+Vector3 get_rvo_velocity(NavAgent *p_agent) {
+	if (p_agent->get_use_3d_avoidance()) {
+		const RVO3D::Vector3 &velocity = p_agent->get_rvo_agent_3d()->velocity_;
+		return Vector3(velocity.x(), velocity.y(), velocity.z());
+	}
+	const RVO2D::Vector2 &velocity = p_agent->get_rvo_agent_2d()->velocity_;
+	return Vector3(velocity.x(), 0.0, velocity.y());
+}
+
+void set_rvo_new_velocity(NavAgent *p_agent, const Vector3 &p_velocity) {
+	if (p_agent->get_use_3d_avoidance()) {
+		p_agent->get_rvo_agent_3d()->newVelocity_ = RVO3D::Vector3(p_velocity.x, p_velocity.y, p_velocity.z);
+	} else {
+		p_agent->get_rvo_agent_2d()->newVelocity_ = RVO2D::Vector2(p_velocity.x, p_velocity.z);
+	}
+}
+
+void setup_agent(NavAgent *p_agent, NavMap *p_map, bool p_use_3d_avoidance, const Vector3 &p_position) {
+	p_agent->set_avoidance_enabled(true);
+	p_agent->set_use_3d_avoidance(p_use_3d_avoidance);
+	p_agent->set_position(p_position);
+	p_agent->set_radius(1.0);
+	p_agent->set_neighbor_distance(10.0);
+	p_agent->set_max_neighbors(10);
+	p_agent->set_max_speed(10.0);
+	p_agent->set_map(p_map);
+}
+
+void avoidance_velocity_reuse_test(bool p_use_3d_avoidance) {
+	NavMap map;
+	NavAgent agent_1;
+	NavAgent agent_2;
+	NavAgent agent_3;
+	NavObstacle obstacle;
+
+	// Two agents standing still next to each other keep the same inputs in every step.
+	setup_agent(&agent_1, &map, p_use_3d_avoidance, Vector3(0, 0, 0));
+	setup_agent(&agent_2, &map, p_use_3d_avoidance, Vector3(3, 0, 0));
+	map.sync();
+	map.step(0.1);
+	map.sync();
+	map.step(0.1);
+	CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+
+	// The agent only moves with this velocity if it keeps the last new velocity instead of computing one.
+	const Vector3 kept_velocity = Vector3(0.5, 0, 0.5);
+	set_rvo_new_velocity(&agent_1, kept_velocity);
+
+	SUBCASE("Unchanged inputs should keep the last velocity") {
+		map.sync();
+		map.step(0.1);
+		CHECK_EQ(get_rvo_velocity(&agent_1), kept_velocity);
+		CHECK_EQ(get_rvo_velocity(&agent_2), Vector3());
+	}
+
+	SUBCASE("Changed agent inputs should compute a new velocity") {
+		agent_1.set_velocity(Vector3(0, 0, 1));
+		map.sync();
+		map.step(0.1);
+		CHECK_NE(get_rvo_velocity(&agent_1), kept_velocity);
+		CHECK_GT(get_rvo_velocity(&agent_1).z, 0.0);
+	}
+
+	SUBCASE("Changed agent properties should compute a new velocity") {
+		agent_1.set_radius(0.5);
+		map.sync();
+		map.step(0.1);
+		CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+	}
+
+	SUBCASE("Changed neighbor inputs should compute a new velocity") {
+		agent_2.set_position(Vector3(4, 0, 0));
+		map.sync();
+		map.step(0.1);
+		CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+	}
+
+	SUBCASE("A new neighbor should compute a new velocity") {
+		setup_agent(&agent_3, &map, p_use_3d_avoidance, Vector3(0, 0, 3));
+		map.sync();
+		map.step(0.1);
+		CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+	}
+
+	SUBCASE("A changed time step should compute a new velocity") {
+		map.sync();
+		map.step(0.2);
+		CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+	}
+
+	SUBCASE("Changed obstacles should compute a new velocity") {
+		obstacle.set_map(&map);
+		map.sync();
+		map.step(0.1);
+		CHECK_EQ(get_rvo_velocity(&agent_1), Vector3());
+	}
+
+	obstacle.set_map(nullptr);
+	agent_3.set_map(nullptr);
+	agent_2.set_map(nullptr);
+	agent_1.set_map(nullptr);
+}
+
+} // namespace TestNavigationAvoidance
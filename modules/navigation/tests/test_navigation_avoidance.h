@@ -0,0 +1,54 @@
+/**************************************************************************/
+/*  test_navigation_avoidance.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAVIGATION_AVOIDANCE_H
+#define TEST_NAVIGATION_AVOIDANCE_H
+
+#include "tests/test_macros.h"
+
+namespace TestNavigationAvoidance {
+
+void avoidance_velocity_reuse_test(bool p_use_3d_avoidance);
+
+TEST_SUITE("[Navigation]") {
+	TEST_CASE("[NavMap] Avoidance agents should only compute a new velocity when an input changed") {
+		SUBCASE("2D avoidance") {
+			avoidance_velocity_reuse_test(false);
+		}
+
+		SUBCASE("3D avoidance") {
+			avoidance_velocity_reuse_test(true);
+		}
+	}
+}
+
+} // namespace TestNavigationAvoidance
+
+#endif // TEST_NAVIGATION_AVOIDANCE_H
@@ -36,6 +36,7 @@
 class CPUParticles2D : public Node2D {
 private:
 	GDCLASS(CPUParticles2D, Node2D);
+	friend class TestCPUParticles2DInternalsAccessor;
 
 public:
 	enum DrawOrder {
@@ -176,9 +177,46 @@ private:
 
 	Vector2 gravity = Vector2(0, 980);
 
+	// Particles are processed in chunks of this size, on worker threads when there is more than one.
+	static constexpr int PROCESS_CHUNK_SIZE = 512;
+
+	// Decided for each particle by the restart pass, before the chunks are processed.
+	enum ParticleStep : uint8_t {
+		PARTICLE_STEP_SKIP,
+		PARTICLE_STEP_RESTARTED,
+		PARTICLE_STEP_UPDATE,
+	};
+
+	struct ProcessData {
+		Particle *particles = nullptr;
+		const uint8_t *particle_steps = nullptr;
+		const double *particle_deltas = nullptr;
+		int particle_count = 0;
+		int chunk_size = PROCESS_CHUNK_SIZE;
+		double delta = 0.0;
+		double prev_time = 0.0;
+		double system_phase = 0.0;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		SafeFlag should_be_active;
+	};
+
+	struct DataBufferUpdate {
+		const Particle *particles = nullptr;
+		const int *order = nullptr;
+		float *data = nullptr;
+		int particle_count = 0;
+	};
+
 	void _update_internal();
-	void _particles_process(double p_delta);
+	LocalVector<uint8_t> particle_steps;
+	LocalVector<double> particle_deltas;
+
+	void _particles_process(double p_delta, int p_chunk_size = PROCESS_CHUNK_SIZE);
+	void _particles_restart(ProcessData *p_data);
+	void _particles_process_chunk(uint32_t p_chunk, ProcessData *p_data);
 	void _update_particle_data_buffer();
+	void _update_particle_data_chunk(uint32_t p_chunk, DataBufferUpdate *p_update);
 
 	Mutex update_mutex;
 
@@ -243,15 +243,19 @@ void NavigationRegion2D::bake_navigation_polygon(bool p_on_thread) {
 	Ref<NavigationMeshSourceGeometryData2D> source_geometry_data;
 	source_geometry_data.instantiate();
 
-	NavigationServer2D::get_singleton()->parse_source_geometry_data(navigation_polygon, source_geometry_data, this);
-
 	if (p_on_thread) {
-		NavigationServer2D::get_singleton()->bake_from_source_geometry_data_async(navigation_polygon, source_geometry_data, callable_mp(this, &NavigationRegion2D::_bake_finished).bind(navigation_polygon));
+		// The parsed geometry is only complete once the callback runs, the bake starts from there.
+		NavigationServer2D::get_singleton()->parse_source_geometry_data_async(navigation_polygon, source_geometry_data, this, callable_mp(this, &NavigationRegion2D::_parse_finished).bind(navigation_polygon, source_geometry_data));
 	} else {
+		NavigationServer2D::get_singleton()->parse_source_geometry_data(navigation_polygon, source_geometry_data, this);
 		NavigationServer2D::get_singleton()->bake_from_source_geometry_data(navigation_polygon, source_geometry_data, callable_mp(this, &NavigationRegion2D::_bake_finished).bind(navigation_polygon));
 	}
 }
 
+void NavigationRegion2D::_parse_finished(Ref<NavigationPolygon> p_navigation_polygon, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data) {
+	NavigationServer2D::get_singleton()->bake_from_source_geometry_data_async(p_navigation_polygon, p_source_geometry_data, callable_mp(this, &NavigationRegion2D::_bake_finished).bind(p_navigation_polygon));
+}
+
 void NavigationRegion2D::_bake_finished(Ref<NavigationPolygon> p_navigation_polygon) {
 	if (!Thread::is_main_thread()) {
 		callable_mp(this, &NavigationRegion2D::_bake_finished).call_deferred(p_navigation_polygon);
@@ -33,6 +33,8 @@
 
 #include "scene/resources/2d/navigation_polygon.h"
 
+class NavigationMeshSourceGeometryData2D;
+
 class NavigationRegion2D : public Node2D {
 	GDCLASS(NavigationRegion2D, Node2D);
 
@@ -110,6 +112,7 @@ public:
 	PackedStringArray get_configuration_warnings() const override;
 
 	void bake_navigation_polygon(bool p_on_thread);
+	void _parse_finished(Ref<NavigationPolygon> p_navigation_polygon, Ref<NavigationMeshSourceGeometryData2D> p_source_geometry_data);
 	void _bake_finished(Ref<NavigationPolygon> p_navigation_polygon);
 	bool is_baking() const;
 
@@ -30,6 +30,7 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -654,13 +655,10 @@ void CPUParticles3D::_update_internal() {
 	}
 }
 
-void CPUParticles3D::_particles_process(double p_delta) {
+void CPUParticles3D::_particles_process(double p_delta, int p_chunk_size) {
 	p_delta *= speed_scale;
 
 	int pcount = particles.size();
-	Particle *w = particles.ptrw();
-
-	Particle *parray = w;
 
 	double prev_time = time;
 	time += p_delta;
@@ -673,49 +671,83 @@ void CPUParticles3D::_particles_process(double p_delta) {
 		}
 	}
 
-	Transform3D emission_xform;
-	Basis velocity_xform;
+	ProcessData data;
+	data.particles = particles.ptrw();
+	data.particle_count = pcount;
+	data.delta = p_delta;
+	data.prev_time = prev_time;
+	data.system_phase = time / lifetime;
 	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform.basis;
+		data.emission_xform = get_global_transform();
+		data.velocity_xform = data.emission_xform.basis;
 	}
 
-	double system_phase = time / lifetime;
+	// Spawning draws from the global random state in particle order, so it runs on the calling thread
+	// and emits the same particles no matter how the rest is split into chunks.
+	particle_steps.resize(pcount);
+	particle_deltas.resize(pcount);
+	data.particle_steps = particle_steps.ptr();
+	data.particle_deltas = particle_deltas.ptr();
+	data.chunk_size = p_chunk_size;
+	_particles_restart(&data);
+
+	int chunk_count = (pcount + p_chunk_size - 1) / p_chunk_size;
+	if (chunk_count > 1) {
+		// Gradients sort their points lazily on first access, make sure that doesn't happen from several threads.
+		if (color_ramp.is_valid() && color_ramp->get_point_count() > 0) {
+			color_ramp->get_offset(0);
+		}
 
-	bool should_be_active = false;
-	for (int i = 0; i < pcount; i++) {
-		Particle &p = parray[i];
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_chunk, &data, chunk_count, -1, true, SNAME("CPUParticles3DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (chunk_count == 1) {
+		_particles_process_chunk(0, &data);
+	}
+
+	if (!Math::is_equal_approx(time, 0.0) && active && !data.should_be_active.is_set()) {
+		active = false;
+		emit_signal(SceneStringName(finished));
+	}
+}
+
+void CPUParticles3D::_particles_restart(ProcessData *p_data) {
+	uint8_t *steps = particle_steps.ptr();
+	double *deltas = particle_deltas.ptr();
+
+	for (int i = 0; i < p_data->particle_count; i++) {
+		steps[i] = PARTICLE_STEP_SKIP;
+		Particle &p = p_data->particles[i];
 
 		if (!emitting && !p.active) {
 			continue;
 		}
 
-		double local_delta = p_delta;
+		double local_delta = p_data->delta;
 
 		// The phase is a ratio between 0 (birth) and 1 (end of life) for each particle.
 		// While we use time in tests later on, for randomness we use the phase as done in the
 		// original shader code, and we later multiply by lifetime to get the time.
-		double restart_phase = double(i) / double(pcount);
+		double restart_phase = double(i) / double(p_data->particle_count);
 
 		if (randomness_ratio > 0.0) {
 			uint32_t seed = cycle;
-			if (restart_phase >= system_phase) {
+			if (restart_phase >= p_data->system_phase) {
 				seed -= uint32_t(1);
 			}
-			seed *= uint32_t(pcount);
+			seed *= uint32_t(p_data->particle_count);
 			seed += uint32_t(i);
 			double random = double(idhash(seed) % uint32_t(65536)) / 65536.0;
-			restart_phase += randomness_ratio * random * 1.0 / double(pcount);
+			restart_phase += randomness_ratio * random * 1.0 / double(p_data->particle_count);
 		}
 
 		restart_phase *= (1.0 - explosiveness_ratio);
 		double restart_time = restart_phase * lifetime;
 		bool restart = false;
 
-		if (time > prev_time) {
-			// restart_time >= prev_time is used so particles emit in the first frame they are processed
+		if (time > p_data->prev_time) {
+			// restart_time >= p_data->prev_time is used so particles emit in the first frame they are processed
 
-			if (restart_time >= prev_time && restart_time < time) {
+			if (restart_time >= p_data->prev_time && restart_time < time) {
 				restart = true;
 				if (fractional_delta) {
 					local_delta = time - restart_time;
@@ -723,7 +755,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			}
 
 		} else if (local_delta > 0.0) {
-			if (restart_time >= prev_time) {
+			if (restart_time >= p_data->prev_time) {
 				restart = true;
 				if (fractional_delta) {
 					local_delta = lifetime - restart_time + time;
@@ -749,6 +781,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				continue;
 			}
 			p.active = true;
+			steps[i] = PARTICLE_STEP_RESTARTED;
 
 			/*real_t tex_linear_velocity = 0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
@@ -898,8 +931,8 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			}
 
 			if (!local_coords) {
-				p.velocity = velocity_xform.xform(p.velocity);
-				p.transform = emission_xform * p.transform;
+				p.velocity = p_data->velocity_xform.xform(p.velocity);
+				p.transform = p_data->emission_xform * p.transform;
 			}
 
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
@@ -907,6 +940,31 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				p.transform.origin.z = 0.0;
 			}
 
+		} else {
+			steps[i] = PARTICLE_STEP_UPDATE;
+		}
+
+		deltas[i] = local_delta;
+	}
+}
+
+void CPUParticles3D::_particles_process_chunk(uint32_t p_chunk, ProcessData *p_data) {
+	int from = p_chunk * p_data->chunk_size;
+	int to = MIN(from + p_data->chunk_size, p_data->particle_count);
+
+	bool should_be_active = false;
+
+	for (int i = from; i < to; i++) {
+		if (p_data->particle_steps[i] == PARTICLE_STEP_SKIP) {
+			continue;
+		}
+
+		Particle &p = p_data->particles[i];
+		double local_delta = p_data->particle_deltas[i];
+		float tv = 0.0;
+
+		if (p_data->particle_steps[i] == PARTICLE_STEP_RESTARTED) {
+			// Spawned by _particles_restart(), only the common part below applies.
 		} else if (!p.active) {
 			continue;
 		} else if (p.time > p.lifetime) {
@@ -978,7 +1036,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 			//apply linear acceleration
 			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
+			Vector3 org = p_data->emission_xform.origin;
 			Vector3 diff = position - org;
 			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
 			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
@@ -1153,9 +1211,9 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 		should_be_active = true;
 	}
-	if (!Math::is_equal_approx(time, 0.0) && active && !should_be_active) {
-		active = false;
-		emit_signal(SceneStringName(finished));
+
+	if (should_be_active) {
+		p_data->should_be_active.set();
 	}
 }
 
@@ -1169,7 +1227,6 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1204,7 +1261,32 @@ void CPUParticles3D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
+	DataBufferUpdate update;
+	update.particles = r;
+	update.order = order;
+	update.data = w;
+	update.particle_count = pc;
+
+	int chunk_count = (pc + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_update_particle_data_chunk, &update, chunk_count, -1, true, SNAME("CPUParticles3DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (chunk_count == 1) {
+		_update_particle_data_chunk(0, &update);
+	}
+
+	can_update.set();
+}
+
+void CPUParticles3D::_update_particle_data_chunk(uint32_t p_chunk, DataBufferUpdate *p_update) {
+	int from = p_chunk * PROCESS_CHUNK_SIZE;
+	int to = MIN(from + PROCESS_CHUNK_SIZE, p_update->particle_count);
+
+	const Particle *r = p_update->particles;
+	const int *order = p_update->order;
+	float *ptr = p_update->data + from * 20;
+
+	for (int i = from; i < to; i++) {
 		int idx = order ? order[i] : i;
 
 		Transform3D t = r[idx].transform;
@@ -1244,8 +1326,6 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 		ptr += 20;
 	}
-
-	can_update.set();
 }
 
 void CPUParticles3D::_set_redraw(bool p_redraw) {
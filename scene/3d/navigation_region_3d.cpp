@@ -247,15 +247,19 @@ void NavigationRegion3D::bake_navigation_mesh(bool p_on_thread) {
 	Ref<NavigationMeshSourceGeometryData3D> source_geometry_data;
 	source_geometry_data.instantiate();
 
-	NavigationServer3D::get_singleton()->parse_source_geometry_data(navigation_mesh, source_geometry_data, this);
-
 	if (p_on_thread) {
-		NavigationServer3D::get_singleton()->bake_from_source_geometry_data_async(navigation_mesh, source_geometry_data, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
+		// The parsed geometry is only complete once the callback runs, the bake starts from there.
+		NavigationServer3D::get_singleton()->parse_source_geometry_data_async(navigation_mesh, source_geometry_data, this, callable_mp(this, &NavigationRegion3D::_parse_finished).bind(navigation_mesh, source_geometry_data));
 	} else {
+		NavigationServer3D::get_singleton()->parse_source_geometry_data(navigation_mesh, source_geometry_data, this);
 		NavigationServer3D::get_singleton()->bake_from_source_geometry_data(navigation_mesh, source_geometry_data, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(navigation_mesh));
 	}
 }
 
+void NavigationRegion3D::_parse_finished(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data) {
+	NavigationServer3D::get_singleton()->bake_from_source_geometry_data_async(p_navigation_mesh, p_source_geometry_data, callable_mp(this, &NavigationRegion3D::_bake_finished).bind(p_navigation_mesh));
+}
+
 void NavigationRegion3D::_bake_finished(Ref<NavigationMesh> p_navigation_mesh) {
 	if (!Thread::is_main_thread()) {
 		callable_mp(this, &NavigationRegion3D::_bake_finished).call_deferred(p_navigation_mesh);
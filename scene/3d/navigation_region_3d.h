@@ -34,6 +34,8 @@
 #include "scene/3d/node_3d.h"
 #include "scene/resources/navigation_mesh.h"
 
+class NavigationMeshSourceGeometryData3D;
+
 class NavigationRegion3D : public Node3D {
 	GDCLASS(NavigationRegion3D, Node3D);
 
@@ -105,6 +107,7 @@ public:
 	/// Bakes the navigation mesh; once done, automatically
 	/// sets the new navigation mesh and emits a signal
 	void bake_navigation_mesh(bool p_on_thread);
+	void _parse_finished(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data);
 	void _bake_finished(Ref<NavigationMesh> p_navigation_mesh);
 	bool is_baking() const;
 
@@ -0,0 +1,336 @@
+/**************************************************************************/
+/*  static_batch_3d.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "static_batch_3d.h"
+
+#include "core/config/engine.h"
+#include "scene/3d/lightmap_gi.h"
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/importer_mesh.h"
+#include "scene/resources/3d/skin.h"
+#include "scene/resources/surface_tool.h"
+
+bool StaticBatch3D::_can_batch(MeshInstance3D *p_mesh_instance, const HashSet<ObjectID> &p_lightmapped_instances) const {
+	Ref<Mesh> mesh = p_mesh_instance->get_mesh();
+	if (mesh.is_null() || mesh->get_surface_count() == 0 || mesh->get_blend_shape_count() > 0) {
+		return false;
+	}
+
+	if (p_mesh_instance->get_skin().is_valid() || p_mesh_instance->get_material_overlay().is_valid()) {
+		return false;
+	}
+
+	// These change per instance at render time, so they can't be baked into a merged mesh.
+	if (p_mesh_instance->get_transparency() > 0.0 || p_mesh_instance->get_visibility_range_begin() > 0.0 || p_mesh_instance->get_visibility_range_end() > 0.0) {
+		return false;
+	}
+
+	// A custom AABB would not match the merged geometry.
+	if (p_mesh_instance->get_custom_aabb() != AABB()) {
+		return false;
+	}
+
+	// The renderer flips the face culling of mirrored instances, merged geometry is culled with the winding of the batch instead.
+	const real_t determinant = p_mesh_instance->get_global_basis().determinant();
+	if (determinant == 0.0 || (determinant < 0.0) != (get_global_basis().determinant() < 0.0)) {
+		return false;
+	}
+
+	// Baked lightmaps are assigned to each instance with its own UV scale and slice.
+	if (p_lightmapped_instances.has(p_mesh_instance->get_instance_id())) {
+		return false;
+	}
+
+	List<PropertyInfo> instance_parameters;
+	RS::get_singleton()->instance_geometry_get_shader_parameter_list(p_mesh_instance->get_instance(), &instance_parameters);
+	for (const PropertyInfo &E : instance_parameters) {
+		if (p_mesh_instance->get_instance_shader_parameter(E.name) != RS::get_singleton()->instance_geometry_get_shader_parameter_default_value(p_mesh_instance->get_instance(), E.name)) {
+			return false;
+		}
+	}
+
+	for (int i = 0; i < mesh->get_surface_count(); i++) {
+		if (mesh->surface_get_format(i) & (RS::ARRAY_FORMAT_BONES | RS::ARRAY_FLAG_USE_2D_VERTICES)) {
+			return false;
+		}
+	}
+
+	return _can_hide_children(p_mesh_instance, p_lightmapped_instances);
+}
+
+bool StaticBatch3D::_can_hide_children(Node *p_node, const HashSet<ObjectID> &p_lightmapped_instances) const {
+	// Batched instances are hidden, which also hides their whole subtree. Only allow it if all visible
+	// visual instances below are batched too.
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		Node *child = p_node->get_child(i);
+		Node3D *node_3d = Object::cast_to<Node3D>(child);
+		if (node_3d && !node_3d->is_visible_in_tree()) {
+			continue;
+		}
+
+		VisualInstance3D *visual_instance = Object::cast_to<VisualInstance3D>(child);
+		if (visual_instance) {
+			MeshInstance3D *child_mesh_instance = Object::cast_to<MeshInstance3D>(visual_instance);
+			if (!child_mesh_instance || !_can_batch(child_mesh_instance, p_lightmapped_instances)) {
+				return false;
+			}
+		} else if (!_can_hide_children(child, p_lightmapped_instances)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void StaticBatch3D::_get_lightmapped_instances(HashSet<ObjectID> &r_instances) const {
+	TypedArray<Node> lightmap_gis = get_tree()->get_root()->find_children("*", "LightmapGI", true, false);
+	for (int i = 0; i < lightmap_gis.size(); i++) {
+		LightmapGI *lightmap_gi = Object::cast_to<LightmapGI>(lightmap_gis[i]);
+		Ref<LightmapGIData> light_data = lightmap_gi->get_light_data();
+		if (light_data.is_null()) {
+			continue;
+		}
+
+		for (int j = 0; j < light_data->get_user_count(); j++) {
+			Node *user = lightmap_gi->get_node_or_null(light_data->get_user_path(j));
+			if (user) {
+				r_instances.insert(user->get_instance_id());
+			}
+		}
+	}
+}
+
+void StaticBatch3D::_collect_mesh_instances(Node *p_node, const HashSet<ObjectID> &p_lightmapped_instances, LocalVector<MeshInstance3D *> &r_mesh_instances) const {
+	if (Object::cast_to<StaticBatch3D>(p_node)) {
+		// Nested batches handle their own children.
+		return;
+	}
+
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d && !node_3d->is_visible_in_tree()) {
+		return;
+	}
+
+	MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(p_node);
+	if (mesh_instance && _can_batch(mesh_instance, p_lightmapped_instances)) {
+		r_mesh_instances.push_back(mesh_instance);
+	}
+
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_collect_mesh_instances(p_node->get_child(i), p_lightmapped_instances, r_mesh_instances);
+	}
+}
+
+void StaticBatch3D::_notification(int p_what) {
+	switch (p_what) {
+		case NOTIFICATION_READY: {
+			if (batch_on_ready && !Engine::get_singleton()->is_editor_hint()) {
+				batch();
+			}
+		} break;
+	}
+}
+
+void StaticBatch3D::set_cell_size(real_t p_cell_size) {
+	ERR_FAIL_COND(p_cell_size <= 0.0);
+	cell_size = p_cell_size;
+}
+
+real_t StaticBatch3D::get_cell_size() const {
+	return cell_size;
+}
+
+void StaticBatch3D::set_generate_lods(bool p_enable) {
+	generate_lods = p_enable;
+}
+
+bool StaticBatch3D::is_generating_lods() const {
+	return generate_lods;
+}
+
+void StaticBatch3D::set_batch_on_ready(bool p_enable) {
+	batch_on_ready = p_enable;
+}
+
+bool StaticBatch3D::is_batching_on_ready() const {
+	return batch_on_ready;
+}
+
+void StaticBatch3D::batch() {
+	ERR_FAIL_COND_MSG(!is_inside_tree(), "StaticBatch3D must be inside the scene tree to batch its children.");
+
+	unbatch();
+
+	HashSet<ObjectID> lightmapped_instances;
+	_get_lightmapped_instances(lightmapped_instances);
+
+	LocalVector<MeshInstance3D *> mesh_instances;
+	for (int i = 0; i < get_child_count(); i++) {
+		_collect_mesh_instances(get_child(i), lightmapped_instances, mesh_instances);
+	}
+
+	if (mesh_instances.is_empty()) {
+		return;
+	}
+
+	// Group surfaces by spatial cell, so each batch keeps a tight AABB and can still be culled.
+	const Transform3D to_local = get_global_transform().affine_inverse();
+	HashMap<InstanceKey, HashMap<SurfaceKey, LocalVector<BatchSurface>, SurfaceKey>, InstanceKey> groups;
+
+	for (MeshInstance3D *mesh_instance : mesh_instances) {
+		Ref<Mesh> mesh = mesh_instance->get_mesh();
+		Transform3D xform = to_local * mesh_instance->get_global_transform();
+		Vector3 center = xform.xform(mesh->get_aabb()).get_center();
+
+		InstanceKey instance_key;
+		instance_key.cell = Vector3i((center / cell_size).floor());
+		instance_key.layers = mesh_instance->get_layer_mask();
+		instance_key.cast_shadow = mesh_instance->get_cast_shadows_setting();
+		instance_key.gi_mode = mesh_instance->get_gi_mode();
+		instance_key.extra_cull_margin = mesh_instance->get_extra_cull_margin();
+		instance_key.lod_bias = mesh_instance->get_lod_bias();
+		instance_key.ignore_occlusion_culling = mesh_instance->is_ignoring_occlusion_culling();
+
+		HashMap<SurfaceKey, LocalVector<BatchSurface>, SurfaceKey> &surfaces = groups[instance_key];
+		for (int i = 0; i < mesh->get_surface_count(); i++) {
+			SurfaceKey surface_key;
+			surface_key.material = mesh_instance->get_active_material(i);
+			surface_key.primitive = mesh->surface_get_primitive_type(i);
+			// Custom channels of different formats can't share a surface, the index and compression flags don't matter once merged.
+			surface_key.format = mesh->surface_get_format(i) & ((1ULL << RS::ARRAY_COMPRESS_FLAGS_BASE) - 1) & ~(uint64_t)RS::ARRAY_FORMAT_INDEX;
+
+			BatchSurface batch_surface;
+			batch_surface.mesh = mesh;
+			batch_surface.surface = i;
+			batch_surface.xform = xform;
+			surfaces[surface_key].push_back(batch_surface);
+		}
+
+		mesh_instance->set_visible(false);
+		batched_instances.push_back(mesh_instance->get_instance_id());
+	}
+
+	for (const KeyValue<InstanceKey, HashMap<SurfaceKey, LocalVector<BatchSurface>, SurfaceKey>> &E : groups) {
+		Ref<ImporterMesh> importer_mesh;
+		importer_mesh.instantiate();
+
+		for (const KeyValue<SurfaceKey, LocalVector<BatchSurface>> &F : E.value) {
+			Ref<SurfaceTool> surface_tool;
+			surface_tool.instantiate();
+			for (const BatchSurface &batch_surface : F.value) {
+				// append_from() transforms normals with the basis, which skews them under non-uniform scale.
+				// Transform them with the normal matrix instead, like the renderer does for the source instance.
+				const uint32_t vertex_from = surface_tool->get_vertex_array().size();
+				surface_tool->append_from(batch_surface.mesh, batch_surface.surface, Transform3D());
+
+				const Basis normal_basis = batch_surface.xform.basis.inverse().transposed();
+				LocalVector<SurfaceTool::Vertex> &vertices = surface_tool->get_vertex_array();
+				for (uint32_t i = vertex_from; i < vertices.size(); i++) {
+					SurfaceTool::Vertex &vertex = vertices[i];
+					vertex.vertex = batch_surface.xform.xform(vertex.vertex);
+					vertex.normal = normal_basis.xform(vertex.normal).normalized();
+					vertex.tangent = normal_basis.xform(vertex.tangent).normalized();
+					vertex.binormal = normal_basis.xform(vertex.binormal).normalized();
+				}
+			}
+
+			// The custom channel formats can't be told apart from the arrays alone.
+			uint64_t flags = 0;
+			for (int i = 0; i < RS::ARRAY_CUSTOM_COUNT; i++) {
+				flags |= (uint64_t(RS::ARRAY_FORMAT_CUSTOM_MASK) << (RS::ARRAY_FORMAT_CUSTOM_BASE + i * RS::ARRAY_FORMAT_CUSTOM_BITS)) & F.key.format;
+			}
+			importer_mesh->add_surface(F.key.primitive, surface_tool->commit_to_arrays(), TypedArray<Array>(), Dictionary(), F.key.material, String(), flags);
+		}
+
+		if (generate_lods) {
+			// Same angles as the scene importer defaults.
+			importer_mesh->generate_lods(60.0, 25.0, Array());
+		}
+
+		MeshInstance3D *batch_instance = memnew(MeshInstance3D);
+		batch_instance->set_mesh(importer_mesh->get_mesh());
+		batch_instance->set_layer_mask(E.key.layers);
+		batch_instance->set_cast_shadows_setting(E.key.cast_shadow);
+		batch_instance->set_gi_mode(E.key.gi_mode);
+		batch_instance->set_extra_cull_margin(E.key.extra_cull_margin);
+		batch_instance->set_lod_bias(E.key.lod_bias);
+		batch_instance->set_ignore_occlusion_culling(E.key.ignore_occlusion_culling);
+		add_child(batch_instance, false, INTERNAL_MODE_BACK);
+		batches.push_back(batch_instance);
+	}
+}
+
+void StaticBatch3D::unbatch() {
+	for (MeshInstance3D *batch_instance : batches) {
+		remove_child(batch_instance);
+		memdelete(batch_instance);
+	}
+	batches.clear();
+
+	for (const ObjectID &id : batched_instances) {
+		MeshInstance3D *mesh_instance = Object::cast_to<MeshInstance3D>(ObjectDB::get_instance(id));
+		if (mesh_instance) {
+			mesh_instance->set_visible(true);
+		}
+	}
+	batched_instances.clear();
+}
+
+bool StaticBatch3D::is_batched() const {
+	return !batches.is_empty();
+}
+
+int StaticBatch3D::get_batch_count() const {
+	return batches.size();
+}
+
+int StaticBatch3D::get_batched_instance_count() const {
+	return batched_instances.size();
+}
+
+void StaticBatch3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_cell_size", "cell_size"), &StaticBatch3D::set_cell_size);
+	ClassDB::bind_method(D_METHOD("get_cell_size"), &StaticBatch3D::get_cell_size);
+	ClassDB::bind_method(D_METHOD("set_generate_lods", "enable"), &StaticBatch3D::set_generate_lods);
+	ClassDB::bind_method(D_METHOD("is_generating_lods"), &StaticBatch3D::is_generating_lods);
+	ClassDB::bind_method(D_METHOD("set_batch_on_ready", "enable"), &StaticBatch3D::set_batch_on_ready);
+	ClassDB::bind_method(D_METHOD("is_batching_on_ready"), &StaticBatch3D::is_batching_on_ready);
+
+	ClassDB::bind_method(D_METHOD("batch"), &StaticBatch3D::batch);
+	ClassDB::bind_method(D_METHOD("unbatch"), &StaticBatch3D::unbatch);
+	ClassDB::bind_method(D_METHOD("is_batched"), &StaticBatch3D::is_batched);
+	ClassDB::bind_method(D_METHOD("get_batch_count"), &StaticBatch3D::get_batch_count);
+	ClassDB::bind_method(D_METHOD("get_batched_instance_count"), &StaticBatch3D::get_batched_instance_count);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "cell_size", PROPERTY_HINT_RANGE, "0.1,1024,0.1,or_greater,suffix:m"), "set_cell_size", "get_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "generate_lods"), "set_generate_lods", "is_generating_lods");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "batch_on_ready"), "set_batch_on_ready", "is_batching_on_ready");
+}
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  static_batch_3d.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef STATIC_BATCH_3D_H
+#define STATIC_BATCH_3D_H
+
+#include "core/templates/hash_set.h"
+#include "scene/3d/visual_instance_3d.h"
+
+class MeshInstance3D;
+
+class StaticBatch3D : public Node3D {
+	GDCLASS(StaticBatch3D, Node3D);
+
+	// Mesh instances in the same cell with the same instance settings are merged into one batch.
+	struct InstanceKey {
+		Vector3i cell;
+		uint32_t layers = 0;
+		GeometryInstance3D::ShadowCastingSetting cast_shadow = GeometryInstance3D::SHADOW_CASTING_SETTING_ON;
+		GeometryInstance3D::GIMode gi_mode = GeometryInstance3D::GI_MODE_STATIC;
+		float extra_cull_margin = 0.0;
+		float lod_bias = 1.0;
+		bool ignore_occlusion_culling = false;
+
+		bool operator==(const InstanceKey &p_key) const {
+			return cell == p_key.cell && layers == p_key.layers && cast_shadow == p_key.cast_shadow && gi_mode == p_key.gi_mode && extra_cull_margin == p_key.extra_cull_margin && lod_bias == p_key.lod_bias && ignore_occlusion_culling == p_key.ignore_occlusion_culling;
+		}
+
+		static uint32_t hash(const InstanceKey &p_key) {
+			uint32_t h = hash_murmur3_one_32(p_key.cell.x);
+			h = hash_murmur3_one_32(p_key.cell.y, h);
+			h = hash_murmur3_one_32(p_key.cell.z, h);
+			h = hash_murmur3_one_32(p_key.layers, h);
+			h = hash_murmur3_one_32(p_key.cast_shadow, h);
+			h = hash_murmur3_one_32(p_key.gi_mode, h);
+			h = hash_murmur3_one_float(p_key.extra_cull_margin, h);
+			h = hash_murmur3_one_float(p_key.lod_bias, h);
+			h = hash_murmur3_one_32(p_key.ignore_occlusion_culling, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	// Surfaces of a batch that share a material and vertex format are merged into one surface.
+	struct SurfaceKey {
+		Ref<Material> material;
+		Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
+		uint64_t format = 0;
+
+		bool operator==(const SurfaceKey &p_key) const {
+			return material == p_key.material && primitive == p_key.primitive && format == p_key.format;
+		}
+
+		static uint32_t hash(const SurfaceKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.material.is_valid() ? p_key.material->get_rid().get_id() : 0);
+			h = hash_murmur3_one_32(p_key.primitive, h);
+			h = hash_murmur3_one_64(p_key.format, h);
+			return hash_fmix32(h);
+		}
+	};
+
+	struct BatchSurface {
+		Ref<Mesh> mesh;
+		int surface = 0;
+		Transform3D xform;
+	};
+
+	real_t cell_size = 32.0;
+	bool generate_lods = false;
+	bool batch_on_ready = true;
+
+	LocalVector<MeshInstance3D *> batches;
+	LocalVector<ObjectID> batched_instances;
+
+	bool _can_batch(MeshInstance3D *p_mesh_instance, const HashSet<ObjectID> &p_lightmapped_instances) const;
+	bool _can_hide_children(Node *p_node, const HashSet<ObjectID> &p_lightmapped_instances) const;
+	void _get_lightmapped_instances(HashSet<ObjectID> &r_instances) const;
+	void _collect_mesh_instances(Node *p_node, const HashSet<ObjectID> &p_lightmapped_instances, LocalVector<MeshInstance3D *> &r_mesh_instances) const;
+
+protected:
+	void _notification(int p_what);
+	static void _bind_methods();
+
+public:
+	void set_cell_size(real_t p_cell_size);
+	real_t get_cell_size() const;
+
+	void set_generate_lods(bool p_enable);
+	bool is_generating_lods() const;
+
+	void set_batch_on_ready(bool p_enable);
+	bool is_batching_on_ready() const;
+
+	void batch();
+	void unbatch();
+	bool is_batched() const;
+
+	int get_batch_count() const;
+	int get_batched_instance_count() const;
+};
+
+#endif // STATIC_BATCH_3D_H
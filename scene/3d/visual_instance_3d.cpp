@@ -54,10 +54,12 @@ void VisualInstance3D::_notification(int p_what) {
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform3D gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			get_tree()->_set_instance_transform(instance, gt);
 		} break;
 
 		case NOTIFICATION_EXIT_WORLD: {
+			// Don't let a transform queued during this flush reach the instance after it left the world or was freed.
+			get_tree()->_cancel_instance_transform(instance);
 			RenderingServer::get_singleton()->instance_set_scenario(instance, RID());
 			RenderingServer::get_singleton()->instance_attach_skeleton(instance, RID());
 		} break;
@@ -58,6 +58,7 @@
 #include "servers/display_server.h"
 #include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
+#include "servers/rendering_server.h"
 #ifndef _3D_DISABLED
 #include "scene/resources/3d/world_3d.h"
 #include "servers/physics_server_3d.h"
@@ -178,14 +179,69 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+	bool was_flushing = flushing_transform_notifications;
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
 		n = nx;
+
+		// Scripts and extensions may call the RenderingServer themselves. Send what was queued so far
+		// before them and don't queue during their notification, so their calls are never overwritten.
+		bool has_user_code = node->get_script_instance() || node->_get_extension();
+		if (has_user_code) {
+			_send_instance_transform_batch();
+		}
+		flushing_transform_notifications = !has_user_code;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	flushing_transform_notifications = was_flushing;
+
+	if (!was_flushing) {
+		_send_instance_transform_batch();
+	}
+}
+
+void SceneTree::_set_instance_transform(RID p_instance, const Transform3D &p_transform) {
+	_THREAD_SAFE_METHOD_
+
+	if (flushing_transform_notifications) {
+		instance_transform_batch[p_instance] = p_transform;
+	} else {
+		RS::get_singleton()->instance_set_transform(p_instance, p_transform);
+	}
+}
+
+void SceneTree::_cancel_instance_transform(RID p_instance) {
+	_THREAD_SAFE_METHOD_
+
+	instance_transform_batch.erase(p_instance);
+}
+
+void SceneTree::_send_instance_transform_batch() {
+	if (instance_transform_batch.is_empty()) {
+		return;
+	}
+
+	Vector<RID> instances;
+	instances.resize(instance_transform_batch.size());
+	Vector<Transform3D> transforms;
+	transforms.resize(instance_transform_batch.size());
+
+	RID *instances_ptr = instances.ptrw();
+	Transform3D *transforms_ptr = transforms.ptrw();
+	int i = 0;
+	for (const KeyValue<RID, Transform3D> &E : instance_transform_batch) {
+		instances_ptr[i] = E.key;
+		transforms_ptr[i] = E.value;
+		i++;
+	}
+	instance_transform_batch.clear();
+
+	RS::get_singleton()->instances_set_transforms(instances, transforms);
 }
 
 void SceneTree::_flush_ugc() {
@@ -231,9 +231,18 @@ private:
 	friend class CanvasItem;
 	friend class Node3D;
 	friend class Viewport;
+	friend class VisualInstance3D;
 
 	SelfList<Node>::List xform_change_list;
 
+	// Instance transforms set while flushing transform notifications are sent to the RenderingServer in one call.
+	bool flushing_transform_notifications = false;
+	HashMap<RID, Transform3D> instance_transform_batch;
+
+	void _set_instance_transform(RID p_instance, const Transform3D &p_transform);
+	void _cancel_instance_transform(RID p_instance);
+	void _send_instance_transform_batch();
+
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
 #endif
@@ -32,6 +32,7 @@
 #define NAVIGATION_SERVER_3D_H
 
 #include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 
 #include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
@@ -110,6 +111,10 @@ public:
 	virtual Vector3 map_get_closest_point_normal(RID p_map, const Vector3 &p_point) const = 0;
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector3 &p_point) const = 0;
 
+	/// Returns the next waypoint toward the destination from the origin, read from a flow field
+	/// that is shared by all the queries to the same destination until the map changes.
+	virtual Vector3 map_get_flow_field_next_position(RID p_map, const Vector3 &p_origin, const Vector3 &p_destination, uint32_t p_navigation_layers = 1) const = 0;
+
 	virtual TypedArray<RID> map_get_links(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const = 0;
 	virtual TypedArray<RID> map_get_agents(RID p_map) const = 0;
@@ -344,8 +349,18 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Runs many path queries on worker threads against the current state of their maps.
+	/// The results and the callback are dispatched by the next server process,
+	/// before any map changes.
+	virtual int64_t query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+	virtual bool is_path_query_finished(int64_t p_query_id) const = 0;
+
+	/// The query results can be NavigationPathQueryResult3D or NavigationPathQueryResult2D objects.
+	virtual int64_t _query_paths_async(const LocalVector<NavigationUtilities::PathQueryParameters> &p_parameters, const LocalVector<Ref<RefCounted>> &p_query_results, const Callable &p_callback) = 0;
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
+	virtual void parse_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const = 0;
@@ -59,59 +59,93 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
+	// Match against the closest contact of the previous step that was not already refreshed by
+	// another point in this step, so accumulated impulses are carried over one-to-one.
 	real_t recycle_radius_2 = space->get_contact_recycle_radius() * space->get_contact_recycle_radius();
 
+	int recycle_index = -1;
+	real_t recycle_distance_2 = recycle_radius_2;
+
 	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (recycle_radius_2) &&
-				c.local_B.distance_squared_to(local_B) < (recycle_radius_2)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			c = contact;
-			return;
+		const Contact &c = contacts[i];
+		if (c.used) {
+			continue;
 		}
+
+		real_t distance_2 = MAX(c.local_A.distance_squared_to(local_A), c.local_B.distance_squared_to(local_B));
+		if (distance_2 < recycle_distance_2) {
+			recycle_distance_2 = distance_2;
+			recycle_index = i;
+		}
+	}
+
+	if (recycle_index != -1) {
+		Contact &c = contacts[recycle_index];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		c = contact;
+		return;
 	}
 
 	// Figure out if the contact amount must be reduced to fit the new contact.
 	if (new_index == MAX_CONTACTS) {
-		// Remove the contact with the minimum depth.
+		// Contacts left over from the previous step are replaced first, since they were not
+		// confirmed by the collision solver in this step.
+		for (int i = 0; i < contact_count; i++) {
+			if (!contacts[i].used) {
+				contacts[i] = contact;
+				return;
+			}
+		}
 
+		// Otherwise keep the deepest contact and the one farthest away from it, which keeps the
+		// widest support and avoids rocking in stacks.
 		const Transform2D &transform_A = A->get_transform();
 		const Transform2D &transform_B = B->get_transform();
 
-		int least_deep = -1;
-		real_t min_depth;
+		const Contact *candidates[MAX_CONTACTS + 1];
+		Vector2 candidate_points[MAX_CONTACTS + 1];
+		int deepest = 0;
+		real_t max_depth = 0.0;
 
-		// Start with depth for new contact.
-		{
-			Vector2 global_A = transform_A.basis_xform(contact.local_A);
-			Vector2 global_B = transform_B.basis_xform(contact.local_B) + offset_B;
-
-			Vector2 axis = global_A - global_B;
-			min_depth = axis.dot(contact.normal);
-		}
-
-		for (int i = 0; i < contact_count; i++) {
-			const Contact &c = contacts[i];
+		for (int i = 0; i < MAX_CONTACTS + 1; i++) {
+			const Contact &c = (i < MAX_CONTACTS) ? contacts[i] : contact;
 			Vector2 global_A = transform_A.basis_xform(c.local_A);
 			Vector2 global_B = transform_B.basis_xform(c.local_B) + offset_B;
 
 			Vector2 axis = global_A - global_B;
 			real_t depth = axis.dot(c.normal);
 
-			if (depth < min_depth) {
-				min_depth = depth;
-				least_deep = i;
+			candidates[i] = &c;
+			candidate_points[i] = global_A;
+
+			if (i == 0 || depth > max_depth) {
+				max_depth = depth;
+				deepest = i;
 			}
 		}
 
-		if (least_deep > -1) {
-			// Replace the least deep contact by the new one.
-			contacts[least_deep] = contact;
+		int farthest = -1;
+		real_t max_distance = 0.0;
+
+		for (int i = 0; i < MAX_CONTACTS + 1; i++) {
+			if (i == deepest) {
+				continue;
+			}
+
+			real_t distance = candidate_points[i].distance_squared_to(candidate_points[deepest]);
+			if (farthest == -1 || distance > max_distance) {
+				max_distance = distance;
+				farthest = i;
+			}
 		}
 
+		Contact kept[MAX_CONTACTS] = { *candidates[deepest], *candidates[farthest] };
+		contacts[0] = kept[0];
+		contacts[1] = kept[1];
+
 		return;
 	}
 
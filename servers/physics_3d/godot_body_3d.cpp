@@ -348,47 +348,57 @@ void GodotBody3D::_shapes_changed() {
 	wakeup_neighbours();
 }
 
+void GodotBody3D::set_state_transform(const Transform3D &p_transform) {
+	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		new_transform = p_transform;
+		//wakeup_neighbours();
+		set_active(true);
+		if (first_time_kinematic) {
+			_set_transform(p_transform);
+			_set_inv_transform(get_transform().affine_inverse());
+			first_time_kinematic = false;
+		}
+
+	} else if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
+		_set_transform(p_transform);
+		_set_inv_transform(get_transform().affine_inverse());
+		wakeup_neighbours();
+	} else {
+		Transform3D t = p_transform;
+		t.orthonormalize();
+		new_transform = get_transform(); //used as old to compute motion
+		if (new_transform == t) {
+			return;
+		}
+		_set_transform(t);
+		_set_inv_transform(get_transform().inverse());
+		_update_transform_dependent();
+	}
+	wakeup();
+}
+
+void GodotBody3D::set_state_linear_velocity(const Vector3 &p_velocity) {
+	linear_velocity = p_velocity;
+	constant_linear_velocity = linear_velocity;
+	wakeup();
+}
+
+void GodotBody3D::set_state_angular_velocity(const Vector3 &p_velocity) {
+	angular_velocity = p_velocity;
+	constant_angular_velocity = angular_velocity;
+	wakeup();
+}
+
 void GodotBody3D::set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant) {
 	switch (p_state) {
 		case PhysicsServer3D::BODY_STATE_TRANSFORM: {
-			if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
-				new_transform = p_variant;
-				//wakeup_neighbours();
-				set_active(true);
-				if (first_time_kinematic) {
-					_set_transform(p_variant);
-					_set_inv_transform(get_transform().affine_inverse());
-					first_time_kinematic = false;
-				}
-
-			} else if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
-				_set_transform(p_variant);
-				_set_inv_transform(get_transform().affine_inverse());
-				wakeup_neighbours();
-			} else {
-				Transform3D t = p_variant;
-				t.orthonormalize();
-				new_transform = get_transform(); //used as old to compute motion
-				if (new_transform == t) {
-					break;
-				}
-				_set_transform(t);
-				_set_inv_transform(get_transform().inverse());
-				_update_transform_dependent();
-			}
-			wakeup();
-
+			set_state_transform(p_variant);
 		} break;
 		case PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY: {
-			linear_velocity = p_variant;
-			constant_linear_velocity = linear_velocity;
-			wakeup();
+			set_state_linear_velocity(p_variant);
 		} break;
 		case PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY: {
-			angular_velocity = p_variant;
-			constant_angular_velocity = angular_velocity;
-			wakeup();
-
+			set_state_angular_velocity(p_variant);
 		} break;
 		case PhysicsServer3D::BODY_STATE_SLEEPING: {
 			if (mode == PhysicsServer3D::BODY_MODE_STATIC || mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
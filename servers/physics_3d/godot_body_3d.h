@@ -297,6 +297,9 @@ public:
 	PhysicsServer3D::BodyMode get_mode() const;
 
 	void set_state(PhysicsServer3D::BodyState p_state, const Variant &p_variant);
+	void set_state_transform(const Transform3D &p_transform);
+	void set_state_linear_velocity(const Vector3 &p_velocity);
+	void set_state_angular_velocity(const Vector3 &p_velocity);
 	Variant get_state(PhysicsServer3D::BodyState p_state) const;
 
 	_FORCE_INLINE_ void set_continuous_collision_detection(bool p_enable) { continuous_cd = p_enable; }
@@ -166,6 +166,7 @@ void GodotBodyPair3D::validate_contacts() {
 // Process: only proceed if body A's motion is high relative to its size.
 // cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
 // adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
+// Convex shapes are swept along their motion relative to B, other shapes cast rays from their support points.
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
 	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
 
@@ -189,6 +190,10 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 
 	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
 
+	if (!shape_A_ptr->is_concave()) {
+		return _test_ccd_sweep(p_step, p_A, p_shape_A, p_xform_A, p_B, p_shape_B, p_xform_B, mnormal, mlen, max - min);
+	}
+
 	// Roughly predict body B's position in the next frame (ignoring collisions).
 	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
 
@@ -250,6 +255,60 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	return true;
 }
 
+// Sweeps the whole convex shape of A along its motion relative to B (conservative advancement by bisection),
+// so thin features of B falling between the support point rays of A are not missed.
+bool GodotBodyPair3D::_test_ccd_sweep(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B, const Vector3 &p_motion_normal, real_t p_motion_length, real_t p_extent) {
+	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
+	GodotShape3D *shape_B_ptr = p_B->get_shape(p_shape_B);
+
+	Vector3 rel_motion = p_motion_normal * p_motion_length - p_B->get_linear_velocity() * p_step;
+	real_t rel_motion_length = rel_motion.length();
+	if (rel_motion_length < CMP_EPSILON) {
+		return false;
+	}
+	Vector3 rel_motion_normal = rel_motion / rel_motion_length;
+
+	AABB motion_aabb = p_xform_A.xform(shape_A_ptr->get_aabb());
+	motion_aabb = motion_aabb.merge(AABB(motion_aabb.position + rel_motion, motion_aabb.size));
+
+	Basis xform_A_inv_basis = p_xform_A.basis.inverse();
+
+	GodotMotionShape3D mshape;
+	mshape.shape = shape_A_ptr;
+	mshape.motion = xform_A_inv_basis.xform(rel_motion);
+
+	Vector3 point_A, point_B;
+	Vector3 sep_axis = rel_motion_normal;
+	if (GodotCollisionSolver3D::solve_distance(&mshape, p_xform_A, shape_B_ptr, p_xform_B, point_A, point_B, motion_aabb, &sep_axis)) {
+		// The swept shape doesn't reach B during this step.
+		return false;
+	}
+
+	real_t low = 0.0;
+	real_t hi = 1.0;
+	for (int k = 0; k < 8; k++) {
+		real_t fraction = (low + hi) * 0.5;
+		mshape.motion = xform_A_inv_basis.xform(rel_motion * fraction);
+
+		Vector3 sep = rel_motion_normal;
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_xform_A, shape_B_ptr, p_xform_B, point_A, point_B, motion_aabb, &sep)) {
+			low = fraction;
+		} else {
+			hi = fraction;
+		}
+	}
+
+	// Advance A up to the first colliding fraction, plus 1% of its length so it arrives just within B's collider next frame.
+	real_t newlen = p_motion_length * hi + p_extent * 0.01;
+	if (newlen >= p_motion_length) {
+		return false;
+	}
+
+	p_A->set_linear_velocity((p_motion_normal * newlen) / p_step);
+
+	return true;
+}
+
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
 	return CLAMP(A->get_bounce() + B->get_bounce(), 0, 1);
 }
@@ -37,6 +37,20 @@
 class GodotCollisionObject3D;
 
 class GodotBroadPhase3D {
+	uint64_t revision = 0;
+	uint64_t run_start_revision = 0;
+	const GodotCollisionObject3D *run_object = nullptr;
+
+protected:
+	// Called whenever a proxy of p_object is created, moved, removed or changes its static state.
+	_FORCE_INLINE_ void _proxy_changed(const GodotCollisionObject3D *p_object) {
+		revision++;
+		if (p_object != run_object) {
+			run_object = p_object;
+			run_start_revision = revision;
+		}
+	}
+
 public:
 	typedef GodotBroadPhase3D *(*CreateFunction)();
 
@@ -66,6 +80,13 @@ public:
 
 	virtual void update() = 0;
 
+	_FORCE_INLINE_ uint64_t get_revision() const { return revision; }
+	// Returns true if no proxies other than those of p_object changed since p_revision,
+	// in which case culling the same region gives the same results apart from p_object.
+	_FORCE_INLINE_ bool is_unchanged_except(uint64_t p_revision, const GodotCollisionObject3D *p_object) const {
+		return revision == p_revision || (run_object == p_object && run_start_revision <= p_revision + 1);
+	}
+
 	virtual ~GodotBroadPhase3D();
 };
 
@@ -36,12 +36,14 @@ GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
+	_proxy_changed(p_object);
 	return oid + 1;
 }
 
 void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 	ERR_FAIL_COND(!p_id);
 	bvh.move(p_id - 1, p_aabb);
+	_proxy_changed(bvh.get(p_id - 1));
 }
 
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
@@ -49,10 +51,12 @@ void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
+	_proxy_changed(bvh.get(p_id - 1));
 }
 
 void GodotBroadPhase3DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
+	_proxy_changed(bvh.get(p_id - 1));
 	bvh.erase(p_id - 1);
 }
 
@@ -691,6 +691,52 @@ Variant GodotPhysicsServer3D::body_get_state(RID p_body, BodyState p_state) cons
 	return body->get_state(p_state);
 }
 
+Vector<float> GodotPhysicsServer3D::bodies_get_state_buffer(const Vector<RID> &p_bodies) const {
+	Vector<float> buffer;
+	buffer.resize(p_bodies.size() * BODIES_STATE_BUFFER_STRIDE);
+
+	float *w = buffer.ptrw();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		const GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_CONTINUE(!body);
+
+		_write_body_state(w + i * BODIES_STATE_BUFFER_STRIDE, body->get_transform(), body->get_linear_velocity(), body->get_angular_velocity());
+	}
+
+	return buffer;
+}
+
+void GodotPhysicsServer3D::bodies_set_state_buffer(const Vector<RID> &p_bodies, const Vector<float> &p_buffer, BitField<BodyStateBufferMask> p_mask) {
+	ERR_FAIL_COND(p_buffer.size() != p_bodies.size() * BODIES_STATE_BUFFER_STRIDE);
+
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		GodotBody3D *body = body_owner.get_or_null(p_bodies[i]);
+		ERR_CONTINUE(!body);
+
+		const float *state = r + i * BODIES_STATE_BUFFER_STRIDE;
+		BitField<BodyStateBufferMask> changes = _get_body_state_changes(state, p_mask, body->get_transform(), body->get_linear_velocity(), body->get_angular_velocity());
+		if (changes.is_empty()) {
+			continue;
+		}
+
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		_read_body_state(state, transform, linear_velocity, angular_velocity);
+
+		if (changes.has_flag(BODY_STATE_BUFFER_TRANSFORM)) {
+			body->set_state_transform(transform);
+		}
+		if (changes.has_flag(BODY_STATE_BUFFER_LINEAR_VELOCITY)) {
+			body->set_state_linear_velocity(linear_velocity);
+		}
+		if (changes.has_flag(BODY_STATE_BUFFER_ANGULAR_VELOCITY)) {
+			body->set_state_angular_velocity(angular_velocity);
+		}
+	}
+}
+
 void GodotPhysicsServer3D::body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) {
 	GodotBody3D *body = body_owner.get_or_null(p_body);
 	ERR_FAIL_NULL(body);
@@ -209,6 +209,9 @@ public:
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) override;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
 
+	virtual Vector<float> bodies_get_state_buffer(const Vector<RID> &p_bodies) const override;
+	virtual void bodies_set_state_buffer(const Vector<RID> &p_bodies, const Vector<float> &p_buffer, BitField<BodyStateBufferMask> p_mask = BODY_STATE_BUFFER_ALL) override;
+
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) override;
 	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) override;
 	virtual void body_apply_torque_impulse(RID p_body, const Vector3 &p_impulse) override;
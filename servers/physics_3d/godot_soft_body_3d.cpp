@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/rb_map.h"
 #include "servers/rendering_server.h"
 
@@ -582,6 +583,7 @@ bool GodotSoftBody3D::create_from_trimesh(const Vector<int> &p_indices, const Ve
 
 	generate_bending_constraints(2);
 	reoptimize_link_order();
+	update_link_batches();
 
 	update_constants();
 	update_normals_and_centroids();
@@ -826,6 +828,54 @@ void GodotSoftBody3D::reoptimize_link_order() {
 	memdelete_arr(link_buffer);
 }
 
+void GodotSoftBody3D::update_link_batches() {
+	link_batch_offsets.clear();
+
+	uint32_t link_count = links.size();
+	if (link_count == 0) {
+		return;
+	}
+
+	// Greedy coloring: each pass takes, in order, the remaining links whose nodes are not touched
+	// by another link of the same pass. The relative order of links inside a batch is preserved.
+	LocalVector<Link> sorted_links;
+	sorted_links.reserve(link_count);
+
+	LocalVector<Link> remaining_links = links;
+	LocalVector<Link> next_remaining_links;
+	next_remaining_links.reserve(link_count);
+
+	LocalVector<uint32_t> node_batch;
+	node_batch.resize(nodes.size());
+	for (uint32_t &batch : node_batch) {
+		batch = UINT32_MAX;
+	}
+
+	while (!remaining_links.is_empty()) {
+		uint32_t batch_index = link_batch_offsets.size();
+		link_batch_offsets.push_back(sorted_links.size());
+
+		next_remaining_links.clear();
+		for (const Link &link : remaining_links) {
+			uint32_t &batch_A = node_batch[link.n[0]->index];
+			uint32_t &batch_B = node_batch[link.n[1]->index];
+			if (batch_A == batch_index || batch_B == batch_index) {
+				next_remaining_links.push_back(link);
+				continue;
+			}
+
+			batch_A = batch_index;
+			batch_B = batch_index;
+			sorted_links.push_back(link);
+		}
+
+		SWAP(remaining_links, next_remaining_links);
+	}
+	link_batch_offsets.push_back(sorted_links.size());
+
+	links = sorted_links;
+}
+
 void GodotSoftBody3D::append_link(uint32_t p_node1, uint32_t p_node2) {
 	if (p_node1 == p_node2) {
 		return;
@@ -1067,46 +1117,54 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	face_tree.optimize_incremental(1);
 }
 
-void GodotSoftBody3D::solve_constraints(real_t p_delta) {
-	const real_t inv_delta = 1.0 / p_delta;
+template <typename M>
+void GodotSoftBody3D::_solve_chunks(M p_method, const SolveChunkData &p_data, bool p_multithreaded) {
+	uint32_t chunk_count = (p_data.to - p_data.from + SOLVE_CHUNK_SIZE - 1) / SOLVE_CHUNK_SIZE;
 
-	for (Link &link : links) {
-		link.c3 = link.n[1]->q - link.n[0]->q;
-		link.c2 = 1 / (link.c3.length_squared() * link.c0);
+	if (p_multithreaded && chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, &p_data, chunk_count, -1, true, SNAME("Physics3DSoftBodySolve"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t chunk_index = 0; chunk_index < chunk_count; ++chunk_index) {
+			(this->*p_method)(chunk_index, &p_data);
+		}
 	}
+}
 
-	// Solve velocities.
-	for (Node &node : nodes) {
-		node.x = node.q + node.v * p_delta;
-	}
+void GodotSoftBody3D::_prepare_links_chunk(uint32_t p_chunk, const SolveChunkData *p_data) {
+	uint32_t from = p_data->from + p_chunk * SOLVE_CHUNK_SIZE;
+	uint32_t to = MIN(from + SOLVE_CHUNK_SIZE, p_data->to);
 
-	// Solve positions.
-	for (int isolve = 0; isolve < iteration_count; ++isolve) {
-		const real_t ti = isolve / (real_t)iteration_count;
-		solve_links(1.0, ti);
+	for (uint32_t link_index = from; link_index < to; ++link_index) {
+		Link &link = links[link_index];
+		link.c3 = link.n[1]->q - link.n[0]->q;
+		link.c2 = 1 / (link.c3.length_squared() * link.c0);
 	}
-	const real_t vc = (1.0 - damping_coefficient) * inv_delta;
-	for (Node &node : nodes) {
-		node.x += node.bv * p_delta;
-		node.bv = Vector3();
+}
 
-		node.v = (node.x - node.q) * vc;
+void GodotSoftBody3D::_predict_nodes_chunk(uint32_t p_chunk, const SolveChunkData *p_data) {
+	uint32_t from = p_data->from + p_chunk * SOLVE_CHUNK_SIZE;
+	uint32_t to = MIN(from + SOLVE_CHUNK_SIZE, p_data->to);
 
-		node.q = node.x;
+	for (uint32_t node_index = from; node_index < to; ++node_index) {
+		Node &node = nodes[node_index];
+		node.x = node.q + node.v * p_data->delta;
 	}
-
-	update_normals_and_centroids();
 }
 
-void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
-	for (Link &link : links) {
+void GodotSoftBody3D::_solve_links_chunk(uint32_t p_chunk, const SolveChunkData *p_data) {
+	uint32_t from = p_data->from + p_chunk * SOLVE_CHUNK_SIZE;
+	uint32_t to = MIN(from + SOLVE_CHUNK_SIZE, p_data->to);
+
+	for (uint32_t link_index = from; link_index < to; ++link_index) {
+		Link &link = links[link_index];
 		if (link.c0 > 0) {
 			Node &node_a = *link.n[0];
 			Node &node_b = *link.n[1];
 			const Vector3 del = node_b.x - node_a.x;
 			const real_t len = del.length_squared();
 			if (link.c1 + len > CMP_EPSILON) {
-				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * kst;
+				const real_t k = ((link.c1 - len) / (link.c0 * (link.c1 + len))) * p_data->kst;
 				node_a.x -= del * (k * node_a.im);
 				node_b.x += del * (k * node_b.im);
 			}
@@ -1114,6 +1172,55 @@ void GodotSoftBody3D::solve_links(real_t kst, real_t ti) {
 	}
 }
 
+void GodotSoftBody3D::_integrate_nodes_chunk(uint32_t p_chunk, const SolveChunkData *p_data) {
+	uint32_t from = p_data->from + p_chunk * SOLVE_CHUNK_SIZE;
+	uint32_t to = MIN(from + SOLVE_CHUNK_SIZE, p_data->to);
+
+	const real_t vc = (1.0 - damping_coefficient) / p_data->delta;
+	for (uint32_t node_index = from; node_index < to; ++node_index) {
+		Node &node = nodes[node_index];
+		node.x += node.bv * p_data->delta;
+		node.bv = Vector3();
+
+		node.v = (node.x - node.q) * vc;
+
+		node.q = node.x;
+	}
+}
+
+void GodotSoftBody3D::solve_constraints(real_t p_delta, bool p_multithreaded) {
+	SolveChunkData link_data;
+	link_data.to = links.size();
+	_solve_chunks(&GodotSoftBody3D::_prepare_links_chunk, link_data, p_multithreaded);
+
+	// Solve velocities.
+	SolveChunkData node_data;
+	node_data.to = nodes.size();
+	node_data.delta = p_delta;
+	_solve_chunks(&GodotSoftBody3D::_predict_nodes_chunk, node_data, p_multithreaded);
+
+	// Solve positions.
+	for (int isolve = 0; isolve < iteration_count; ++isolve) {
+		const real_t ti = isolve / (real_t)iteration_count;
+		solve_links(1.0, ti, p_multithreaded);
+	}
+
+	_solve_chunks(&GodotSoftBody3D::_integrate_nodes_chunk, node_data, p_multithreaded);
+
+	update_normals_and_centroids();
+}
+
+void GodotSoftBody3D::solve_links(real_t kst, real_t ti, bool p_multithreaded) {
+	// Links inside a batch don't share nodes, so the result doesn't depend on how a batch is split between threads.
+	for (uint32_t batch_index = 0; batch_index + 1 < link_batch_offsets.size(); ++batch_index) {
+		SolveChunkData data;
+		data.from = link_batch_offsets[batch_index];
+		data.to = link_batch_offsets[batch_index + 1];
+		data.kst = kst;
+		_solve_chunks(&GodotSoftBody3D::_solve_links_chunk, data, p_multithreaded);
+	}
+}
+
 struct AABBQueryResult {
 	const GodotSoftBody3D *soft_body = nullptr;
 	void *userdata = nullptr;
@@ -1221,6 +1328,7 @@ void GodotSoftBody3D::destroy() {
 
 	nodes.clear();
 	links.clear();
+	link_batch_offsets.clear();
 	faces.clear();
 
 	bounds = AABB();
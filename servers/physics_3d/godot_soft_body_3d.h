@@ -82,6 +82,10 @@ class GodotSoftBody3D : public GodotCollisionObject3D {
 	LocalVector<Link> links;
 	LocalVector<Face> faces;
 
+	// Links are sorted in batches that don't share any node, so each batch can be solved in parallel.
+	// Batch i covers links [link_batch_offsets[i], link_batch_offsets[i + 1]).
+	LocalVector<uint32_t> link_batch_offsets;
+
 	DynamicBVH node_tree;
 	DynamicBVH face_tree;
 
@@ -202,7 +206,7 @@ public:
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
 	void predict_motion(real_t p_delta);
-	void solve_constraints(real_t p_delta);
+	void solve_constraints(real_t p_delta, bool p_multithreaded = false);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
 	_FORCE_INLINE_ uint32_t get_face_index(void *p_face) const { return static_cast<Face *>(p_face)->index; }
@@ -237,7 +241,27 @@ private:
 	void append_link(uint32_t p_node1, uint32_t p_node2);
 	void append_face(uint32_t p_node1, uint32_t p_node2, uint32_t p_node3);
 
-	void solve_links(real_t kst, real_t ti);
+	void update_link_batches();
+
+	void solve_links(real_t kst, real_t ti, bool p_multithreaded);
+
+	enum {
+		SOLVE_CHUNK_SIZE = 256,
+	};
+
+	struct SolveChunkData {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		real_t delta = 0.0;
+		real_t kst = 0.0;
+	};
+
+	template <typename M>
+	void _solve_chunks(M p_method, const SolveChunkData &p_data, bool p_multithreaded);
+	void _prepare_links_chunk(uint32_t p_chunk, const SolveChunkData *p_data);
+	void _predict_nodes_chunk(uint32_t p_chunk, const SolveChunkData *p_data);
+	void _solve_links_chunk(uint32_t p_chunk, const SolveChunkData *p_data);
+	void _integrate_nodes_chunk(uint32_t p_chunk, const SolveChunkData *p_data);
 
 	void initialize_face_tree();
 	void update_face_tree(real_t p_delta);
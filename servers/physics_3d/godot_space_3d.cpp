@@ -615,8 +615,8 @@ GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_filter_cull_results_for_body(GodotBody3D *p_body, int p_amount) {
+	int amount = p_amount;
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
@@ -647,6 +647,39 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
+int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
+	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	return _filter_cull_results_for_body(p_body, amount);
+}
+
+int GodotSpace3D::_cull_aabb_for_body_motion(GodotBody3D *p_body, AABB &r_aabb, bool &r_truncated) {
+	r_truncated = false;
+
+	if (motion_cull_cache.valid && motion_cull_cache.aabb.encloses(r_aabb) && broadphase->is_unchanged_except(motion_cull_cache.revision, p_body)) {
+		r_aabb = motion_cull_cache.aabb;
+		int amount = motion_cull_cache.results.size();
+		memcpy(intersection_query_results, motion_cull_cache.results.ptr(), amount * sizeof(GodotCollisionObject3D *));
+		memcpy(intersection_query_subindex_results, motion_cull_cache.subindex_results.ptr(), amount * sizeof(int));
+		return _filter_cull_results_for_body(p_body, amount);
+	}
+
+	int amount = broadphase->cull_aabb(r_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+
+	// A full buffer may have dropped candidates, the caller has to fall back to smaller queries.
+	r_truncated = amount >= INTERSECTION_QUERY_MAX;
+	motion_cull_cache.valid = !r_truncated;
+	if (motion_cull_cache.valid) {
+		motion_cull_cache.aabb = r_aabb;
+		motion_cull_cache.revision = broadphase->get_revision();
+		motion_cull_cache.results.resize(amount);
+		motion_cull_cache.subindex_results.resize(amount);
+		memcpy(motion_cull_cache.results.ptr(), intersection_query_results, amount * sizeof(GodotCollisionObject3D *));
+		memcpy(motion_cull_cache.subindex_results.ptr(), intersection_query_subindex_results, amount * sizeof(int));
+	}
+
+	return _filter_cull_results_for_body(p_body, amount);
+}
+
 bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
 	//give me back regular physics engine logic
 	//this is madness
@@ -698,6 +731,30 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 	Transform3D body_transform = p_parameters.from;
 
+	// Cull once for the whole query and share the candidates between the recovery, cast and rest info steps.
+	// Each step only checks the candidate bounds against its own AABB, and the broadphase is only queried
+	// again if recovery pushes the body out of the culled region. The region is grown by the motion length,
+	// so it also covers the remaining motion of the next move_and_slide() iterations, which can then reuse it.
+	// If too many candidates are found to fit the query buffer, each step queries its own AABB instead.
+	AABB cull_aabb;
+	int cull_amount = 0;
+	bool culled = false;
+	bool cull_truncated = false;
+	auto cull_step = [&](const AABB &p_step_aabb, const AABB &p_shared_aabb) {
+		if (culled && !cull_truncated && cull_aabb.encloses(p_step_aabb)) {
+			return;
+		}
+		if (!cull_truncated) {
+			cull_aabb = p_shared_aabb.grow(motion_length);
+			cull_amount = _cull_aabb_for_body_motion(p_body, cull_aabb, cull_truncated);
+		}
+		if (cull_truncated) {
+			cull_aabb = p_step_aabb;
+			cull_amount = _cull_aabb_for_body(p_body, cull_aabb);
+		}
+		culled = true;
+	};
+
 	bool recovered = false;
 
 	{
@@ -720,7 +777,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			cull_step(body_aabb, body_aabb.merge(AABB(body_aabb.position + p_parameters.motion, body_aabb.size)));
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -730,8 +787,12 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				Transform3D body_shape_xform = body_transform * p_body->get_shape_transform(j);
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
-				for (int i = 0; i < amount; i++) {
+				for (int i = 0; i < cull_amount; i++) {
 					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+					int shape_idx = intersection_query_subindex_results[i];
+					if (!body_aabb.intersects(col_obj->get_shape_aabb(shape_idx))) {
+						continue;
+					}
 					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 						continue;
 					}
@@ -739,8 +800,6 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 						continue;
 					}
 
-					int shape_idx = intersection_query_subindex_results[i];
-
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
 						collided = cbk.amount > 0;
 					}
@@ -804,7 +863,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		cull_step(motion_aabb, motion_aabb);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -834,8 +893,12 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_safe = 1;
 			real_t best_unsafe = 1;
 
-			for (int i = 0; i < amount; i++) {
+			for (int i = 0; i < cull_amount; i++) {
 				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				int shape_idx = intersection_query_subindex_results[i];
+				if (!motion_aabb.intersects(col_obj->get_shape_aabb(shape_idx))) {
+					continue;
+				}
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -843,8 +906,6 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
-
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
 				Vector3 sep_axis = motion_normal;
@@ -944,7 +1005,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 		body_aabb.position += p_parameters.motion * unsafe;
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		cull_step(body_aabb, body_aabb);
 
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
@@ -957,8 +1018,12 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			Transform3D body_shape_xform = ugt * p_body->get_shape_transform(j);
 			GodotShape3D *body_shape = p_body->get_shape(j);
 
-			for (int i = 0; i < amount; i++) {
+			for (int i = 0; i < cull_amount; i++) {
 				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+				int shape_idx = intersection_query_subindex_results[i];
+				if (!body_aabb.intersects(col_obj->get_shape_aabb(shape_idx))) {
+					continue;
+				}
 				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
 					continue;
 				}
@@ -966,8 +1031,6 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 					continue;
 				}
 
-				int shape_idx = intersection_query_subindex_results[i];
-
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
 				bool sc = GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin);
@@ -41,6 +41,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
@@ -126,7 +127,19 @@ private:
 
 	friend class GodotPhysicsDirectSpaceState3D;
 
+	// Raw broadphase results of the last motion test, reused by the next motion tests of the same body
+	// (such as the other iterations of move_and_slide()) as long as no other object changed in the broadphase.
+	struct MotionCullCache {
+		AABB aabb;
+		uint64_t revision = 0;
+		bool valid = false;
+		LocalVector<GodotCollisionObject3D *> results;
+		LocalVector<int> subindex_results;
+	} motion_cull_cache;
+
+	int _filter_cull_results_for_body(GodotBody3D *p_body, int p_amount);
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	int _cull_aabb_for_body_motion(GodotBody3D *p_body, AABB &r_aabb, bool &r_truncated);
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -158,6 +158,10 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_solve_soft_body(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->solve_constraints(delta);
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -390,12 +394,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* UPDATE SOFT BODY CONSTRAINTS */
 
+	active_soft_bodies.clear();
 	sb = soft_body_list->first();
 	while (sb) {
-		sb->self()->solve_constraints(p_delta);
+		active_soft_bodies.push_back(sb->self());
 		sb = sb->next();
 	}
 
+	// Several soft bodies are solved in parallel with each other,
+	// while a single soft body parallelizes its own node and link batches instead.
+	if (active_soft_bodies.size() == 1) {
+		active_soft_bodies[0]->solve_constraints(p_delta, true);
+	} else if (active_soft_bodies.size() > 1) {
+		group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_soft_body, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DSoftBodySolve"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
@@ -403,6 +417,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	active_soft_bodies.clear();
 
 	p_space->unlock();
 	_step++;
@@ -662,6 +662,121 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+Vector<float> PhysicsServer3D::_bodies_get_state_buffer(const TypedArray<RID> &p_bodies) const {
+	Vector<RID> bodies;
+	bodies.resize(p_bodies.size());
+	for (int i = 0; i < p_bodies.size(); i++) {
+		bodies.write[i] = p_bodies[i];
+	}
+
+	return bodies_get_state_buffer(bodies);
+}
+
+void PhysicsServer3D::_bodies_set_state_buffer(const TypedArray<RID> &p_bodies, const Vector<float> &p_buffer, uint32_t p_mask) {
+	Vector<RID> bodies;
+	bodies.resize(p_bodies.size());
+	for (int i = 0; i < p_bodies.size(); i++) {
+		bodies.write[i] = p_bodies[i];
+	}
+
+	bodies_set_state_buffer(bodies, p_buffer, p_mask);
+}
+
+void PhysicsServer3D::_write_body_state(float *w, const Transform3D &p_transform, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity) {
+	w[0] = p_transform.basis.rows[0][0];
+	w[1] = p_transform.basis.rows[0][1];
+	w[2] = p_transform.basis.rows[0][2];
+	w[3] = p_transform.origin.x;
+	w[4] = p_transform.basis.rows[1][0];
+	w[5] = p_transform.basis.rows[1][1];
+	w[6] = p_transform.basis.rows[1][2];
+	w[7] = p_transform.origin.y;
+	w[8] = p_transform.basis.rows[2][0];
+	w[9] = p_transform.basis.rows[2][1];
+	w[10] = p_transform.basis.rows[2][2];
+	w[11] = p_transform.origin.z;
+	w[12] = p_linear_velocity.x;
+	w[13] = p_linear_velocity.y;
+	w[14] = p_linear_velocity.z;
+	w[15] = p_angular_velocity.x;
+	w[16] = p_angular_velocity.y;
+	w[17] = p_angular_velocity.z;
+}
+
+void PhysicsServer3D::_read_body_state(const float *r, Transform3D &r_transform, Vector3 &r_linear_velocity, Vector3 &r_angular_velocity) {
+	r_transform.basis.rows[0] = Vector3(r[0], r[1], r[2]);
+	r_transform.origin.x = r[3];
+	r_transform.basis.rows[1] = Vector3(r[4], r[5], r[6]);
+	r_transform.origin.y = r[7];
+	r_transform.basis.rows[2] = Vector3(r[8], r[9], r[10]);
+	r_transform.origin.z = r[11];
+	r_linear_velocity = Vector3(r[12], r[13], r[14]);
+	r_angular_velocity = Vector3(r[15], r[16], r[17]);
+}
+
+uint32_t PhysicsServer3D::_get_body_state_changes(const float *p_state, uint32_t p_mask, const Transform3D &p_transform, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity) {
+	// Compare in the precision of the buffer, so states read through bodies_get_state_buffer() are unchanged.
+	float current[BODIES_STATE_BUFFER_STRIDE];
+	_write_body_state(current, p_transform, p_linear_velocity, p_angular_velocity);
+
+	uint32_t changes = 0;
+	if ((p_mask & BODY_STATE_BUFFER_TRANSFORM) && memcmp(current, p_state, 12 * sizeof(float)) != 0) {
+		changes |= BODY_STATE_BUFFER_TRANSFORM;
+	}
+	if ((p_mask & BODY_STATE_BUFFER_LINEAR_VELOCITY) && memcmp(current + 12, p_state + 12, 3 * sizeof(float)) != 0) {
+		changes |= BODY_STATE_BUFFER_LINEAR_VELOCITY;
+	}
+	if ((p_mask & BODY_STATE_BUFFER_ANGULAR_VELOCITY) && memcmp(current + 15, p_state + 15, 3 * sizeof(float)) != 0) {
+		changes |= BODY_STATE_BUFFER_ANGULAR_VELOCITY;
+	}
+	return changes;
+}
+
+// Generic implementations going through the per-body state API, servers can override them with a direct path.
+
+Vector<float> PhysicsServer3D::bodies_get_state_buffer(const Vector<RID> &p_bodies) const {
+	Vector<float> buffer;
+	buffer.resize(p_bodies.size() * BODIES_STATE_BUFFER_STRIDE);
+
+	float *w = buffer.ptrw();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		const Transform3D transform = body_get_state(p_bodies[i], BODY_STATE_TRANSFORM);
+		const Vector3 linear_velocity = body_get_state(p_bodies[i], BODY_STATE_LINEAR_VELOCITY);
+		const Vector3 angular_velocity = body_get_state(p_bodies[i], BODY_STATE_ANGULAR_VELOCITY);
+		_write_body_state(w + i * BODIES_STATE_BUFFER_STRIDE, transform, linear_velocity, angular_velocity);
+	}
+
+	return buffer;
+}
+
+void PhysicsServer3D::bodies_set_state_buffer(const Vector<RID> &p_bodies, const Vector<float> &p_buffer, BitField<BodyStateBufferMask> p_mask) {
+	ERR_FAIL_COND(p_buffer.size() != p_bodies.size() * BODIES_STATE_BUFFER_STRIDE);
+
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < p_bodies.size(); i++) {
+		const float *state = r + i * BODIES_STATE_BUFFER_STRIDE;
+		BitField<BodyStateBufferMask> changes = _get_body_state_changes(state, p_mask, body_get_state(p_bodies[i], BODY_STATE_TRANSFORM), body_get_state(p_bodies[i], BODY_STATE_LINEAR_VELOCITY), body_get_state(p_bodies[i], BODY_STATE_ANGULAR_VELOCITY));
+		if (changes.is_empty()) {
+			continue;
+		}
+
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		_read_body_state(state, transform, linear_velocity, angular_velocity);
+
+		if (changes.has_flag(BODY_STATE_BUFFER_TRANSFORM)) {
+			body_set_state(p_bodies[i], BODY_STATE_TRANSFORM, transform);
+		}
+		if (changes.has_flag(BODY_STATE_BUFFER_LINEAR_VELOCITY)) {
+			body_set_state(p_bodies[i], BODY_STATE_LINEAR_VELOCITY, linear_velocity);
+		}
+		if (changes.has_flag(BODY_STATE_BUFFER_ANGULAR_VELOCITY)) {
+			body_set_state(p_bodies[i], BODY_STATE_ANGULAR_VELOCITY, angular_velocity);
+		}
+	}
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -837,6 +952,9 @@ void PhysicsServer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer3D::body_get_direct_state);
 
+	ClassDB::bind_method(D_METHOD("bodies_get_state_buffer", "bodies"), &PhysicsServer3D::_bodies_get_state_buffer);
+	ClassDB::bind_method(D_METHOD("bodies_set_state_buffer", "bodies", "buffer", "mask"), &PhysicsServer3D::_bodies_set_state_buffer, DEFVAL(BODY_STATE_BUFFER_ALL));
+
 	/* SOFT BODY API */
 
 	ClassDB::bind_method(D_METHOD("soft_body_create"), &PhysicsServer3D::soft_body_create);
@@ -1093,6 +1211,11 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(BODY_STATE_SLEEPING);
 	BIND_ENUM_CONSTANT(BODY_STATE_CAN_SLEEP);
 
+	BIND_BITFIELD_FLAG(BODY_STATE_BUFFER_TRANSFORM);
+	BIND_BITFIELD_FLAG(BODY_STATE_BUFFER_LINEAR_VELOCITY);
+	BIND_BITFIELD_FLAG(BODY_STATE_BUFFER_ANGULAR_VELOCITY);
+	BIND_BITFIELD_FLAG(BODY_STATE_BUFFER_ALL);
+
 	BIND_ENUM_CONSTANT(AREA_BODY_ADDED);
 	BIND_ENUM_CONSTANT(AREA_BODY_REMOVED);
 
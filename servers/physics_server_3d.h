@@ -237,9 +237,18 @@ class PhysicsServer3D : public Object {
 
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
 
+	Vector<float> _bodies_get_state_buffer(const TypedArray<RID> &p_bodies) const;
+	void _bodies_set_state_buffer(const TypedArray<RID> &p_bodies, const Vector<float> &p_buffer, uint32_t p_mask);
+
 protected:
 	static void _bind_methods();
 
+	static void _write_body_state(float *w, const Transform3D &p_transform, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity);
+	static void _read_body_state(const float *r, Transform3D &r_transform, Vector3 &r_linear_velocity, Vector3 &r_angular_velocity);
+
+	// Returns the BodyStateBufferMask flags of p_mask whose state in p_state differs from the given one.
+	static uint32_t _get_body_state_changes(const float *p_state, uint32_t p_mask, const Transform3D &p_transform, const Vector3 &p_linear_velocity, const Vector3 &p_angular_velocity);
+
 public:
 	static PhysicsServer3D *get_singleton();
 
@@ -466,6 +475,25 @@ public:
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) = 0;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const = 0;
 
+	// Bulk state access, each body uses BODIES_STATE_BUFFER_STRIDE floats in the buffer:
+	// the transform as 3 basis rows followed by the origin component of that row (like MultiMesh),
+	// then the linear velocity and the angular velocity.
+	// When setting, only the states in the mask that differ from the body's current state are applied,
+	// so writing back unchanged states doesn't wake sleeping bodies.
+	enum {
+		BODIES_STATE_BUFFER_STRIDE = 18,
+	};
+
+	enum BodyStateBufferMask {
+		BODY_STATE_BUFFER_TRANSFORM = 1,
+		BODY_STATE_BUFFER_LINEAR_VELOCITY = 2,
+		BODY_STATE_BUFFER_ANGULAR_VELOCITY = 4,
+		BODY_STATE_BUFFER_ALL = BODY_STATE_BUFFER_TRANSFORM | BODY_STATE_BUFFER_LINEAR_VELOCITY | BODY_STATE_BUFFER_ANGULAR_VELOCITY,
+	};
+
+	virtual Vector<float> bodies_get_state_buffer(const Vector<RID> &p_bodies) const;
+	virtual void bodies_set_state_buffer(const Vector<RID> &p_bodies, const Vector<float> &p_buffer, BitField<BodyStateBufferMask> p_mask = BODY_STATE_BUFFER_ALL);
+
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) = 0;
 	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) = 0;
 	virtual void body_apply_torque_impulse(RID p_body, const Vector3 &p_impulse) = 0;
@@ -1045,6 +1073,7 @@ VARIANT_ENUM_CAST(PhysicsServer3D::BodyMode);
 VARIANT_ENUM_CAST(PhysicsServer3D::BodyParameter);
 VARIANT_ENUM_CAST(PhysicsServer3D::BodyDampMode);
 VARIANT_ENUM_CAST(PhysicsServer3D::BodyState);
+VARIANT_BITFIELD_CAST(PhysicsServer3D::BodyStateBufferMask);
 VARIANT_ENUM_CAST(PhysicsServer3D::BodyAxis);
 VARIANT_ENUM_CAST(PhysicsServer3D::PinJointParam);
 VARIANT_ENUM_CAST(PhysicsServer3D::JointType);
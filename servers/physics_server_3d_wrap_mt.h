@@ -214,6 +214,9 @@ public:
 	FUNC3(body_set_state, RID, BodyState, const Variant &);
 	FUNC2RC(Variant, body_get_state, RID, BodyState);
 
+	FUNC3(bodies_set_state_buffer, const Vector<RID> &, const Vector<float> &, BitField<BodyStateBufferMask>);
+	FUNC1RC(Vector<float>, bodies_get_state_buffer, const Vector<RID> &);
+
 	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
 	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
 	FUNC3(body_apply_impulse, RID, const Vector3 &, const Vector3 &);
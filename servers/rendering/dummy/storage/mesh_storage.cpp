@@ -54,6 +54,7 @@ void MeshStorage::mesh_free(RID p_rid) {
 	DummyMesh *mesh = mesh_owner.get_or_null(p_rid);
 	ERR_FAIL_NULL(mesh);
 
+	mesh->dependency.deleted_notify(p_rid);
 	mesh_owner.free(p_rid);
 }
 
@@ -62,6 +63,14 @@ void MeshStorage::mesh_clear(RID p_mesh) {
 	ERR_FAIL_NULL(m);
 
 	m->surfaces.clear();
+	m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MESH);
+}
+
+Dependency *MeshStorage::mesh_get_dependency(RID p_mesh) const {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_NULL_V(m, nullptr);
+
+	return &m->dependency;
 }
 
 RID MeshStorage::multimesh_allocate() {
@@ -76,9 +85,19 @@ void MeshStorage::multimesh_free(RID p_rid) {
 	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_rid);
 	ERR_FAIL_NULL(multimesh);
 
+	multimesh->dependency.deleted_notify(p_rid);
 	multimesh_owner.free(p_rid);
 }
 
+void MeshStorage::multimesh_allocate_data(RID p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, bool p_use_colors, bool p_use_custom_data) {
+	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	// Only the layout is kept, so sparse buffer updates are validated like in the other renderers.
+	multimesh->stride_cache = p_transform_format == RS::MULTIMESH_TRANSFORM_2D ? 8 : 12;
+	multimesh->stride_cache += p_use_colors ? 4 : 0;
+	multimesh->stride_cache += p_use_custom_data ? 4 : 0;
+}
+
 void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) {
 	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL(multimesh);
@@ -87,9 +106,34 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	memcpy(cache_data, p_buffer.ptr(), p_buffer.size() * sizeof(float));
 }
 
+void MeshStorage::multimesh_set_buffer_instances(RID p_multimesh, const Vector<int> &p_instances, const Vector<float> &p_buffer) {
+	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	ERR_FAIL_COND(p_buffer.size() != (p_instances.size() * (int)multimesh->stride_cache));
+
+	if (p_instances.is_empty()) {
+		return;
+	}
+
+	int stride = multimesh->stride_cache;
+	float *cache_data = multimesh->buffer.ptrw();
+	for (int i = 0; i < p_instances.size(); i++) {
+		int offset = p_instances[i] * stride;
+		ERR_CONTINUE(offset < 0 || offset + stride > multimesh->buffer.size());
+		memcpy(cache_data + offset, p_buffer.ptr() + i * stride, stride * sizeof(float));
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
 
 	return multimesh->buffer;
 }
+
+Dependency *MeshStorage::multimesh_get_dependency(RID p_multimesh) const {
+	DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL_V(multimesh, nullptr);
+
+	return &multimesh->dependency;
+}
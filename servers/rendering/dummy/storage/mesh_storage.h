@@ -34,6 +34,7 @@
 #include "core/templates/local_vector.h"
 #include "core/templates/rid_owner.h"
 #include "servers/rendering/storage/mesh_storage.h"
+#include "servers/rendering/storage/utilities.h"
 
 namespace RendererDummy {
 
@@ -46,12 +47,17 @@ private:
 		int blend_shape_count;
 		RS::BlendShapeMode blend_shape_mode;
 		PackedFloat32Array blend_shape_values;
+		AABB custom_aabb;
+		Dependency dependency;
 	};
 
 	mutable RID_Owner<DummyMesh> mesh_owner;
 
 	struct DummyMultiMesh {
 		PackedFloat32Array buffer;
+		uint32_t stride_cache = 0;
+		AABB custom_aabb;
+		Dependency dependency;
 	};
 
 	mutable RID_Owner<DummyMultiMesh> multimesh_owner;
@@ -93,6 +99,8 @@ public:
 		s->blend_shape_data = p_surface.blend_shape_data;
 		s->uv_scale = p_surface.uv_scale;
 		s->material = p_surface.material;
+
+		m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
 	}
 
 	virtual int mesh_get_blend_shape_count(RID p_mesh) const override { return 0; }
@@ -121,9 +129,37 @@ public:
 		return m->surfaces.size();
 	}
 
-	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {}
-	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override { return AABB(); }
-	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override { return AABB(); }
+	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL(m);
+		m->custom_aabb = p_aabb;
+		m->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
+	}
+
+	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL_V(m, AABB());
+		return m->custom_aabb;
+	}
+
+	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override {
+		DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+		ERR_FAIL_NULL_V(m, AABB());
+		if (m->custom_aabb != AABB()) {
+			return m->custom_aabb;
+		}
+
+		// Built from the surfaces on demand, so headless scene culling works on real bounds that can't go stale.
+		AABB aabb;
+		for (int i = 0; i < m->surfaces.size(); i++) {
+			if (i == 0) {
+				aabb = m->surfaces[i].aabb;
+			} else {
+				aabb.merge_with(m->surfaces[i].aabb);
+			}
+		}
+		return aabb;
+	}
 
 	virtual void mesh_set_path(RID p_mesh, const String &p_path) override {}
 	virtual String mesh_get_path(RID p_mesh) const override { return String(); }
@@ -131,6 +167,8 @@ public:
 	virtual void mesh_set_shadow_mesh(RID p_mesh, RID p_shadow_mesh) override {}
 	virtual void mesh_clear(RID p_mesh) override;
 
+	Dependency *mesh_get_dependency(RID p_mesh) const;
+
 	/* MESH INSTANCE */
 
 	virtual RID mesh_instance_create(RID p_base) override { return RID(); }
@@ -150,7 +188,7 @@ public:
 	virtual void multimesh_initialize(RID p_rid) override;
 	virtual void multimesh_free(RID p_rid) override;
 
-	virtual void multimesh_allocate_data(RID p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, bool p_use_colors = false, bool p_use_custom_data = false) override {}
+	virtual void multimesh_allocate_data(RID p_multimesh, int p_instances, RS::MultimeshTransformFormat p_transform_format, bool p_use_colors = false, bool p_use_custom_data = false) override;
 	virtual int multimesh_get_instance_count(RID p_multimesh) const override { return 0; }
 
 	virtual void multimesh_set_mesh(RID p_multimesh, RID p_mesh) override {}
@@ -159,22 +197,36 @@ public:
 	virtual void multimesh_instance_set_color(RID p_multimesh, int p_index, const Color &p_color) override {}
 	virtual void multimesh_instance_set_custom_data(RID p_multimesh, int p_index, const Color &p_color) override {}
 
-	virtual void multimesh_set_custom_aabb(RID p_multimesh, const AABB &p_aabb) override {}
-	virtual AABB multimesh_get_custom_aabb(RID p_multimesh) const override { return AABB(); }
+	virtual void multimesh_set_custom_aabb(RID p_multimesh, const AABB &p_aabb) override {
+		DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		ERR_FAIL_NULL(multimesh);
+		multimesh->custom_aabb = p_aabb;
+		multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
+	}
+
+	virtual AABB multimesh_get_custom_aabb(RID p_multimesh) const override {
+		DummyMultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+		ERR_FAIL_NULL_V(multimesh, AABB());
+		return multimesh->custom_aabb;
+	}
 
 	virtual RID multimesh_get_mesh(RID p_multimesh) const override { return RID(); }
-	virtual AABB multimesh_get_aabb(RID p_multimesh) const override { return AABB(); }
+	// Instance bounds are not tracked, so only a custom AABB gives culling anything to work with.
+	virtual AABB multimesh_get_aabb(RID p_multimesh) const override { return multimesh_get_custom_aabb(p_multimesh); }
 
 	virtual Transform3D multimesh_instance_get_transform(RID p_multimesh, int p_index) const override { return Transform3D(); }
 	virtual Transform2D multimesh_instance_get_transform_2d(RID p_multimesh, int p_index) const override { return Transform2D(); }
 	virtual Color multimesh_instance_get_color(RID p_multimesh, int p_index) const override { return Color(); }
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override { return Color(); }
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_instances(RID p_multimesh, const Vector<int> &p_instances, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override {}
 	virtual int multimesh_get_visible_instances(RID p_multimesh) const override { return 0; }
 
+	Dependency *multimesh_get_dependency(RID p_multimesh) const;
+
 	/* SKELETON API */
 
 	virtual RID skeleton_allocate() override { return RID(); }
@@ -30,6 +30,8 @@
 
 #include "texture_storage.h"
 
+#include "core/config/project_settings.h"
+
 using namespace RendererDummy;
 
 TextureStorage *TextureStorage::singleton = nullptr;
@@ -41,3 +43,34 @@ TextureStorage::TextureStorage() {
 TextureStorage::~TextureStorage() {
 	singleton = nullptr;
 }
+
+/* RENDER TARGET API */
+
+RID TextureStorage::render_target_create() {
+	if (!GLOBAL_GET("rendering/headless/run_scene_culling")) {
+		return RID();
+	}
+	return render_target_owner.make_rid(DummyRenderTarget());
+}
+
+void TextureStorage::render_target_free(RID p_rid) {
+	if (render_target_owner.owns(p_rid)) {
+		render_target_owner.free(p_rid);
+	}
+}
+
+void TextureStorage::render_target_set_size(RID p_render_target, int p_width, int p_height, uint32_t p_view_count) {
+	DummyRenderTarget *rt = render_target_owner.get_or_null(p_render_target);
+	if (!rt) {
+		return; // Render targets are not created unless headless scene culling is enabled.
+	}
+	rt->size = Size2i(p_width, p_height);
+}
+
+Size2i TextureStorage::render_target_get_size(RID p_render_target) const {
+	DummyRenderTarget *rt = render_target_owner.get_or_null(p_render_target);
+	if (!rt) {
+		return Size2i();
+	}
+	return rt->size;
+}
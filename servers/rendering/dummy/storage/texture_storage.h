@@ -45,6 +45,13 @@ private:
 	};
 	mutable RID_PtrOwner<DummyTexture> texture_owner;
 
+	// Render targets are only tracked when headless scene culling is enabled,
+	// otherwise viewports are skipped entirely.
+	struct DummyRenderTarget {
+		Size2i size;
+	};
+	mutable RID_Owner<DummyRenderTarget> render_target_owner;
+
 public:
 	static TextureStorage *get_singleton() { return singleton; }
 
@@ -161,12 +168,12 @@ public:
 
 	/* RENDER TARGET */
 
-	virtual RID render_target_create() override { return RID(); }
-	virtual void render_target_free(RID p_rid) override {}
+	virtual RID render_target_create() override;
+	virtual void render_target_free(RID p_rid) override;
 	virtual void render_target_set_position(RID p_render_target, int p_x, int p_y) override {}
 	virtual Point2i render_target_get_position(RID p_render_target) const override { return Point2i(); }
-	virtual void render_target_set_size(RID p_render_target, int p_width, int p_height, uint32_t p_view_count) override {}
-	virtual Size2i render_target_get_size(RID p_render_target) const override { return Size2i(); }
+	virtual void render_target_set_size(RID p_render_target, int p_width, int p_height, uint32_t p_view_count) override;
+	virtual Size2i render_target_get_size(RID p_render_target) const override;
 	virtual void render_target_set_transparent(RID p_render_target, bool p_is_transparent) override {}
 	virtual bool render_target_get_transparent(RID p_render_target) const override { return false; }
 	virtual void render_target_set_direct_to_screen(RID p_render_target, bool p_direct_to_screen) override {}
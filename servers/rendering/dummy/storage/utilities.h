@@ -78,7 +78,15 @@ public:
 
 	/* DEPENDENCIES */
 
-	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {}
+	virtual void base_update_dependency(RID p_base, DependencyTracker *p_instance) override {
+		if (RendererDummy::MeshStorage::get_singleton()->owns_mesh(p_base)) {
+			Dependency *dependency = RendererDummy::MeshStorage::get_singleton()->mesh_get_dependency(p_base);
+			p_instance->update_dependency(dependency);
+		} else if (RendererDummy::MeshStorage::get_singleton()->owns_multimesh(p_base)) {
+			Dependency *dependency = RendererDummy::MeshStorage::get_singleton()->multimesh_get_dependency(p_base);
+			p_instance->update_dependency(dependency);
+		}
+	}
 
 	/* VISIBILITY NOTIFIER */
 
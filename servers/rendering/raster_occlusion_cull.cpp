@@ -0,0 +1,580 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+RasterOcclusionCull *RasterOcclusionCull::raster_singleton = nullptr;
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	tile_triangles.clear();
+	triangles.clear();
+	thread_triangles.clear();
+	has_depth = false;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+	has_depth = false;
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	tile_triangles.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_bin_triangles() {
+	for (LocalVector<uint32_t> &tile : tile_triangles) {
+		tile.clear();
+	}
+
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const Triangle &triangle = triangles[i];
+		for (int tile_y = triangle.min_y / TILE_SIZE; tile_y <= triangle.max_y / TILE_SIZE; tile_y++) {
+			for (int tile_x = triangle.min_x / TILE_SIZE; tile_x <= triangle.max_x / TILE_SIZE; tile_x++) {
+				tile_triangles[tile_y * tile_grid_size.x + tile_x].push_back(i);
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const LocalVector<Triangle> *p_triangles) {
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+
+	float tile_depth[TILE_PIXELS];
+	for (int i = 0; i < TILE_PIXELS; i++) {
+		tile_depth[i] = FLT_MAX;
+	}
+
+	for (uint32_t triangle_index : tile_triangles[p_tile]) {
+		const Triangle &triangle = (*p_triangles)[triangle_index];
+
+		// The triangle is set up relative to the center of the first tile pixel, in double precision,
+		// since the vertices of triangles crossing the near plane can be very far outside the screen.
+		double points[3][2];
+		for (int i = 0; i < 3; i++) {
+			points[i][0] = double(triangle.points[i].x) - (tile_x + 0.5);
+			points[i][1] = double(triangle.points[i].y) - (tile_y + 0.5);
+		}
+
+		// Edge function i is positive on the inner side of the edge opposite to vertex i,
+		// and equal to the triangle area on that vertex.
+		double edges[3][3];
+		for (int i = 0; i < 3; i++) {
+			const double *a = points[(i + 1) % 3];
+			const double *b = points[(i + 2) % 3];
+			edges[i][0] = a[1] - b[1];
+			edges[i][1] = b[0] - a[0];
+			edges[i][2] = a[0] * b[1] - a[1] * b[0];
+		}
+
+		const double area = edges[0][0] * points[0][0] + edges[0][1] * points[0][1] + edges[0][2];
+		if (area <= 0.0) {
+			continue;
+		}
+
+		// The depth, or its inverse, is interpolated with the edge functions divided by the area.
+		double depth_plane[3] = { 0.0, 0.0, 0.0 };
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				depth_plane[j] += edges[i][j] * triangle.depths[i] / area;
+			}
+		}
+
+		const float edge_dx[3] = { float(edges[0][0]), float(edges[1][0]), float(edges[2][0]) };
+		const float edge_dy[3] = { float(edges[0][1]), float(edges[1][1]), float(edges[2][1]) };
+		const float edge_c[3] = { float(edges[0][2]), float(edges[1][2]), float(edges[2][2]) };
+		const float depth_dx = depth_plane[0];
+		const float depth_dy = depth_plane[1];
+		const float depth_c = depth_plane[2];
+
+		const int y_from = MAX(triangle.min_y - tile_y, 0);
+		const int y_to = MIN(triangle.max_y - tile_y, TILE_SIZE - 1);
+
+		for (int y = y_from; y <= y_to; y++) {
+			const float row_edges[3] = {
+				edge_c[0] + edge_dy[0] * y,
+				edge_c[1] + edge_dy[1] * y,
+				edge_c[2] + edge_dy[2] * y
+			};
+			const float row_depth = depth_c + depth_dy * y;
+			float *row = &tile_depth[y * TILE_SIZE];
+
+			// Written without branches over the whole tile row, so the compiler can vectorize it.
+			for (int x = 0; x < TILE_SIZE; x++) {
+				const float w0 = row_edges[0] + edge_dx[0] * x;
+				const float w1 = row_edges[1] + edge_dx[1] * x;
+				const float w2 = row_edges[2] + edge_dx[2] * x;
+				const float z = row_depth + depth_dx * x;
+				const float depth = orthogonal ? z : 1.0f / z;
+				const bool inside = (w0 >= 0.0f) & (w1 >= 0.0f) & (w2 >= 0.0f) & (depth < row[x]);
+				row[x] = inside ? depth : row[x];
+			}
+		}
+	}
+
+	const int width = sizes[0].x;
+	const int copy_width = MIN(TILE_SIZE, width - tile_x);
+	const int copy_height = MIN(TILE_SIZE, sizes[0].y - tile_y);
+	for (int y = 0; y < copy_height; y++) {
+		memcpy(&mips[0][(tile_y + y) * width + tile_x], &tile_depth[y * TILE_SIZE], copy_width * sizeof(float));
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tiles(uint32_t p_task, const LocalVector<Triangle> *p_triangles) {
+	const uint32_t from = p_task * TILES_PER_TASK;
+	const uint32_t to = MIN(from + TILES_PER_TASK, tile_triangles.size());
+	for (uint32_t i = from; i < to; i++) {
+		_rasterize_tile(i, p_triangles);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(bool p_orthogonal, float p_z_far) {
+	ERR_FAIL_COND(is_empty());
+
+	orthogonal = p_orthogonal;
+	debug_tex_range = p_z_far;
+
+	_bin_triangles();
+
+	// Each tile is only written by one thread, so the result does not depend on the scheduling.
+	const uint32_t task_count = (tile_triangles.size() + TILES_PER_TASK - 1) / TILES_PER_TASK;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tiles, &triangles, task_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	update_mips();
+	has_depth = true;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::clear_depth() {
+	if (!has_depth) {
+		return; // Already cleared
+	}
+
+	for (float &depth : data) {
+		depth = FLT_MAX;
+	}
+	has_depth = false;
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		RID scenario_rid = E.scenario;
+		RID instance_rid = E.instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The active instances change, but the instance doesn't need update
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	occ_inst->xformed_vertices.clear();
+	occ_inst->indices.clear();
+
+	Occluder *occ = raster_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		return;
+	}
+
+	const int vertices_size = occ->vertices.size();
+	const int indices_size = occ->indices.size() - occ->indices.size() % 3;
+
+	const int32_t *indices_ptr = occ->indices.ptr();
+	for (int i = 0; i < indices_size; i++) {
+		ERR_FAIL_INDEX_MSG(indices_ptr[i], vertices_size, "Occluder mesh indices are out of bounds.");
+	}
+
+	occ_inst->xformed_vertices.resize(vertices_size);
+	const Vector3 *read_ptr = occ->vertices.ptr();
+	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	for (int i = 0; i < vertices_size; i++) {
+		write_ptr[i] = occ_inst->xform.xform(read_ptr[i]);
+	}
+
+	occ_inst->indices.resize(indices_size);
+	memcpy(occ_inst->indices.ptr(), indices_ptr, indices_size * sizeof(int32_t));
+}
+
+void RasterOcclusionCull::Scenario::update() {
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return;
+	}
+
+	for (const RID &instance : removed_instances) {
+		instances.erase(instance);
+	}
+
+	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RasterOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	active_instances.clear();
+	for (const KeyValue<RID, OccluderInstance> &E : instances) {
+		if (E.value.enabled && !E.value.indices.is_empty()) {
+			active_instances.push_back(&E.value);
+		}
+	}
+
+	dirty = false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_setup_triangles_threaded(uint32_t p_thread, const SetupThreadData *p_data) {
+	uint32_t total_instances = p_data->scenario->active_instances.size();
+	uint32_t total_threads = p_data->thread_count;
+	uint32_t from = p_thread * total_instances / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total_instances : ((p_thread + 1) * total_instances / total_threads);
+	_setup_triangles(p_data, from, to, p_data->buffer->thread_triangles[p_thread]);
+}
+
+void RasterOcclusionCull::_setup_triangles(const SetupThreadData *p_data, uint32_t p_from, uint32_t p_to, LocalVector<Triangle> &r_triangles) {
+	r_triangles.clear();
+
+	const Vector2 half_size = Vector2(p_data->buffer_size) * 0.5f;
+	const float max_x = p_data->buffer_size.x - 1;
+	const float max_y = p_data->buffer_size.y - 1;
+
+	LocalVector<Vector3> view_vertices;
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const OccluderInstance *occ_inst = p_data->scenario->active_instances[i];
+
+		view_vertices.resize(occ_inst->xformed_vertices.size());
+		for (uint32_t j = 0; j < view_vertices.size(); j++) {
+			view_vertices[j] = p_data->cam_inv_transform.xform(occ_inst->xformed_vertices[j]);
+		}
+
+		for (uint32_t j = 0; j < occ_inst->indices.size(); j += 3) {
+			// Clip the triangle against the near plane, which gives at most a quad.
+			Vector3 polygon[4];
+			int polygon_size = 0;
+			for (int k = 0; k < 3; k++) {
+				const Vector3 &current = view_vertices[occ_inst->indices[j + k]];
+				const Vector3 &next = view_vertices[occ_inst->indices[j + (k + 1) % 3]];
+				const real_t current_distance = -current.z - p_data->z_near;
+				const real_t next_distance = -next.z - p_data->z_near;
+
+				if (current_distance >= 0.0) {
+					polygon[polygon_size++] = current;
+				}
+				if ((current_distance >= 0.0) != (next_distance >= 0.0)) {
+					polygon[polygon_size++] = current + (next - current) * (current_distance / (current_distance - next_distance));
+				}
+			}
+
+			if (polygon_size < 3) {
+				continue;
+			}
+
+			Vector2 points[4];
+			float depths[4];
+			for (int k = 0; k < polygon_size; k++) {
+				const Vector4 clip = p_data->cam_projection.xform(Vector4(polygon[k].x, polygon[k].y, polygon[k].z, 1.0));
+				points[k] = (Vector2(clip.x, clip.y) / clip.w + Vector2(1.0, 1.0)) * half_size;
+				depths[k] = p_data->orthogonal ? -polygon[k].z : 1.0 / -polygon[k].z;
+			}
+
+			for (int k = 2; k < polygon_size; k++) {
+				Triangle triangle;
+				triangle.points[0] = points[0];
+				triangle.points[1] = points[k - 1];
+				triangle.points[2] = points[k];
+				triangle.depths[0] = depths[0];
+				triangle.depths[1] = depths[k - 1];
+				triangle.depths[2] = depths[k];
+
+				// Occluders are double sided, make all the triangles wind the same way.
+				const real_t area = (triangle.points[1] - triangle.points[0]).cross(triangle.points[2] - triangle.points[0]);
+				if (Math::is_zero_approx(area)) {
+					continue;
+				}
+				if (area < 0.0) {
+					SWAP(triangle.points[1], triangle.points[2]);
+					SWAP(triangle.depths[1], triangle.depths[2]);
+				}
+
+				// The pixels whose centers may be covered by the triangle.
+				Vector2 min = triangle.points[0].min(triangle.points[1]).min(triangle.points[2]);
+				Vector2 max = triangle.points[0].max(triangle.points[1]).max(triangle.points[2]);
+				min = (min - Vector2(0.5, 0.5)).ceil();
+				max = (max - Vector2(0.5, 0.5)).floor();
+				if (max.x < 0.0 || max.y < 0.0 || min.x > max_x || min.y > max_y || min.x > max.x || min.y > max.y) {
+					continue;
+				}
+
+				triangle.min_x = MAX(min.x, 0.0);
+				triangle.min_y = MAX(min.y, 0.0);
+				triangle.max_x = MIN(max.x, max_x);
+				triangle.max_y = MIN(max.y, max_y);
+				r_triangles.push_back(triangle);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+	scenario.update();
+
+	if (scenario.active_instances.is_empty()) {
+		// Nothing to rasterize, the depth from the last update is cleared so it doesn't occlude anything.
+		buffer.clear_depth();
+		return;
+	}
+
+	SetupThreadData td;
+	td.thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	td.scenario = &scenario;
+	td.buffer = &buffer;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_projection = _jitter_projection(p_cam_projection, buffer.get_occlusion_buffer_size());
+	td.z_near = p_cam_projection.get_z_near();
+	td.buffer_size = buffer.get_occlusion_buffer_size();
+	td.orthogonal = p_cam_orthogonal;
+
+	buffer.thread_triangles.resize(td.thread_count);
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterOcclusionCull::_setup_triangles_threaded, &td, td.thread_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	uint32_t triangle_count = 0;
+	for (const LocalVector<Triangle> &triangles : buffer.thread_triangles) {
+		triangle_count += triangles.size();
+	}
+	buffer.triangles.resize(triangle_count);
+	triangle_count = 0;
+	for (const LocalVector<Triangle> &triangles : buffer.thread_triangles) {
+		memcpy(buffer.triangles.ptr() + triangle_count, triangles.ptr(), triangles.size() * sizeof(Triangle));
+		triangle_count += triangles.size();
+	}
+
+	buffer.rasterize(p_cam_orthogonal, p_cam_projection.get_z_far());
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
+
+////////////////////////////////////////////////////////
+
+RasterOcclusionCull::RasterOcclusionCull() {
+	raster_singleton = this;
+}
+
+RasterOcclusionCull::~RasterOcclusionCull() {
+	if (raster_singleton == this) {
+		raster_singleton = nullptr;
+	}
+}
@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Portable occlusion culling backend, used when the raycast module is not available.
+// The occluder triangles are rasterized on the CPU into the depth buffer of the HZBuffer.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+	static const int TILE_SIZE = 16;
+	static const int TILE_PIXELS = TILE_SIZE * TILE_SIZE;
+	// Tiles rasterized by each worker task, so small tiles don't cost more to schedule than to rasterize.
+	static const int TILES_PER_TASK = 8;
+
+public:
+	// A screen space triangle, with its vertices in pixels and their view depth,
+	// or its inverse for perspective projections, where it varies linearly across the screen.
+	struct Triangle {
+		Vector2 points[3];
+		float depths[3];
+		int min_x = 0;
+		int min_y = 0;
+		int max_x = 0;
+		int max_y = 0;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+	private:
+		Size2i tile_grid_size;
+		LocalVector<LocalVector<uint32_t>> tile_triangles;
+		bool orthogonal = false;
+		bool has_depth = false;
+
+		void _bin_triangles();
+		void _rasterize_tile(uint32_t p_tile, const LocalVector<Triangle> *p_triangles);
+		void _rasterize_tiles(uint32_t p_task, const LocalVector<Triangle> *p_triangles);
+
+	public:
+		RID scenario_rid;
+		LocalVector<Triangle> triangles;
+		// Triangles set up by each thread, before they are gathered into triangles.
+		LocalVector<LocalVector<Triangle>> thread_triangles;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+		void rasterize(bool p_orthogonal, float p_z_far);
+		void clear_depth();
+
+		const float *get_depth() const { return mips.is_empty() ? nullptr : mips[0]; }
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		static uint32_t hash(const InstanceID &p_ins) {
+			uint32_t h = hash_murmur3_one_64(p_ins.scenario.get_id());
+			return hash_fmix32(hash_murmur3_one_64(p_ins.instance.get_id(), h));
+		}
+		bool operator==(const InstanceID &rhs) const {
+			return instance == rhs.instance && rhs.scenario == scenario;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		HashSet<InstanceID, InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		HashSet<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+
+		// The enabled instances with an occluder, rebuilt when any instance changes.
+		LocalVector<const OccluderInstance *> active_instances;
+		bool dirty = false;
+
+		void _update_dirty_instance(uint32_t p_idx, RID *p_instances);
+		void update();
+	};
+
+	struct SetupThreadData {
+		uint32_t thread_count = 0;
+		const Scenario *scenario = nullptr;
+		RasterHZBuffer *buffer = nullptr;
+		Transform3D cam_inv_transform;
+		Projection cam_projection;
+		float z_near = 0.0;
+		Size2i buffer_size;
+		bool orthogonal = false;
+	};
+
+	static RasterOcclusionCull *raster_singleton;
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _setup_triangles_threaded(uint32_t p_thread, const SetupThreadData *p_data);
+	void _setup_triangles(const SetupThreadData *p_data, uint32_t p_from, uint32_t p_to, LocalVector<Triangle> &r_triangles);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+
+	RasterOcclusionCull();
+	~RasterOcclusionCull();
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
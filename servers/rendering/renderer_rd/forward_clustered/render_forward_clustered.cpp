@@ -476,7 +476,20 @@ void RenderForwardClustered::_render_list_template(RenderingDevice::DrawListID p
 			prev_index_array_rd = index_array_rd;
 		}
 
-		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, 0, pipeline_specialization);
+		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, 0, pipeline_specialization, !async_pipeline_compilation);
+
+		if (unlikely(pipeline_rd.is_null())) {
+			// Still compiling, fall back to an already compiled version without the optional specializations,
+			// or skip the surface until either is ready.
+			should_request_redraw = true;
+			uint32_t fallback_specialization = pipeline_specialization & ~SceneShaderForwardClustered::SHADER_SPECIALIZATION_OPTIONAL_MASK;
+			if (fallback_specialization != pipeline_specialization) {
+				pipeline_rd = pipeline->get_compiled_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, 0, fallback_specialization);
+			}
+			if (pipeline_rd.is_null()) {
+				continue;
+			}
+		}
 
 		if (pipeline_rd != prev_pipeline_rd) {
 			// checking with prev shader does not make so much sense, as
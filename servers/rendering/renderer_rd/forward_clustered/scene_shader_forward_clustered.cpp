@@ -178,6 +178,8 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	print_line("\n**vertex_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX]);
 	print_line("\n**fragment_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
 #endif
+	// Pipelines still compiling in the background need the previous shader variants.
+	_clear_pipelines();
 	shader_singleton->shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX], gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], gen_code.defines);
 	ERR_FAIL_COND(!shader_singleton->shader.version_is_valid(version));
 
@@ -409,6 +411,19 @@ void SceneShaderForwardClustered::ShaderData::set_code(const String &p_code) {
 	valid = true;
 }
 
+void SceneShaderForwardClustered::ShaderData::_clear_pipelines() {
+	for (int i = 0; i < CULL_VARIANT_MAX; i++) {
+		for (int j = 0; j < RS::PRIMITIVE_MAX; j++) {
+			for (int k = 0; k < PIPELINE_VERSION_MAX; k++) {
+				pipelines[i][j][k].clear();
+			}
+			for (int k = 0; k < PIPELINE_COLOR_PASS_FLAG_COUNT; k++) {
+				color_pipelines[i][j][k].clear();
+			}
+		}
+	}
+}
+
 bool SceneShaderForwardClustered::ShaderData::is_animated() const {
 	return (uses_fragment_time && uses_discard) || (uses_vertex_time && uses_vertex);
 }
@@ -434,7 +449,8 @@ SceneShaderForwardClustered::ShaderData::ShaderData() :
 SceneShaderForwardClustered::ShaderData::~ShaderData() {
 	SceneShaderForwardClustered *shader_singleton = (SceneShaderForwardClustered *)SceneShaderForwardClustered::singleton;
 	ERR_FAIL_NULL(shader_singleton);
-	//pipeline variants will clear themselves if shader is gone
+	// Done before freeing the shader, as pipelines may still be compiling in the background.
+	_clear_pipelines();
 	if (version.is_valid()) {
 		shader_singleton->shader.version_free(version);
 	}
@@ -100,6 +100,10 @@ public:
 		SHADER_SPECIALIZATION_DIRECTIONAL_SOFT_SHADOWS = 1 << 3,
 	};
 
+	// Specializations that only pick a higher quality path and don't change which resources the shader reads.
+	// A pipeline without them can stand in for one that is still compiling.
+	static constexpr uint32_t SHADER_SPECIALIZATION_OPTIONAL_MASK = SHADER_SPECIALIZATION_PROJECTOR | SHADER_SPECIALIZATION_SOFT_SHADOWS | SHADER_SPECIALIZATION_DIRECTIONAL_SOFT_SHADOWS;
+
 	struct ShaderData : public RendererRD::MaterialStorage::ShaderData {
 		enum BlendMode { //used internally
 			BLEND_MODE_MIX,
@@ -188,6 +192,8 @@ public:
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _clear_pipelines();
+
 		virtual void set_code(const String &p_Code);
 
 		virtual bool is_animated() const;
@@ -2196,7 +2196,20 @@ void RenderForwardMobile::_render_list_template(RenderingDevice::DrawListID p_dr
 			prev_index_array_rd = index_array_rd;
 		}
 
-		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, p_params->subpass, base_spec_constants);
+		RID pipeline_rd = pipeline->get_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, p_params->subpass, base_spec_constants, !async_pipeline_compilation);
+
+		if (unlikely(pipeline_rd.is_null())) {
+			// Still compiling, fall back to an already compiled version without the optional specializations,
+			// or skip the surface until either is ready.
+			should_request_redraw = true;
+			uint32_t fallback_spec_constants = base_spec_constants & ~SPEC_CONSTANT_OPTIONAL_MASK;
+			if (fallback_spec_constants != base_spec_constants) {
+				pipeline_rd = pipeline->get_compiled_render_pipeline(vertex_format, framebuffer_format, p_params->force_wireframe, p_params->subpass, fallback_spec_constants);
+			}
+			if (pipeline_rd.is_null()) {
+				continue;
+			}
+		}
 
 		if (pipeline_rd != prev_pipeline_rd) {
 			// checking with prev shader does not make so much sense, as
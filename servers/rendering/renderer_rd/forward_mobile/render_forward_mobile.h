@@ -84,6 +84,10 @@ private:
 
 	};
 
+	// Per-surface specializations that only pick a higher quality path or skip work for lights, probes and decals
+	// the surface doesn't have. A pipeline without them can stand in for one that is still compiling.
+	static constexpr uint32_t SPEC_CONSTANT_OPTIONAL_MASK = (1 << SPEC_CONSTANT_USING_PROJECTOR) | (1 << SPEC_CONSTANT_USING_SOFT_SHADOWS) | (1 << SPEC_CONSTANT_DISABLE_OMNI_LIGHTS) | (1 << SPEC_CONSTANT_DISABLE_SPOT_LIGHTS) | (1 << SPEC_CONSTANT_DISABLE_REFLECTION_PROBES) | (1 << SPEC_CONSTANT_DISABLE_DECALS);
+
 	enum {
 		MAX_LIGHTMAPS = 8,
 		MAX_RDL_CULL = 8, // maximum number of reflection probes, decals or lights we can cull per geometry instance
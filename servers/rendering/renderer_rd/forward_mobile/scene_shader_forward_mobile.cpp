@@ -189,6 +189,8 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 	print_line("\n**fragment_globals:\n" + gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT]);
 #endif
 
+	// Pipelines still compiling in the background need the previous shader variants.
+	_clear_pipelines();
 	shader_singleton->shader.version_set_code(version, gen_code.code, gen_code.uniforms, gen_code.stage_globals[ShaderCompiler::STAGE_VERTEX], gen_code.stage_globals[ShaderCompiler::STAGE_FRAGMENT], gen_code.defines);
 	ERR_FAIL_COND(!shader_singleton->shader.version_is_valid(version));
 
@@ -361,6 +363,16 @@ void SceneShaderForwardMobile::ShaderData::set_code(const String &p_code) {
 	valid = true;
 }
 
+void SceneShaderForwardMobile::ShaderData::_clear_pipelines() {
+	for (int i = 0; i < CULL_VARIANT_MAX; i++) {
+		for (int j = 0; j < RS::PRIMITIVE_MAX; j++) {
+			for (int k = 0; k < SHADER_VERSION_MAX; k++) {
+				pipelines[i][j][k].clear();
+			}
+		}
+	}
+}
+
 bool SceneShaderForwardMobile::ShaderData::is_animated() const {
 	return (uses_fragment_time && uses_discard) || (uses_vertex_time && uses_vertex);
 }
@@ -386,7 +398,8 @@ SceneShaderForwardMobile::ShaderData::ShaderData() :
 SceneShaderForwardMobile::ShaderData::~ShaderData() {
 	SceneShaderForwardMobile *shader_singleton = (SceneShaderForwardMobile *)SceneShaderForwardMobile::singleton;
 	ERR_FAIL_NULL(shader_singleton);
-	//pipeline variants will clear themselves if shader is gone
+	// Done before freeing the shader, as pipelines may still be compiling in the background.
+	_clear_pipelines();
 	if (version.is_valid()) {
 		shader_singleton->shader.version_free(version);
 	}
@@ -140,6 +140,8 @@ public:
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _clear_pipelines();
+
 		virtual void set_code(const String &p_Code);
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
@@ -32,7 +32,7 @@
 
 #include "core/os/memory.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
@@ -57,20 +57,79 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
-	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+void PipelineCacheRD::_add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline) {
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
-	versions[version_count].pipeline = pipeline;
+	versions[version_count].wireframe = p_wireframe;
+	versions[version_count].pipeline = p_pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
 	version_count++;
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	_add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, pipeline);
 	return pipeline;
 }
 
+RID PipelineCacheRD::_generate_version_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	for (uint32_t i = 0; i < compilations.size(); i++) {
+		Compilation *compilation = compilations[i];
+		if (compilation->vertex_id == p_vertex_format_id && compilation->framebuffer_id == p_framebuffer_format_id && compilation->wireframe == p_wireframe && compilation->render_pass == p_render_pass && compilation->bool_specializations == p_bool_specializations) {
+			if (compilation->task_id == WorkerThreadPool::INVALID_TASK_ID || !WorkerThreadPool::get_singleton()->is_task_completed(compilation->task_id)) {
+				// Either still compiling or failed before.
+				return RID();
+			}
+
+			// The task is done, so this only releases it.
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(compilation->task_id);
+			RID pipeline = compilation->pipeline;
+			if (pipeline.is_valid()) {
+				_add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, pipeline);
+				compilations.remove_at_unordered(i);
+				memdelete(compilation);
+			} else {
+				// Keep the failed compilation around, so it's not attempted again every frame.
+				compilation->task_id = WorkerThreadPool::INVALID_TASK_ID;
+			}
+			return pipeline;
+		}
+	}
+
+	Compilation *compilation = memnew(Compilation);
+	compilation->vertex_id = p_vertex_format_id;
+	compilation->framebuffer_id = p_framebuffer_format_id;
+	compilation->wireframe = p_wireframe;
+	compilation->render_pass = p_render_pass;
+	compilation->bool_specializations = p_bool_specializations;
+	compilation->task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &PipelineCacheRD::_compile_version_task, compilation, false, SNAME("PipelineCacheRD"));
+	compilations.push_back(compilation);
+	return RID();
+}
+
+void PipelineCacheRD::_compile_version_task(Compilation *p_compilation) {
+	p_compilation->pipeline = _create_pipeline(p_compilation->vertex_id, p_compilation->framebuffer_id, p_compilation->wireframe, p_compilation->render_pass, p_compilation->bool_specializations);
+}
+
 void PipelineCacheRD::_clear() {
+	// Compilations read the current shader and states, so they must be done before those change.
+	for (Compilation *compilation : compilations) {
+		if (compilation->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(compilation->task_id);
+		}
+		if (compilation->pipeline.is_valid() && RD::get_singleton()->render_pipeline_is_valid(compilation->pipeline)) {
+			RD::get_singleton()->free(compilation->pipeline);
+		}
+		memdelete(compilation);
+	}
+	compilations.clear();
+
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
@@ -99,8 +158,8 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	base_specialization_constants = p_base_specialization_constants;
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
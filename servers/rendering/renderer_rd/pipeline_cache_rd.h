@@ -31,7 +31,9 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -60,7 +62,33 @@ class PipelineCacheRD {
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	// Versions being compiled on the worker thread pool, moved to versions once their task is done.
+	struct Compilation {
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass;
+		bool wireframe;
+		uint32_t bool_specializations;
+		RID pipeline;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	LocalVector<Compilation *> compilations;
+
+	_FORCE_INLINE_ RID _find_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) const {
+		for (uint32_t i = 0; i < version_count; i++) {
+			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+				return versions[i].pipeline;
+			}
+		}
+		return RID();
+	}
+
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline);
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	RID _generate_version_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _compile_version_task(Compilation *p_compilation);
 
 	void _clear();
 
@@ -69,7 +97,10 @@ public:
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
 	void update_shader(RID p_shader);
 
-	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
+	// If p_wait_for_compilation is false, a missing version is compiled on the worker thread pool instead
+	// and an invalid RID is returned until it is ready, so the caller can skip the draw or use another version.
+	// The compilation still holds the RenderingDevice lock, see RenderingDevice::render_pipeline_create().
+	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0, bool p_wait_for_compilation = true) {
 #ifdef DEBUG_ENABLED
 		ERR_FAIL_COND_V_MSG(shader.is_null(), RID(),
 				"Attempted to use an unused shader variant (shader is null),");
@@ -78,15 +109,25 @@ public:
 		spin_lock.lock();
 		p_wireframe |= rasterization_state.wireframe;
 
-		RID result;
-		for (uint32_t i = 0; i < version_count; i++) {
-			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
-				result = versions[i].pipeline;
-				spin_lock.unlock();
-				return result;
-			}
+		RID result = _find_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		if (result.is_valid()) {
+			spin_lock.unlock();
+			return result;
+		}
+		if (p_wait_for_compilation) {
+			result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		} else {
+			result = _generate_version_async(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 		}
-		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+		spin_lock.unlock();
+		return result;
+	}
+
+	// Returns the version only if it's already compiled, a missing one is neither compiled nor queued.
+	_FORCE_INLINE_ RID get_compiled_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
+		spin_lock.lock();
+		p_wireframe |= rasterization_state.wireframe;
+		RID result = _find_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 		spin_lock.unlock();
 		return result;
 	}
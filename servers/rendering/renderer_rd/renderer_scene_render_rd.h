@@ -76,6 +76,11 @@ protected:
 
 	bool use_physical_light_units = false;
 
+	/* PIPELINES */
+
+	// Compile missing material pipelines on the worker thread pool instead of stalling the frame.
+	bool async_pipeline_compilation = false;
+
 	////////////////////////////////
 
 	virtual RendererRD::ForwardIDStorage *create_forward_id_storage() { return memnew(RendererRD::ForwardIDStorage); };
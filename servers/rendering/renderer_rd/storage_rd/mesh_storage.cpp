@@ -1422,6 +1422,13 @@ void MeshStorage::multimesh_allocate_data(RID p_multimesh, int p_instances, RS::
 		multimesh->previous_data_cache_dirty_region_count = 0;
 	}
 
+	if (multimesh->data_cache_region_aabbs) {
+		memdelete_arr(multimesh->data_cache_region_aabbs);
+		multimesh->data_cache_region_aabbs = nullptr;
+		memdelete_arr(multimesh->data_cache_dirty_region_aabbs);
+		multimesh->data_cache_dirty_region_aabbs = nullptr;
+	}
+
 	multimesh->instances = p_instances;
 	multimesh->xform_format = p_transform_format;
 	multimesh->uses_colors = p_use_colors;
@@ -1576,6 +1583,10 @@ void MeshStorage::_multimesh_make_local(MultiMesh *multimesh) const {
 	multimesh->previous_data_cache_dirty_regions = memnew_arr(bool, data_cache_dirty_region_count);
 	memset(multimesh->previous_data_cache_dirty_regions, 0, data_cache_dirty_region_count * sizeof(bool));
 	multimesh->previous_data_cache_dirty_region_count = 0;
+
+	multimesh->data_cache_region_aabbs = memnew_arr(AABB, data_cache_dirty_region_count);
+	multimesh->data_cache_dirty_region_aabbs = memnew_arr(bool, data_cache_dirty_region_count);
+	memset(multimesh->data_cache_dirty_region_aabbs, 1, data_cache_dirty_region_count * sizeof(bool));
 }
 
 void MeshStorage::_multimesh_update_motion_vectors_data_cache(MultiMesh *multimesh) {
@@ -1625,6 +1636,7 @@ void MeshStorage::_multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool
 	}
 
 	if (p_aabb) {
+		multimesh->data_cache_dirty_region_aabbs[region_index] = true;
 		multimesh->aabb_dirty = true;
 	}
 
@@ -1648,6 +1660,10 @@ void MeshStorage::_multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, b
 	}
 
 	if (p_aabb) {
+		if (multimesh->data_cache_dirty_region_aabbs) {
+			uint32_t data_cache_dirty_region_count = Math::division_round_up(multimesh->instances, MULTIMESH_DIRTY_REGION_SIZE);
+			memset(multimesh->data_cache_dirty_region_aabbs, 1, data_cache_dirty_region_count * sizeof(bool));
+		}
 		multimesh->aabb_dirty = true;
 	}
 
@@ -1658,13 +1674,9 @@ void MeshStorage::_multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, b
 	}
 }
 
-void MeshStorage::_multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances) {
-	ERR_FAIL_COND(multimesh->mesh.is_null());
-	if (multimesh->custom_aabb != AABB()) {
-		return;
-	}
+AABB MeshStorage::_multimesh_get_instances_aabb(MultiMesh *multimesh, const AABB &p_mesh_aabb, const float *p_data, int p_instances) {
 	AABB aabb;
-	AABB mesh_aabb = mesh_get_aabb(multimesh->mesh);
+	const AABB &mesh_aabb = p_mesh_aabb;
 	for (int i = 0; i < p_instances; i++) {
 		const float *data = p_data + multimesh->stride_cache * i;
 		Transform3D t;
@@ -1700,7 +1712,52 @@ void MeshStorage::_multimesh_re_create_aabb(MultiMesh *multimesh, const float *p
 		}
 	}
 
-	multimesh->aabb = aabb;
+	return aabb;
+}
+
+void MeshStorage::_multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances) {
+	ERR_FAIL_COND(multimesh->mesh.is_null());
+	if (multimesh->custom_aabb != AABB()) {
+		return;
+	}
+
+	multimesh->aabb = _multimesh_get_instances_aabb(multimesh, mesh_get_aabb(multimesh->mesh), p_data, p_instances);
+}
+
+void MeshStorage::_multimesh_update_aabb_regions(MultiMesh *multimesh, const float *p_data, int p_instances) {
+	ERR_FAIL_COND(multimesh->mesh.is_null());
+	if (multimesh->custom_aabb != AABB()) {
+		return;
+	}
+
+	multimesh->aabb = _multimesh_merge_region_aabbs(multimesh, mesh_get_aabb(multimesh->mesh), p_data, p_instances);
+}
+
+AABB MeshStorage::_multimesh_merge_region_aabbs(MultiMesh *multimesh, const AABB &p_mesh_aabb, const float *p_data, int p_instances) {
+	uint32_t region_count = Math::division_round_up(p_instances, MULTIMESH_DIRTY_REGION_SIZE);
+	if (p_mesh_aabb != multimesh->data_cache_region_aabbs_mesh_aabb) {
+		// The mesh changed size, every region needs to be recomputed.
+		memset(multimesh->data_cache_dirty_region_aabbs, 1, region_count * sizeof(bool));
+		multimesh->data_cache_region_aabbs_mesh_aabb = p_mesh_aabb;
+	}
+
+	AABB aabb;
+	for (uint32_t i = 0; i < region_count; i++) {
+		if (multimesh->data_cache_dirty_region_aabbs[i]) {
+			uint32_t region_start = i * MULTIMESH_DIRTY_REGION_SIZE;
+			uint32_t region_instances = MIN((uint32_t)MULTIMESH_DIRTY_REGION_SIZE, p_instances - region_start);
+			multimesh->data_cache_region_aabbs[i] = _multimesh_get_instances_aabb(multimesh, p_mesh_aabb, p_data + region_start * multimesh->stride_cache, region_instances);
+			multimesh->data_cache_dirty_region_aabbs[i] = false;
+		}
+
+		if (i == 0) {
+			aabb = multimesh->data_cache_region_aabbs[i];
+		} else {
+			aabb.merge_with(multimesh->data_cache_region_aabbs[i]);
+		}
+	}
+
+	return aabb;
 }
 
 void MeshStorage::multimesh_instance_set_transform(RID p_multimesh, int p_index, const Transform3D &p_transform) {
@@ -1970,6 +2027,37 @@ void MeshStorage::multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_b
 	}
 }
 
+void MeshStorage::multimesh_set_buffer_instances(RID p_multimesh, const Vector<int> &p_instances, const Vector<float> &p_buffer) {
+	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
+	ERR_FAIL_NULL(multimesh);
+	ERR_FAIL_COND(p_buffer.size() != (p_instances.size() * (int)multimesh->stride_cache));
+
+	if (p_instances.is_empty()) {
+		return;
+	}
+
+	_multimesh_make_local(multimesh);
+
+	bool uses_motion_vectors = (RSG::viewport->get_num_viewports_with_motion_vectors() > 0);
+	if (uses_motion_vectors) {
+		_multimesh_enable_motion_vectors(multimesh);
+	}
+
+	_multimesh_update_motion_vectors_data_cache(multimesh);
+
+	// Only the regions containing the given instances are uploaded, and only their AABBs are recomputed.
+	float *w = multimesh->data_cache.ptrw() + multimesh->motion_vectors_current_offset * multimesh->stride_cache;
+	const int *instances = p_instances.ptr();
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		int index = instances[i];
+		ERR_CONTINUE(index < 0 || index >= multimesh->instances);
+
+		memcpy(w + index * multimesh->stride_cache, r + i * multimesh->stride_cache, multimesh->stride_cache * sizeof(float));
+		_multimesh_mark_dirty(multimesh, index, true);
+	}
+}
+
 Vector<float> MeshStorage::multimesh_get_buffer(RID p_multimesh) const {
 	MultiMesh *multimesh = multimesh_owner.get_or_null(p_multimesh);
 	ERR_FAIL_NULL_V(multimesh, Vector<float>());
@@ -2088,7 +2176,7 @@ void MeshStorage::_update_dirty_multimeshes() {
 				//aabb is dirty..
 				multimesh->aabb_dirty = false;
 				if (multimesh->custom_aabb == AABB()) {
-					_multimesh_re_create_aabb(multimesh, data, visible_instances);
+					_multimesh_update_aabb_regions(multimesh, data, visible_instances);
 					multimesh->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_AABB);
 				}
 			}
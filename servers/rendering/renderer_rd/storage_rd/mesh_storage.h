@@ -42,6 +42,8 @@
 namespace RendererRD {
 
 class MeshStorage : public RendererMeshStorage {
+	friend class TestMeshStorageInternalsAccessor;
+
 public:
 	enum DefaultRDBuffer {
 		DEFAULT_RD_BUFFER_VERTEX,
@@ -236,6 +238,9 @@ private:
 		uint32_t data_cache_dirty_region_count = 0;
 		bool *previous_data_cache_dirty_regions = nullptr;
 		uint32_t previous_data_cache_dirty_region_count = 0;
+		AABB *data_cache_region_aabbs = nullptr; // Merged into the AABB, so only regions that changed need to be recomputed.
+		bool *data_cache_dirty_region_aabbs = nullptr;
+		AABB data_cache_region_aabbs_mesh_aabb;
 
 		RID buffer; //storage buffer
 		RID uniform_set_3d;
@@ -257,7 +262,10 @@ private:
 	_FORCE_INLINE_ bool _multimesh_uses_motion_vectors(MultiMesh *multimesh);
 	_FORCE_INLINE_ void _multimesh_mark_dirty(MultiMesh *multimesh, int p_index, bool p_aabb);
 	_FORCE_INLINE_ void _multimesh_mark_all_dirty(MultiMesh *multimesh, bool p_data, bool p_aabb);
+	_FORCE_INLINE_ static AABB _multimesh_get_instances_aabb(MultiMesh *multimesh, const AABB &p_mesh_aabb, const float *p_data, int p_instances);
 	_FORCE_INLINE_ void _multimesh_re_create_aabb(MultiMesh *multimesh, const float *p_data, int p_instances);
+	_FORCE_INLINE_ void _multimesh_update_aabb_regions(MultiMesh *multimesh, const float *p_data, int p_instances);
+	static AABB _multimesh_merge_region_aabbs(MultiMesh *multimesh, const AABB &p_mesh_aabb, const float *p_data, int p_instances);
 
 	/* Skeleton */
 
@@ -642,6 +650,7 @@ public:
 	virtual Color multimesh_instance_get_custom_data(RID p_multimesh, int p_index) const override;
 
 	virtual void multimesh_set_buffer(RID p_multimesh, const Vector<float> &p_buffer) override;
+	virtual void multimesh_set_buffer_instances(RID p_multimesh, const Vector<int> &p_instances, const Vector<float> &p_buffer) override;
 	virtual Vector<float> multimesh_get_buffer(RID p_multimesh) const override;
 
 	virtual void multimesh_set_visible_instances(RID p_multimesh, int p_visible) override;
@@ -87,6 +87,11 @@ public:
 
 		Transform3D transform;
 
+		// Results of the last cull, for profiling and server-side visibility queries.
+		bool record_visible_instances;
+		LocalVector<ObjectID> visible_instances;
+		uint64_t cull_time_usec;
+
 		Camera() {
 			visible_layers = 0xFFFFFFFF;
 			fov = 75;
@@ -96,6 +101,8 @@ public:
 			size = 1.0;
 			offset = Vector2();
 			vaspect = false;
+			record_visible_instances = false;
+			cull_time_usec = 0;
 		}
 	};
 
@@ -113,6 +120,9 @@ public:
 	virtual void camera_set_camera_attributes(RID p_camera, RID p_attributes);
 	virtual void camera_set_compositor(RID p_camera, RID p_compositor);
 	virtual void camera_set_use_vertical_aspect(RID p_camera, bool p_enable);
+	virtual void camera_set_record_visible_instances(RID p_camera, bool p_enable);
+	virtual Vector<ObjectID> camera_get_visible_instances(RID p_camera) const;
+	virtual uint64_t camera_get_cull_time_usec(RID p_camera) const;
 	virtual bool is_camera(RID p_camera) const;
 
 	/* OCCLUDER API */
@@ -123,7 +133,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *fallback_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -222,6 +232,41 @@ public:
 
 			return true;
 		}
+
+		static const uint32_t FRUSTUM_BLOCK_SIZE = 8;
+
+		// Same test as in_frustum(), for up to FRUSTUM_BLOCK_SIZE bounds at once.
+		// The bounds are transposed first, so each plane is tested against the whole
+		// block in a single loop the compiler can vectorize.
+		// Bit k of the result is set when p_bounds[k] is in the frustum.
+		_ALWAYS_INLINE_ static uint32_t in_frustum_block(const InstanceBounds *const *p_bounds, uint32_t p_count, const Frustum &p_frustum) {
+			real_t block_bounds[6][FRUSTUM_BLOCK_SIZE];
+			for (uint32_t k = 0; k < FRUSTUM_BLOCK_SIZE; k++) {
+				const real_t *bounds = p_bounds[MIN(k, p_count - 1)]->bounds;
+				for (uint32_t j = 0; j < 6; j++) {
+					block_bounds[j][k] = bounds[j];
+				}
+			}
+
+			uint8_t outside[FRUSTUM_BLOCK_SIZE] = {};
+			for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+				const Plane &plane = p_frustum.planes_ptr[i];
+				const real_t *x = block_bounds[p_frustum.plane_signs_ptr[i].signs[0]];
+				const real_t *y = block_bounds[p_frustum.plane_signs_ptr[i].signs[1]];
+				const real_t *z = block_bounds[p_frustum.plane_signs_ptr[i].signs[2]];
+
+				for (uint32_t k = 0; k < FRUSTUM_BLOCK_SIZE; k++) {
+					outside[k] |= (plane.normal.x * x[k] + plane.normal.y * y[k] + plane.normal.z * z[k] - plane.d) >= 0.0;
+				}
+			}
+
+			uint32_t mask = 0;
+			for (uint32_t k = 0; k < p_count; k++) {
+				mask |= uint32_t(!outside[k]) << k;
+			}
+			return mask;
+		}
+
 		_ALWAYS_INLINE_ bool in_aabb(const AABB &p_aabb) const {
 			Vector3 end = p_aabb.position + p_aabb.size;
 
@@ -621,6 +666,7 @@ public:
 
 	SelfList<Instance>::List _instance_update_list;
 	void _instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_dependencies = false);
+	void _instance_set_transform(Instance *p_instance, const Transform3D &p_transform);
 
 	struct InstanceGeometryData : public InstanceBaseData {
 		RenderGeometryInstance *geometry_instance = nullptr;
@@ -891,6 +937,7 @@ public:
 		PagedArray<RID> voxel_gi_instances;
 		PagedArray<RID> mesh_instances;
 		PagedArray<RID> fog_volumes;
+		PagedArray<Instance *> visible_instances; // Only filled when recording for a camera.
 
 		struct DirectionalShadow {
 			PagedArray<RenderGeometryInstance *> cascade_geometry_instances[RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
@@ -909,6 +956,7 @@ public:
 			voxel_gi_instances.clear();
 			mesh_instances.clear();
 			fog_volumes.clear();
+			visible_instances.clear();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].clear();
@@ -934,6 +982,7 @@ public:
 			voxel_gi_instances.reset();
 			mesh_instances.reset();
 			fog_volumes.reset();
+			visible_instances.reset();
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].reset();
@@ -959,6 +1008,7 @@ public:
 			voxel_gi_instances.merge_unordered(p_cull_result.voxel_gi_instances);
 			mesh_instances.merge_unordered(p_cull_result.mesh_instances);
 			fog_volumes.merge_unordered(p_cull_result.fog_volumes);
+			visible_instances.merge_unordered(p_cull_result.visible_instances);
 
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
@@ -985,6 +1035,7 @@ public:
 			voxel_gi_instances.set_page_pool(p_rid_pool);
 			mesh_instances.set_page_pool(p_rid_pool);
 			fog_volumes.set_page_pool(p_rid_pool);
+			visible_instances.set_page_pool(p_instance_pool);
 			for (int i = 0; i < RendererSceneRender::MAX_DIRECTIONAL_LIGHTS; i++) {
 				for (int j = 0; j < RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES; j++) {
 					directional_shadows[i].cascade_geometry_instances[j].set_page_pool(p_geometry_instance_pool);
@@ -1027,6 +1078,7 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -1142,6 +1194,7 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		bool record_visible_instances = false;
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
@@ -1149,7 +1202,7 @@ public:
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
-	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
+	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, RID p_compositor, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr, Camera *r_camera = nullptr);
 	void render_empty_scene(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_scenario, RID p_shadow_atlas);
 
 	void render_camera(const Ref<RenderSceneBuffers> &p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, uint32_t p_jitter_phase_count, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderingMethod::RenderInfo *r_render_info = nullptr);
@@ -3322,6 +3322,8 @@ RID RenderingDevice::render_pipeline_create(RID p_shader, FramebufferFormatID p_
 		}
 	}
 
+	// The driver compiles the pipeline while the device lock is held, so other threads calling into the device wait for it.
+	// The lock also guards the driver's pipeline cache (which Vulkan may create externally synchronized) and keeps the shader and formats alive.
 	RenderPipeline pipeline;
 	pipeline.driver_id = driver->render_pipeline_create(
 			shader->driver_id,
@@ -1455,7 +1455,139 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+uint64_t ShaderCompiler::_get_compile_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions) {
+	uint64_t hash = hash_djb2_one_64(p_code.hash64());
+	hash = hash_djb2_one_64(p_mode, hash);
+
+	// Callers may hook up different identifiers, which changes both the generated code and its effects.
+	for (const KeyValue<StringName, Stage> &E : p_actions.entry_point_stages) {
+		hash = hash_djb2_one_64(E.key.hash(), hash);
+		hash = hash_djb2_one_64(E.value, hash);
+	}
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions.render_mode_values) {
+		hash = hash_djb2_one_64(E.key.hash(), hash);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.render_mode_flags) {
+		hash = hash_djb2_one_64(E.key.hash(), hash);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.usage_flag_pointers) {
+		hash = hash_djb2_one_64(E.key.hash(), hash);
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions.write_flag_pointers) {
+		hash = hash_djb2_one_64(E.key.hash(), hash);
+	}
+
+	return hash;
+}
+
+void ShaderCompiler::_apply_compile_cache_entry(const CompileCacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	r_gen_code = p_entry.gen_code;
+
+	for (const StringName &name : p_entry.render_mode_values) {
+		Pair<int *, int> &p = p_actions->render_mode_values[name];
+		*p.first = p.second;
+	}
+	for (const StringName &name : p_entry.render_mode_flags) {
+		*p_actions->render_mode_flags[name] = true;
+	}
+	for (const StringName &name : p_entry.usage_flags) {
+		*p_actions->usage_flag_pointers[name] = true;
+	}
+	for (const StringName &name : p_entry.write_flags) {
+		*p_actions->write_flag_pointers[name] = true;
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_entry.uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+}
+
+void ShaderCompiler::_generate_code_cached(uint64_t p_key, RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	CompileCacheEntry entry;
+	entry.mode = p_mode;
+	entry.code = p_code;
+
+	// Point the actions at private storage, so their effects can be recorded by name.
+	IdentifierActions recording_actions;
+	recording_actions.entry_point_stages = p_actions->entry_point_stages;
+	recording_actions.uniforms = &entry.uniforms;
+
+	LocalVector<int> render_mode_values;
+	render_mode_values.resize(p_actions->render_mode_values.size());
+	uint32_t index = 0;
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		// Start from a value that can't match, so the slot tells whether the render mode was applied.
+		render_mode_values[index] = ~E.value.second;
+		recording_actions.render_mode_values[E.key] = Pair<int *, int>(&render_mode_values[index], E.value.second);
+		index++;
+	}
+
+	LocalVector<bool> flags;
+	flags.resize(p_actions->render_mode_flags.size() + p_actions->usage_flag_pointers.size() + p_actions->write_flag_pointers.size());
+	index = 0;
+	for (const KeyValue<StringName, bool *> &E : p_actions->render_mode_flags) {
+		flags[index] = false;
+		recording_actions.render_mode_flags[E.key] = &flags[index++];
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		flags[index] = false;
+		recording_actions.usage_flag_pointers[E.key] = &flags[index++];
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		flags[index] = false;
+		recording_actions.write_flag_pointers[E.key] = &flags[index++];
+	}
+
+	_dump_node_code(shader, 1, r_gen_code, recording_actions, actions, false);
+
+	for (const KeyValue<StringName, Pair<int *, int>> &E : recording_actions.render_mode_values) {
+		if (*E.value.first == E.value.second) {
+			entry.render_mode_values.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : recording_actions.render_mode_flags) {
+		if (*E.value) {
+			entry.render_mode_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		if (*E.value) {
+			entry.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		if (*E.value) {
+			entry.write_flags.push_back(E.key);
+		}
+	}
+	entry.gen_code = r_gen_code;
+
+	_apply_compile_cache_entry(entry, p_actions, r_gen_code);
+
+	// Global uniform types are looked up while parsing and can change at any time.
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : entry.uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			return;
+		}
+	}
+
+	if (compile_cache.size() >= compile_cache_max_entries) {
+		// Entries are kept in insertion order, drop the oldest one.
+		compile_cache.remove(compile_cache.begin());
+	}
+	compile_cache.insert(p_key, entry);
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	uint64_t cache_key = 0;
+	if (compile_cache_max_entries > 0) {
+		cache_key = _get_compile_cache_key(p_mode, p_code, *p_actions);
+		const CompileCacheEntry *entry = compile_cache.getptr(cache_key);
+		if (entry && entry->mode == p_mode && entry->code == p_code) {
+			_apply_compile_cache_entry(*entry, p_actions, r_gen_code);
+			return OK;
+		}
+	}
+
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1558,13 +1690,19 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 
 	shader = parser.get_shader();
 	function = nullptr;
-	_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	if (compile_cache_max_entries > 0) {
+		_generate_code_cached(cache_key, p_mode, p_code, p_actions, r_gen_code);
+	} else {
+		_dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	}
 
 	return OK;
 }
 
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	compile_cache_max_entries = GLOBAL_GET("rendering/shader_compiler/compile_cache/max_entries");
+	compile_cache.clear();
 
 	time_name = "TIME";
 
@@ -31,11 +31,14 @@
 #ifndef SHADER_COMPILER_H
 #define SHADER_COMPILER_H
 
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
 
 class ShaderCompiler {
+	friend class TestShaderCompilerInternalsAccessor;
+
 public:
 	enum Stage {
 		STAGE_VERTEX,
@@ -125,6 +128,26 @@ private:
 
 	DefaultIdentifierActions actions;
 
+	// Results of successful compilations, so identical shader code is only parsed and translated once.
+	// The effects on the identifier actions are stored by name and replayed on a cache hit.
+	struct CompileCacheEntry {
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		String code;
+		GeneratedCode gen_code;
+		LocalVector<StringName> render_mode_values;
+		LocalVector<StringName> render_mode_flags;
+		LocalVector<StringName> usage_flags;
+		LocalVector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	HashMap<uint64_t, CompileCacheEntry> compile_cache;
+	uint32_t compile_cache_max_entries = 0;
+
+	static uint64_t _get_compile_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions &p_actions);
+	void _apply_compile_cache_entry(const CompileCacheEntry &p_entry, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _generate_code_cached(uint64_t p_key, RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
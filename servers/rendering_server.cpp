@@ -82,6 +82,11 @@ static PackedInt64Array to_int_array(const Vector<ObjectID> &ids) {
 	return a;
 }
 
+PackedInt64Array RenderingServer::_camera_get_visible_instances_bind(RID p_camera) const {
+	Vector<ObjectID> ids = camera_get_visible_instances(p_camera);
+	return to_int_array(ids);
+}
+
 PackedInt64Array RenderingServer::_instances_cull_aabb_bind(const AABB &p_aabb, RID p_scenario) const {
 	Vector<ObjectID> ids = instances_cull_aabb(p_aabb, p_scenario);
 	return to_int_array(ids);
@@ -104,6 +109,36 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_buffer) {
+	int count = p_instances.size();
+	ERR_FAIL_COND(p_buffer.size() != count * 12);
+
+	Vector<RID> instances;
+	instances.resize(count);
+	Vector<Transform3D> transforms;
+	transforms.resize(count);
+
+	RID *instances_ptr = instances.ptrw();
+	Transform3D *transforms_ptr = transforms.ptrw();
+	const float *r = p_buffer.ptr();
+
+	// Same layout as the 3D transforms in multimesh_set_buffer().
+	for (int i = 0; i < count; i++) {
+		instances_ptr[i] = p_instances[i];
+
+		const float *d = &r[i * 12];
+		Transform3D &t = transforms_ptr[i];
+		t.basis.rows[0] = Vector3(d[0], d[1], d[2]);
+		t.origin.x = d[3];
+		t.basis.rows[1] = Vector3(d[4], d[5], d[6]);
+		t.origin.y = d[7];
+		t.basis.rows[2] = Vector3(d[8], d[9], d[10]);
+		t.origin.z = d[11];
+	}
+
+	instances_set_transforms(instances, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -2435,6 +2470,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("multimesh_set_visible_instances", "multimesh", "visible"), &RenderingServer::multimesh_set_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_visible_instances", "multimesh"), &RenderingServer::multimesh_get_visible_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_set_buffer", "multimesh", "buffer"), &RenderingServer::multimesh_set_buffer);
+	ClassDB::bind_method(D_METHOD("multimesh_set_buffer_instances", "multimesh", "instances", "buffer"), &RenderingServer::multimesh_set_buffer_instances);
 	ClassDB::bind_method(D_METHOD("multimesh_get_buffer", "multimesh"), &RenderingServer::multimesh_get_buffer);
 
 	BIND_ENUM_CONSTANT(MULTIMESH_TRANSFORM_2D);
@@ -2762,6 +2798,9 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("camera_set_camera_attributes", "camera", "effects"), &RenderingServer::camera_set_camera_attributes);
 	ClassDB::bind_method(D_METHOD("camera_set_compositor", "camera", "compositor"), &RenderingServer::camera_set_compositor);
 	ClassDB::bind_method(D_METHOD("camera_set_use_vertical_aspect", "camera", "enable"), &RenderingServer::camera_set_use_vertical_aspect);
+	ClassDB::bind_method(D_METHOD("camera_set_record_visible_instances", "camera", "enable"), &RenderingServer::camera_set_record_visible_instances);
+	ClassDB::bind_method(D_METHOD("camera_get_visible_instances", "camera"), &RenderingServer::_camera_get_visible_instances_bind);
+	ClassDB::bind_method(D_METHOD("camera_get_cull_time_usec", "camera"), &RenderingServer::camera_get_cull_time_usec);
 
 	/* VIEWPORT */
 
@@ -3114,6 +3153,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "buffer"), &RenderingServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
@@ -3539,6 +3579,7 @@ void RenderingServer::init() {
 	// Number of commands that can be drawn per frame.
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
 
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/shader_compiler/compile_cache/max_entries", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 256);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/compress", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/use_zstd_compression", true);
@@ -32,6 +32,7 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
 
 #include "tests/test_macros.h"
 
@@ -85,6 +86,49 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Batched id paths") {
+	AStar3D a;
+	const int size = 8;
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			a.add_point(y * size + x, Vector3(x, y, 0));
+			if (x > 0) {
+				a.connect_points(y * size + x, y * size + x - 1);
+			}
+			if (y > 0) {
+				a.connect_points(y * size + x, (y - 1) * size + x);
+			}
+		}
+	}
+	// Removed points free their search state for the points added afterwards.
+	a.remove_point(3 * size + 3);
+	a.remove_point(3 * size + 4);
+	a.add_point(100, Vector3(3, 3, 0));
+	a.connect_points(100, 2 * size + 3);
+	a.set_point_disabled(5 * size + 5);
+
+	PackedInt64Array from_ids;
+	PackedInt64Array to_ids;
+	for (int i = 0; i < size * size; i++) {
+		if (a.has_point(i)) {
+			from_ids.push_back(i);
+			to_ids.push_back(100);
+			from_ids.push_back(100);
+			to_ids.push_back(i);
+		}
+	}
+
+	TypedArray<PackedInt64Array> paths = a.get_id_paths(from_ids, to_ids);
+	REQUIRE(paths.size() == from_ids.size());
+	for (int i = 0; i < from_ids.size(); i++) {
+		CHECK(PackedInt64Array(paths[i]) == a.get_id_path(from_ids[i], to_ids[i]));
+	}
+
+	ERR_PRINT_OFF;
+	CHECK(a.get_id_paths(from_ids, PackedInt64Array()).is_empty());
+	ERR_PRINT_ON;
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
@@ -357,6 +401,141 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_id_path_cost(const TypedArray<Vector2i> &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += Vector2(Vector2i(p_path[i]) - Vector2i(p_path[i - 1])).length();
+	}
+	return cost;
+}
+
+// Whether every step of the jumps in the path is a move that the grid allows.
+static bool are_jumps_valid(const Ref<AStarGrid2D> &p_astar, const TypedArray<Vector2i> &p_path) {
+	const AStarGrid2D::DiagonalMode diagonal_mode = p_astar->get_diagonal_mode();
+	auto is_walkable = [&](const Vector2i &p_id) {
+		return p_astar->is_in_boundsv(p_id) && !p_astar->is_point_solid(p_id);
+	};
+
+	for (int i = 1; i < p_path.size(); i++) {
+		const Vector2i from = p_path[i - 1];
+		const Vector2i jump = Vector2i(p_path[i]) - from;
+		if (jump.x != 0 && jump.y != 0 && ABS(jump.x) != ABS(jump.y)) {
+			return false;
+		}
+		const Vector2i dir = jump.sign();
+		for (int j = 0; j < MAX(ABS(jump.x), ABS(jump.y)); j++) {
+			const Vector2i step_from = from + dir * j;
+			if (!is_walkable(step_from + dir)) {
+				return false;
+			}
+			if (dir.x == 0 || dir.y == 0) {
+				continue;
+			}
+			const bool walkable_x = is_walkable(step_from + Vector2i(dir.x, 0));
+			const bool walkable_y = is_walkable(step_from + Vector2i(0, dir.y));
+			if (diagonal_mode == AStarGrid2D::DIAGONAL_MODE_NEVER ||
+					(diagonal_mode == AStarGrid2D::DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE && !walkable_x && !walkable_y) ||
+					(diagonal_mode == AStarGrid2D::DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES && (!walkable_x || !walkable_y))) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[AStarGrid2D] Jumping") {
+	const Rect2i region = Rect2i(-2, -2, 24, 24);
+	const Vector2i from = Vector2i(-2, -2);
+	const Vector2i to = Vector2i(21, 21);
+
+	for (int mode = 0; mode < AStarGrid2D::DIAGONAL_MODE_MAX; mode++) {
+		const AStarGrid2D::DiagonalMode diagonal_mode = AStarGrid2D::DiagonalMode(mode);
+		INFO("Diagonal mode: ", mode);
+
+		Ref<AStarGrid2D> a;
+		a.instantiate();
+		a->set_region(region);
+		a->set_diagonal_mode(diagonal_mode);
+		a->update();
+
+		Ref<AStarGrid2D> jumping;
+		jumping.instantiate();
+		jumping->set_region(region);
+		jumping->set_diagonal_mode(diagonal_mode);
+		jumping->set_jumping_enabled(true);
+		jumping->update();
+
+		// A wall with a single gap at (9, 19), and scattered solid points.
+		// The first and last column and the row of the gap stay free, so there is always a path.
+		Math::seed(0);
+		for (int y = region.position.y; y < region.get_end().y; y++) {
+			for (int x = region.position.x; x < region.get_end().x; x++) {
+				const bool solid = x == 9 ? y != 19 : (x != from.x && x != to.x && y != 19 && Math::rand() % 5 == 0);
+				a->set_point_solid(Vector2i(x, y), solid);
+				jumping->set_point_solid(Vector2i(x, y), solid);
+			}
+		}
+
+		// The paths found with jumping cost the same as the paths found without, and only use allowed moves.
+		const TypedArray<Vector2i> path = a->get_id_path(from, to);
+		const TypedArray<Vector2i> jump_path = jumping->get_id_path(from, to);
+		REQUIRE(path.size() > 1);
+		REQUIRE(jump_path.size() > 1);
+		CHECK(jump_path.size() <= path.size());
+		CHECK(Vector2i(jump_path.front()) == from);
+		CHECK(Vector2i(jump_path.back()) == to);
+		CHECK(get_id_path_cost(jump_path) == doctest::Approx(get_id_path_cost(path)));
+		CHECK(are_jumps_valid(jumping, jump_path));
+
+		// Changing single points only updates the jumps around them, the paths have to stay the same as with jumps computed from scratch.
+		for (int i = 0; i < 64; i++) {
+			const Vector2i id = Vector2i(region.position.x + Math::rand() % region.size.x, region.position.y + Math::rand() % region.size.y);
+			if (id == from || id == to) {
+				continue;
+			}
+			const bool solid = !jumping->is_point_solid(id);
+			a->set_point_solid(id, solid);
+			jumping->set_point_solid(id, solid);
+
+			Ref<AStarGrid2D> rebuilt;
+			rebuilt.instantiate();
+			rebuilt->set_region(region);
+			rebuilt->set_diagonal_mode(diagonal_mode);
+			rebuilt->set_jumping_enabled(true);
+			rebuilt->update();
+			for (int y = region.position.y; y < region.get_end().y; y++) {
+				for (int x = region.position.x; x < region.get_end().x; x++) {
+					rebuilt->set_point_solid(Vector2i(x, y), jumping->is_point_solid(Vector2i(x, y)));
+				}
+			}
+
+			const TypedArray<Vector2i> changed_path = a->get_id_path(from, to);
+			const TypedArray<Vector2i> changed_jump_path = jumping->get_id_path(from, to);
+			CHECK(changed_jump_path == rebuilt->get_id_path(from, to));
+			CHECK(changed_jump_path.is_empty() == changed_path.is_empty());
+			if (!changed_path.is_empty()) {
+				CHECK(get_id_path_cost(changed_jump_path) == doctest::Approx(get_id_path_cost(changed_path)));
+				CHECK(are_jumps_valid(jumping, changed_jump_path));
+			}
+		}
+
+		// Closing the gap blocks the jumps on the next search.
+		jumping->fill_solid_region(Rect2i(9, region.position.y, 1, region.size.y));
+		CHECK(jumping->get_id_path(from, to).is_empty());
+	}
+
+	// Weight scales are kept apart from the solid points.
+	Ref<AStarGrid2D> a;
+	a.instantiate();
+	a->set_region(region);
+	a->update();
+	a->set_point_weight_scale(Vector2i(1, 1), 3.0);
+	CHECK(a->get_point_weight_scale(Vector2i(1, 1)) == doctest::Approx(3.0));
+	CHECK(a->get_point_weight_scale(Vector2i(1, 2)) == doctest::Approx(1.0));
+	CHECK_FALSE(a->is_point_solid(Vector2i(1, 1)));
+	CHECK(a->get_point_position(Vector2i(3, 4)) == Vector2(3, 4));
+}
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
@@ -31,9 +31,12 @@
 #ifndef TEST_CAMERA_3D_H
 #define TEST_CAMERA_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/camera_3d.h"
+#include "scene/3d/mesh_instance_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/main/window.h"
+#include "scene/resources/3d/primitive_meshes.h"
 
 #include "tests/test_macros.h"
 
@@ -365,6 +368,71 @@ TEST_CASE("[SceneTree][Camera3D] Project ray") {
 	memdelete(mock_viewport);
 }
 
+TEST_CASE("[SceneTree][Camera3D] Headless scene culling records the visible instances") {
+	// Read when viewports are created, so it has to be set before the viewport below.
+	ProjectSettings::get_singleton()->set_setting("rendering/headless/run_scene_culling", true);
+
+	SubViewport *viewport = memnew(SubViewport);
+	viewport->set_size(Vector2i(100, 100));
+	viewport->set_use_own_world_3d(true);
+	viewport->set_update_mode(SubViewport::UPDATE_ALWAYS);
+	SceneTree::get_singleton()->get_root()->add_child(viewport);
+
+	// The camera looks down -Z.
+	Camera3D *camera = memnew(Camera3D);
+	viewport->add_child(camera);
+	REQUIRE(camera->is_current());
+
+	Ref<BoxMesh> box_mesh;
+	box_mesh.instantiate();
+
+	MeshInstance3D *inside = memnew(MeshInstance3D);
+	inside->set_mesh(box_mesh);
+	inside->set_position(Vector3(0, 0, -10));
+	viewport->add_child(inside);
+
+	MeshInstance3D *outside = memnew(MeshInstance3D);
+	outside->set_mesh(box_mesh);
+	outside->set_position(Vector3(0, 0, 10));
+	viewport->add_child(outside);
+
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	const RID camera_rid = camera->get_camera();
+	CHECK(RS::get_singleton()->camera_get_visible_instances(camera_rid).is_empty());
+
+	RS::get_singleton()->camera_set_record_visible_instances(camera_rid, true);
+	RS::get_singleton()->draw(false);
+
+	const Vector<ObjectID> visible_instances = RS::get_singleton()->camera_get_visible_instances(camera_rid);
+	CHECK(visible_instances.size() == 1);
+	CHECK(visible_instances.has(inside->get_instance_id()));
+	CHECK_FALSE(visible_instances.has(outside->get_instance_id()));
+	// Only a sanity check, culling two instances can take less than a microsecond.
+	CHECK(RS::get_singleton()->camera_get_cull_time_usec(camera_rid) < 1000000);
+
+	SUBCASE("Moving an instance into the frustum") {
+		outside->set_position(Vector3(1, 0, -10));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		RS::get_singleton()->draw(false);
+
+		const Vector<ObjectID> moved_visible_instances = RS::get_singleton()->camera_get_visible_instances(camera_rid);
+		CHECK(moved_visible_instances.size() == 2);
+		CHECK(moved_visible_instances.has(outside->get_instance_id()));
+	}
+
+	SUBCASE("Disabling recording") {
+		RS::get_singleton()->camera_set_record_visible_instances(camera_rid, false);
+		CHECK(RS::get_singleton()->camera_get_visible_instances(camera_rid).is_empty());
+
+		RS::get_singleton()->draw(false);
+		CHECK(RS::get_singleton()->camera_get_visible_instances(camera_rid).is_empty());
+	}
+
+	memdelete(viewport);
+	ProjectSettings::get_singleton()->set_setting("rendering/headless/run_scene_culling", false);
+}
+
 #undef SQRT3
 
 #endif // TEST_CAMERA_3D_H
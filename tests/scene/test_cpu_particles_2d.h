@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  test_cpu_particles_2d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_CPU_PARTICLES_2D_H
+#define TEST_CPU_PARTICLES_2D_H
+
+#include "scene/2d/cpu_particles_2d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+class TestCPUParticles2DInternalsAccessor {
+public:
+	static void process(CPUParticles2D *p_particles, double p_delta, int p_chunk_size) {
+		p_particles->_particles_process(p_delta, p_chunk_size);
+	}
+
+	static Vector<float> get_particle_data(CPUParticles2D *p_particles) {
+		p_particles->_update_particle_data_buffer();
+		return p_particles->particle_data;
+	}
+};
+
+namespace TestCPUParticles2D {
+
+static CPUParticles2D *create_particles(int p_amount) {
+	CPUParticles2D *particles = memnew(CPUParticles2D);
+	particles->set_amount(p_amount);
+	particles->set_lifetime(0.5);
+	particles->set_explosiveness_ratio(0.3);
+	particles->set_randomness_ratio(0.5);
+	particles->set_lifetime_randomness(0.4);
+	particles->set_spread(60.0);
+	particles->set_param_min(CPUParticles2D::PARAM_INITIAL_LINEAR_VELOCITY, 1.0);
+	particles->set_param_max(CPUParticles2D::PARAM_INITIAL_LINEAR_VELOCITY, 5.0);
+	particles->set_emission_shape(CPUParticles2D::EMISSION_SHAPE_RECTANGLE);
+	particles->set_emission_rect_extents(Vector2(2.0, 1.0));
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+	return particles;
+}
+
+static Vector<float> simulate(CPUParticles2D *p_particles, int p_chunk_size) {
+	Math::seed(12345);
+	// Enough steps to wrap the lifetime, so particles are restarted as well as spawned.
+	for (int i = 0; i < 40; i++) {
+		TestCPUParticles2DInternalsAccessor::process(p_particles, 1.0 / 60.0, p_chunk_size);
+	}
+	return TestCPUParticles2DInternalsAccessor::get_particle_data(p_particles);
+}
+
+TEST_CASE("[SceneTree][CPUParticles2D] Emission doesn't depend on how processing is split into chunks") {
+	const int amount = 1000;
+	CPUParticles2D *single_chunk = create_particles(amount);
+	CPUParticles2D *several_chunks = create_particles(amount);
+
+	const Vector<float> single_chunk_data = simulate(single_chunk, amount);
+	const Vector<float> several_chunks_data = simulate(several_chunks, 64);
+
+	REQUIRE(single_chunk_data.size() == several_chunks_data.size());
+	CHECK_MESSAGE(single_chunk_data == several_chunks_data, "Processing in several chunks should produce the same particles as a single chunk.");
+
+	memdelete(single_chunk);
+	memdelete(several_chunks);
+}
+
+} // namespace TestCPUParticles2D
+
+#endif // TEST_CPU_PARTICLES_2D_H
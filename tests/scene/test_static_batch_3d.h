@@ -0,0 +1,221 @@
+/**************************************************************************/
+/*  test_static_batch_3d.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STATIC_BATCH_3D_H
+#define TEST_STATIC_BATCH_3D_H
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/static_batch_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStaticBatch3D {
+
+TEST_CASE("[SceneTree][StaticBatch3D] Static mesh instances are merged per cell") {
+	StaticBatch3D *static_batch = memnew(StaticBatch3D);
+	static_batch->set_batch_on_ready(false);
+	static_batch->set_cell_size(10.0);
+	SceneTree::get_singleton()->get_root()->add_child(static_batch);
+
+	Ref<BoxMesh> box_mesh;
+	box_mesh.instantiate();
+
+	const Vector3 positions[] = { Vector3(1, 1, 1), Vector3(3, 1, 1), Vector3(25, 1, 1) };
+	MeshInstance3D *mesh_instances[3];
+	for (int i = 0; i < 3; i++) {
+		mesh_instances[i] = memnew(MeshInstance3D);
+		mesh_instances[i]->set_mesh(box_mesh);
+		mesh_instances[i]->set_position(positions[i]);
+		static_batch->add_child(mesh_instances[i]);
+	}
+
+	MeshInstance3D *transparent_instance = memnew(MeshInstance3D);
+	transparent_instance->set_mesh(box_mesh);
+	transparent_instance->set_transparency(0.5);
+	static_batch->add_child(transparent_instance);
+
+	CHECK_FALSE(static_batch->is_batched());
+
+	static_batch->batch();
+
+	CHECK(static_batch->is_batched());
+	CHECK_MESSAGE(static_batch->get_batch_count() == 2, "The two nearby boxes should share a batch, the far one should get its own.");
+	CHECK_MESSAGE(static_batch->get_batched_instance_count() == 3, "Transparent instances should not be batched.");
+	for (int i = 0; i < 3; i++) {
+		CHECK_FALSE(mesh_instances[i]->is_visible());
+	}
+	CHECK(transparent_instance->is_visible());
+
+	// Batches are created in the order of their first instance, after the regular children.
+	const AABB expected_aabbs[2] = {
+		mesh_instances[0]->get_transform().xform(box_mesh->get_aabb()).merge(mesh_instances[1]->get_transform().xform(box_mesh->get_aabb())),
+		mesh_instances[2]->get_transform().xform(box_mesh->get_aabb()),
+	};
+	for (int i = 0; i < 2; i++) {
+		MeshInstance3D *batch_instance = Object::cast_to<MeshInstance3D>(static_batch->get_child(static_batch->get_child_count(false) + i, true));
+		REQUIRE(batch_instance);
+		CHECK_MESSAGE(batch_instance->get_mesh()->get_aabb().is_equal_approx(expected_aabbs[i]), "The batch mesh should cover exactly its source instances.");
+	}
+
+	static_batch->unbatch();
+
+	CHECK_FALSE(static_batch->is_batched());
+	CHECK(static_batch->get_batch_count() == 0);
+	for (int i = 0; i < 3; i++) {
+		CHECK(mesh_instances[i]->is_visible());
+	}
+
+	memdelete(static_batch);
+}
+
+TEST_CASE("[SceneTree][StaticBatch3D] Instance settings that can't be merged") {
+	StaticBatch3D *static_batch = memnew(StaticBatch3D);
+	static_batch->set_batch_on_ready(false);
+	SceneTree::get_singleton()->get_root()->add_child(static_batch);
+
+	Ref<BoxMesh> box_mesh;
+	box_mesh.instantiate();
+
+	MeshInstance3D *first = memnew(MeshInstance3D);
+	first->set_mesh(box_mesh);
+	static_batch->add_child(first);
+
+	MeshInstance3D *second = memnew(MeshInstance3D);
+	second->set_mesh(box_mesh);
+	second->set_position(Vector3(2, 0, 0));
+	static_batch->add_child(second);
+
+	SUBCASE("Different culling settings") {
+		second->set_extra_cull_margin(1.0);
+		static_batch->batch();
+
+		CHECK(static_batch->get_batched_instance_count() == 2);
+		CHECK_MESSAGE(static_batch->get_batch_count() == 2, "Instances with a different extra cull margin should not share a batch.");
+	}
+
+	SUBCASE("Custom AABB") {
+		second->set_custom_aabb(AABB(Vector3(-5, -5, -5), Vector3(10, 10, 10)));
+		static_batch->batch();
+
+		CHECK(static_batch->get_batched_instance_count() == 1);
+		CHECK(second->is_visible());
+	}
+
+	SUBCASE("Mirrored transform") {
+		second->set_scale(Vector3(-1, 1, 1));
+		static_batch->batch();
+
+		CHECK(static_batch->get_batched_instance_count() == 1);
+		CHECK_MESSAGE(second->is_visible(), "Merging a mirrored instance would cull its faces from the wrong side.");
+	}
+
+	SUBCASE("Different custom channel formats") {
+		Array arrays = box_mesh->get_mesh_arrays();
+		PackedByteArray custom;
+		custom.resize(PackedVector3Array(arrays[Mesh::ARRAY_VERTEX]).size() * 4);
+		custom.fill(255);
+		arrays[Mesh::ARRAY_CUSTOM0] = custom;
+
+		Ref<ArrayMesh> unorm_mesh;
+		unorm_mesh.instantiate();
+		unorm_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays, TypedArray<Array>(), Dictionary(), Mesh::ARRAY_CUSTOM_RGBA8_UNORM << Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT);
+		Ref<ArrayMesh> snorm_mesh;
+		snorm_mesh.instantiate();
+		snorm_mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays, TypedArray<Array>(), Dictionary(), Mesh::ARRAY_CUSTOM_RGBA8_SNORM << Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT);
+		first->set_mesh(unorm_mesh);
+		second->set_mesh(snorm_mesh);
+		static_batch->batch();
+
+		CHECK(static_batch->get_batched_instance_count() == 2);
+		REQUIRE(static_batch->get_batch_count() == 1);
+		MeshInstance3D *batch_instance = Object::cast_to<MeshInstance3D>(static_batch->get_child(static_batch->get_child_count(false), true));
+		REQUIRE(batch_instance);
+		Ref<Mesh> batch_mesh = batch_instance->get_mesh();
+		REQUIRE_MESSAGE(batch_mesh->get_surface_count() == 2, "Surfaces with different custom channel formats should not be merged.");
+		CHECK(((batch_mesh->surface_get_format(1) >> Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT) & Mesh::ARRAY_FORMAT_CUSTOM_MASK) == Mesh::ARRAY_CUSTOM_RGBA8_SNORM);
+	}
+
+	SUBCASE("Descendant that can't be batched") {
+		Node3D *intermediate = memnew(Node3D);
+		second->add_child(intermediate);
+		MeshInstance3D *transparent_instance = memnew(MeshInstance3D);
+		transparent_instance->set_mesh(box_mesh);
+		transparent_instance->set_transparency(0.5);
+		intermediate->add_child(transparent_instance);
+		static_batch->batch();
+
+		CHECK(static_batch->get_batched_instance_count() == 1);
+		CHECK_MESSAGE(second->is_visible(), "Hiding the instance would also hide its transparent grandchild.");
+		CHECK(transparent_instance->is_visible_in_tree());
+	}
+
+	memdelete(static_batch);
+}
+
+TEST_CASE("[SceneTree][StaticBatch3D] Normals of scaled instances") {
+	StaticBatch3D *static_batch = memnew(StaticBatch3D);
+	static_batch->set_batch_on_ready(false);
+	SceneTree::get_singleton()->get_root()->add_child(static_batch);
+
+	// The slanted faces of a prism change direction under non-uniform scale.
+	Ref<PrismMesh> prism_mesh;
+	prism_mesh.instantiate();
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(prism_mesh);
+	mesh_instance->set_rotation(Vector3(0, Math_PI / 4.0, 0));
+	mesh_instance->set_scale(Vector3(1, 3, 0.5));
+	static_batch->add_child(mesh_instance);
+
+	static_batch->batch();
+	REQUIRE(static_batch->get_batch_count() == 1);
+	MeshInstance3D *batch_instance = Object::cast_to<MeshInstance3D>(static_batch->get_child(static_batch->get_child_count(false), true));
+	REQUIRE(batch_instance);
+
+	const Array source_arrays = prism_mesh->surface_get_arrays(0);
+	const Array batch_arrays = batch_instance->get_mesh()->surface_get_arrays(0);
+	const PackedVector3Array source_normals = source_arrays[Mesh::ARRAY_NORMAL];
+	const PackedVector3Array batch_normals = batch_arrays[Mesh::ARRAY_NORMAL];
+	REQUIRE(batch_normals.size() == source_normals.size());
+
+	const Basis normal_basis = mesh_instance->get_transform().basis.inverse().transposed();
+	for (int i = 0; i < source_normals.size(); i++) {
+		const Vector3 expected_normal = normal_basis.xform(source_normals[i]).normalized();
+		CHECK_MESSAGE(batch_normals[i].distance_to(expected_normal) < 0.01, "Normals should be transformed with the inverse transpose of the instance basis.");
+	}
+
+	memdelete(static_batch);
+}
+
+} // namespace TestStaticBatch3D
+
+#endif // TEST_STATIC_BATCH_3D_H
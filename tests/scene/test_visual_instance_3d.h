@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*  test_visual_instance_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VISUAL_INSTANCE_3D_H
+#define TEST_VISUAL_INSTANCE_3D_H
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/3d/primitive_meshes.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_tools.h"
+
+namespace TestVisualInstance3D {
+
+class TransformChangeDeleter : public Node3D {
+	GDCLASS(TransformChangeDeleter, Node3D);
+
+public:
+	Node *node_to_delete = nullptr;
+
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED && node_to_delete) {
+			memdelete(node_to_delete);
+			node_to_delete = nullptr;
+		}
+	}
+
+	TransformChangeDeleter() {
+		set_notify_transform(true);
+	}
+};
+
+static MeshInstance3D *create_box_instance(const Vector3 &p_position) {
+	Ref<BoxMesh> box_mesh;
+	box_mesh.instantiate();
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(box_mesh);
+	mesh_instance->set_position(p_position);
+	SceneTree::get_singleton()->get_root()->add_child(mesh_instance);
+	return mesh_instance;
+}
+
+// The box mesh is one unit wide, so a small box at a point only finds the instance if it covers that point.
+static bool is_instance_at(const MeshInstance3D *p_mesh_instance, const Vector3 &p_point) {
+	const AABB query(p_point - Vector3(0.05, 0.05, 0.05), Vector3(0.1, 0.1, 0.1));
+	const Vector<ObjectID> ids = RS::get_singleton()->instances_cull_aabb(query, p_mesh_instance->get_world_3d()->get_scenario());
+	return ids.has(p_mesh_instance->get_instance_id());
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] Transforms changed in one flush are sent to the RenderingServer") {
+	MeshInstance3D *first = create_box_instance(Vector3(0, 0, 0));
+	MeshInstance3D *second = create_box_instance(Vector3(0, 0, 10));
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	CHECK(is_instance_at(first, Vector3(0, 0, 0)));
+	CHECK(is_instance_at(second, Vector3(0, 0, 10)));
+
+	SUBCASE("Moved instances") {
+		first->set_position(Vector3(5, 0, 0));
+		second->set_position(Vector3(5, 0, 10));
+		second->set_position(Vector3(-5, 0, 10));
+		SceneTree::get_singleton()->flush_transform_notifications();
+
+		CHECK_FALSE(is_instance_at(first, Vector3(0, 0, 0)));
+		CHECK(is_instance_at(first, Vector3(5, 0, 0)));
+		CHECK_FALSE(is_instance_at(second, Vector3(5, 0, 10)));
+		CHECK_MESSAGE(is_instance_at(second, Vector3(-5, 0, 10)), "The last transform set before the flush should be used.");
+	}
+
+	SUBCASE("Instance freed during the flush") {
+		TransformChangeDeleter *deleter = memnew(TransformChangeDeleter);
+		SceneTree::get_singleton()->get_root()->add_child(deleter);
+		SceneTree::get_singleton()->flush_transform_notifications();
+
+		// Notifications are sent in reverse order of the changes, so the instance queues its transform before it is deleted.
+		deleter->node_to_delete = first;
+		deleter->set_position(Vector3(1, 0, 0));
+		first->set_position(Vector3(5, 0, 0));
+		second->set_position(Vector3(5, 0, 10));
+
+		ErrorDetector ed;
+		SceneTree::get_singleton()->flush_transform_notifications();
+		first = nullptr;
+
+		CHECK_FALSE_MESSAGE(ed.has_error, "The transform of the freed instance should not be sent.");
+		CHECK(deleter->node_to_delete == nullptr);
+		CHECK(is_instance_at(second, Vector3(5, 0, 10)));
+
+		memdelete(deleter);
+	}
+
+	if (first) {
+		memdelete(first);
+	}
+	memdelete(second);
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] instances_set_transforms binding reads 12 floats per transform") {
+	MeshInstance3D *first = create_box_instance(Vector3(0, 0, 0));
+	MeshInstance3D *second = create_box_instance(Vector3(0, 0, 10));
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	TypedArray<RID> instances;
+	instances.push_back(first->get_instance());
+	instances.push_back(second->get_instance());
+
+	// Basis rows followed by the matching origin component, the second transform is stretched along X.
+	PackedFloat32Array buffer;
+	const float data[24] = {
+		1, 0, 0, 10, 0, 1, 0, 20, 0, 0, 1, 30,
+		3, 0, 0, -10, 0, 1, 0, -20, 0, 0, 1, -30
+	};
+	for (int i = 0; i < 24; i++) {
+		buffer.push_back(data[i]);
+	}
+	RS::get_singleton()->call("instances_set_transforms", instances, buffer);
+
+	CHECK(is_instance_at(first, Vector3(10, 20, 30)));
+	CHECK_FALSE(is_instance_at(first, Vector3(11, 20, 30)));
+	CHECK(is_instance_at(second, Vector3(-10, -20, -30)));
+	CHECK(is_instance_at(second, Vector3(-8.6, -20, -30)));
+	CHECK_FALSE(is_instance_at(second, Vector3(-10, -18.6, -30)));
+
+	SUBCASE("Buffer of the wrong size") {
+		buffer.resize(23);
+		ERR_PRINT_OFF;
+		RS::get_singleton()->call("instances_set_transforms", instances, buffer);
+		ERR_PRINT_ON;
+
+		CHECK_MESSAGE(is_instance_at(first, Vector3(10, 20, 30)), "A buffer of the wrong size should be rejected.");
+	}
+
+	memdelete(first);
+	memdelete(second);
+}
+
+} // namespace TestVisualInstance3D
+
+#endif // TEST_VISUAL_INSTANCE_3D_H
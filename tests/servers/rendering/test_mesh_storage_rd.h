@@ -0,0 +1,146 @@
+/**************************************************************************/
+/*  test_mesh_storage_rd.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESH_STORAGE_RD_H
+#define TEST_MESH_STORAGE_RD_H
+
+#include "servers/rendering/renderer_rd/storage_rd/mesh_storage.h"
+
+#include "tests/test_macros.h"
+
+namespace RendererRD {
+
+class TestMeshStorageInternalsAccessor {
+public:
+	typedef MeshStorage::MultiMesh MultiMesh;
+
+	static AABB merge_region_aabbs(MultiMesh *p_multimesh, const AABB &p_mesh_aabb, const float *p_data, int p_instances) {
+		return MeshStorage::_multimesh_merge_region_aabbs(p_multimesh, p_mesh_aabb, p_data, p_instances);
+	}
+};
+
+} // namespace RendererRD
+
+namespace TestMeshStorageRD {
+
+typedef RendererRD::TestMeshStorageInternalsAccessor Accessor;
+
+// MULTIMESH_DIRTY_REGION_SIZE in mesh_storage.cpp.
+const int REGION_SIZE = 512;
+
+static void set_instance_origin(Vector<float> &r_buffer, int p_index, const Vector3 &p_origin) {
+	float *w = r_buffer.ptrw() + p_index * 12;
+	w[3] = p_origin.x;
+	w[7] = p_origin.y;
+	w[11] = p_origin.z;
+}
+
+static AABB get_instances_aabb(const Vector<float> &p_buffer, const AABB &p_mesh_aabb) {
+	AABB aabb;
+	for (int i = 0; i < p_buffer.size() / 12; i++) {
+		const float *r = p_buffer.ptr() + i * 12;
+		const AABB instance_aabb = Transform3D(r[0], r[1], r[2], r[4], r[5], r[6], r[8], r[9], r[10], r[3], r[7], r[11]).xform(p_mesh_aabb);
+		if (i == 0) {
+			aabb = instance_aabb;
+		} else {
+			aabb.merge_with(instance_aabb);
+		}
+	}
+	return aabb;
+}
+
+TEST_CASE("[MeshStorageRD] MultiMesh region AABBs merge into the AABB of all instances") {
+	// Three regions, the last one partially filled.
+	const int instance_count = REGION_SIZE * 2 + 100;
+	const int region_count = 3;
+
+	Vector<float> buffer;
+	buffer.resize(instance_count * 12);
+	buffer.fill(0.0);
+	for (int i = 0; i < instance_count; i++) {
+		float *w = buffer.ptrw() + i * 12;
+		w[0] = 1.0;
+		w[5] = 1.0;
+		w[10] = 1.0;
+		set_instance_origin(buffer, i, Vector3(i * 0.1, Math::sin(i * 0.3), -i * 0.05));
+	}
+
+	AABB region_aabbs[region_count];
+	bool dirty_region_aabbs[region_count];
+	memset(dirty_region_aabbs, 1, sizeof(dirty_region_aabbs));
+
+	Accessor::MultiMesh multimesh;
+	multimesh.instances = instance_count;
+	multimesh.xform_format = RS::MULTIMESH_TRANSFORM_3D;
+	multimesh.stride_cache = 12;
+	multimesh.data_cache_region_aabbs = region_aabbs;
+	multimesh.data_cache_dirty_region_aabbs = dirty_region_aabbs;
+
+	const AABB mesh_aabb = AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1));
+	CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(get_instances_aabb(buffer, mesh_aabb)));
+	for (int i = 0; i < region_count; i++) {
+		CHECK_FALSE(dirty_region_aabbs[i]);
+	}
+
+	SUBCASE("Only dirty regions are recomputed") {
+		// Grows the AABB from the middle region.
+		set_instance_origin(buffer, REGION_SIZE + 10, Vector3(0, 100, 0));
+		dirty_region_aabbs[1] = true;
+		CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(get_instances_aabb(buffer, mesh_aabb)));
+
+		// Changes to a region that isn't marked dirty keep its cached AABB.
+		const AABB merged_aabb = get_instances_aabb(buffer, mesh_aabb);
+		set_instance_origin(buffer, REGION_SIZE * 2 + 50, Vector3(0, 0, 100));
+		CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(merged_aabb));
+
+		dirty_region_aabbs[2] = true;
+		CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(get_instances_aabb(buffer, mesh_aabb)));
+	}
+
+	SUBCASE("Shrinking the AABB from a dirty region") {
+		// The instance furthest along X is in the last region.
+		set_instance_origin(buffer, instance_count - 1, Vector3());
+		dirty_region_aabbs[2] = true;
+		CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(get_instances_aabb(buffer, mesh_aabb)));
+	}
+
+	SUBCASE("A different mesh AABB recomputes every region") {
+		const AABB larger_mesh_aabb = AABB(Vector3(-2, -1, -3), Vector3(4, 2, 6));
+		CHECK(Accessor::merge_region_aabbs(&multimesh, larger_mesh_aabb, buffer.ptr(), instance_count).is_equal_approx(get_instances_aabb(buffer, larger_mesh_aabb)));
+	}
+
+	SUBCASE("Fewer visible instances only merge the visible regions") {
+		CHECK(Accessor::merge_region_aabbs(&multimesh, mesh_aabb, buffer.ptr(), REGION_SIZE).is_equal_approx(get_instances_aabb(buffer.slice(0, REGION_SIZE * 12), mesh_aabb)));
+	}
+}
+
+} // namespace TestMeshStorageRD
+
+#endif // TEST_MESH_STORAGE_RD_H
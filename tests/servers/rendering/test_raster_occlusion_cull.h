@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Standalone backend, which leaves the occlusion culling singleton to the rendering server.
+class TestRasterOcclusionCull : public RasterOcclusionCull {
+public:
+	TestRasterOcclusionCull(RendererSceneOcclusionCull *p_server_occlusion_cull) {
+		singleton = p_server_occlusion_cull;
+	}
+};
+
+bool is_box_occluded(const RendererSceneOcclusionCull::HZBuffer *p_buffer, const AABB &p_aabb, const Projection &p_projection) {
+	const real_t bounds[6] = { p_aabb.position.x, p_aabb.position.y, p_aabb.position.z, p_aabb.position.x + p_aabb.size.x, p_aabb.position.y + p_aabb.size.y, p_aabb.position.z + p_aabb.size.z };
+	uint64_t occlusion_timeout = 0;
+	return p_buffer->is_occluded(bounds, Vector3(), Transform3D(), p_projection, p_projection.get_z_near(), occlusion_timeout);
+}
+
+TEST_CASE("[RasterOcclusionCull] Rasterize an occluder quad") {
+	const bool jitter_enabled = RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled;
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = false;
+
+	TestRasterOcclusionCull occlusion_cull(RendererSceneOcclusionCull::get_singleton());
+	const RID scenario = RID::from_uint64(1);
+	const RID instance = RID::from_uint64(2);
+	const RID buffer = RID::from_uint64(3);
+
+	// A 10x10 quad in front of the camera, which covers the center half of the buffer.
+	const RID occluder = occlusion_cull.occluder_allocate();
+	occlusion_cull.occluder_initialize(occluder);
+	occlusion_cull.occluder_set_mesh(occluder,
+			{ Vector3(-5, -5, -10), Vector3(5, -5, -10), Vector3(5, 5, -10), Vector3(-5, 5, -10) },
+			{ 0, 1, 2, 0, 2, 3 });
+
+	occlusion_cull.add_scenario(scenario);
+	occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(), true);
+	occlusion_cull.add_buffer(buffer);
+	occlusion_cull.buffer_set_scenario(buffer, scenario);
+	occlusion_cull.buffer_set_size(buffer, Vector2i(64, 64));
+
+	Projection projection;
+	projection.set_perspective(90.0, 1.0, 0.1, 100.0);
+	occlusion_cull.buffer_update(buffer, Transform3D(), projection, false);
+
+	const RasterOcclusionCull::RasterHZBuffer *hz_buffer = static_cast<RasterOcclusionCull::RasterHZBuffer *>(occlusion_cull.buffer_get_ptr(buffer));
+	REQUIRE(hz_buffer != nullptr);
+	const float *depth = hz_buffer->get_depth();
+	REQUIRE(depth != nullptr);
+
+	CHECK(depth[32 * 64 + 32] == doctest::Approx(10.0));
+	CHECK(depth[17 * 64 + 17] == doctest::Approx(10.0));
+	CHECK(depth[46 * 64 + 46] == doctest::Approx(10.0));
+	CHECK(depth[0] == FLT_MAX);
+	CHECK(depth[32 * 64 + 8] == FLT_MAX);
+	CHECK(depth[56 * 64 + 32] == FLT_MAX);
+
+	const AABB box_in_front(Vector3(-1, -1, -6), Vector3(2, 2, 2));
+	const AABB box_behind(Vector3(-1, -1, -21), Vector3(2, 2, 2));
+	const AABB box_beside(Vector3(20, -1, -21), Vector3(2, 2, 2));
+	CHECK_FALSE(is_box_occluded(hz_buffer, box_in_front, projection));
+	CHECK(is_box_occluded(hz_buffer, box_behind, projection));
+	CHECK_FALSE(is_box_occluded(hz_buffer, box_beside, projection));
+
+	SUBCASE("Disabled occluders should clear the depth") {
+		occlusion_cull.scenario_set_instance(scenario, instance, occluder, Transform3D(), false);
+		occlusion_cull.buffer_update(buffer, Transform3D(), projection, false);
+		CHECK(depth[32 * 64 + 32] == FLT_MAX);
+		CHECK_FALSE(is_box_occluded(hz_buffer, box_behind, projection));
+	}
+
+	occlusion_cull.remove_buffer(buffer);
+	occlusion_cull.scenario_remove_instance(scenario, instance);
+	occlusion_cull.remove_scenario(scenario);
+	occlusion_cull.free_occluder(occluder);
+
+	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = jitter_enabled;
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "core/math/random_pcg.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+bool is_culled_the_same_with_skipped_subtrees(RendererCanvasCull &p_canvas_cull, RID p_canvas) {
+	RendererCanvasCull::Canvas *canvas = p_canvas_cull.canvas_owner.get_or_null(p_canvas);
+	const Rect2 clip_rect(0, 0, 100, 100);
+
+	LocalVector<RendererCanvasRender::Item *> culled_items[2];
+	for (int i = 0; i < 2; i++) {
+		p_canvas_cull.skip_offscreen_subtrees = i == 1;
+		RendererCanvasRender::Item *item = p_canvas_cull._cull_canvas_item_tree(canvas->child_items.ptrw(), canvas->child_items.size(), Transform2D(), clip_rect, 0xFFFFFFFF);
+		while (item) {
+			culled_items[i].push_back(item);
+			item = item->next;
+		}
+	}
+
+	if (culled_items[0].size() != culled_items[1].size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < culled_items[0].size(); i++) {
+		if (culled_items[0][i] != culled_items[1][i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[RendererCanvasCull] Skipping offscreen subtrees culls the same items as a full traversal") {
+	RendererCanvasCull canvas_cull;
+	const bool skip_offscreen_subtrees = canvas_cull.skip_offscreen_subtrees;
+
+	const RID canvas = canvas_cull.canvas_allocate();
+	canvas_cull.canvas_initialize(canvas);
+
+	// A random tree, where the parent of every item comes before it, spread well beyond the clip rect.
+	RandomPCG rng(12345);
+	LocalVector<RID> items;
+	for (int i = 0; i < 200; i++) {
+		const RID item = canvas_cull.canvas_item_allocate();
+		canvas_cull.canvas_item_initialize(item);
+		canvas_cull.canvas_item_set_parent(item, i < 4 ? canvas : items[rng.rand() % items.size()]);
+		canvas_cull.canvas_item_set_transform(item, Transform2D(rng.random(-1.0, 1.0), Vector2(rng.random(-150.0, 150.0), rng.random(-150.0, 150.0))));
+		if (rng.rand() % 4 != 0) {
+			canvas_cull.canvas_item_add_rect(item, Rect2(0, 0, rng.random(1.0, 20.0), rng.random(1.0, 20.0)), Color(1, 1, 1), false);
+		}
+		items.push_back(item);
+	}
+
+	CHECK(is_culled_the_same_with_skipped_subtrees(canvas_cull, canvas));
+
+	for (int i = 0; i < 100; i++) {
+		const uint32_t index = 4 + rng.rand() % (items.size() - 4);
+		const RID item = items[index];
+
+		switch (i % 3) {
+			case 0: {
+				canvas_cull.canvas_item_set_transform(item, Transform2D(rng.random(-1.0, 1.0), Vector2(rng.random(-150.0, 150.0), rng.random(-150.0, 150.0))));
+			} break;
+			case 1: {
+				canvas_cull.canvas_item_set_visible(item, rng.rand() % 2 == 0);
+			} break;
+			case 2: {
+				// Only reparent to earlier items, so the tree doesn't get cycles.
+				canvas_cull.canvas_item_set_parent(item, items[rng.rand() % index]);
+			} break;
+		}
+
+		INFO("Step: ", i);
+		CHECK(is_culled_the_same_with_skipped_subtrees(canvas_cull, canvas));
+	}
+
+	for (const RID &item : items) {
+		canvas_cull.free(item);
+	}
+	canvas_cull.free(canvas);
+	canvas_cull.skip_offscreen_subtrees = skip_offscreen_subtrees;
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,79 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/projection.h"
+#include "core/math/random_pcg.h"
+#include "servers/rendering/renderer_scene_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+TEST_CASE("[RendererSceneCull] Block frustum test matches the per instance test") {
+	Projection projection;
+	projection.set_perspective(75.0, 1.5, 0.05, 100.0);
+	const Transform3D camera_transform(Basis::from_euler(Vector3(0.3, 1.2, 0.0)), Vector3(1.0, 2.0, 3.0));
+	const RendererSceneCull::Frustum frustum(projection.get_projection_planes(camera_transform));
+
+	RandomPCG rng(12345);
+	LocalVector<RendererSceneCull::InstanceBounds> instance_bounds;
+	for (uint32_t i = 0; i < 1000; i++) {
+		const Vector3 position(rng.random(-100.0, 100.0), rng.random(-100.0, 100.0), rng.random(-100.0, 100.0));
+		const Vector3 size(rng.random(0.0, 10.0), rng.random(0.0, 10.0), rng.random(0.0, 10.0));
+		instance_bounds.push_back(RendererSceneCull::InstanceBounds(AABB(position, size)));
+	}
+
+	uint32_t in_frustum_count = 0;
+	for (uint32_t i = 0; i < instance_bounds.size(); i += RendererSceneCull::InstanceBounds::FRUSTUM_BLOCK_SIZE) {
+		// Also covers a partial block at the end.
+		const uint32_t block_count = MIN(instance_bounds.size() - i, RendererSceneCull::InstanceBounds::FRUSTUM_BLOCK_SIZE);
+		const RendererSceneCull::InstanceBounds *block_bounds[RendererSceneCull::InstanceBounds::FRUSTUM_BLOCK_SIZE];
+		for (uint32_t k = 0; k < block_count; k++) {
+			block_bounds[k] = &instance_bounds[i + k];
+		}
+
+		const uint32_t mask = RendererSceneCull::InstanceBounds::in_frustum_block(block_bounds, block_count, frustum);
+		CHECK((mask >> block_count) == 0);
+		for (uint32_t k = 0; k < block_count; k++) {
+			const bool in_frustum = instance_bounds[i + k].in_frustum(frustum);
+			CHECK(bool(mask & (1u << k)) == in_frustum);
+			in_frustum_count += in_frustum;
+		}
+	}
+	CHECK(in_frustum_count > 0);
+	CHECK(in_frustum_count < instance_bounds.size());
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
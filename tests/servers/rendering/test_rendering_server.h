@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  test_rendering_server.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_SERVER_H
+#define TEST_RENDERING_SERVER_H
+
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServer {
+
+TEST_CASE("[SceneTree][RenderingServer] Sparse MultiMesh buffer updates match a full buffer update") {
+	// 3D transform followed by a color.
+	const int stride = 16;
+	const int instance_count = 8;
+
+	RID sparse_multimesh = RS::get_singleton()->multimesh_create();
+	RID full_multimesh = RS::get_singleton()->multimesh_create();
+	RS::get_singleton()->multimesh_allocate_data(sparse_multimesh, instance_count, RS::MULTIMESH_TRANSFORM_3D, true);
+	RS::get_singleton()->multimesh_allocate_data(full_multimesh, instance_count, RS::MULTIMESH_TRANSFORM_3D, true);
+
+	Vector<float> buffer;
+	buffer.resize(instance_count * stride);
+	for (int i = 0; i < buffer.size(); i++) {
+		buffer.write[i] = i * 0.5;
+	}
+	RS::get_singleton()->multimesh_set_buffer(sparse_multimesh, buffer);
+
+	const Vector<int> instances = { 6, 1, 4 };
+	Vector<float> instance_buffer;
+	for (int i = 0; i < instances.size(); i++) {
+		for (int j = 0; j < stride; j++) {
+			const float value = 1000.0 + i * stride + j;
+			instance_buffer.push_back(value);
+			buffer.write[instances[i] * stride + j] = value;
+		}
+	}
+	RS::get_singleton()->multimesh_set_buffer_instances(sparse_multimesh, instances, instance_buffer);
+	RS::get_singleton()->multimesh_set_buffer(full_multimesh, buffer);
+
+	CHECK(RS::get_singleton()->multimesh_get_buffer(full_multimesh) == buffer);
+	CHECK(RS::get_singleton()->multimesh_get_buffer(sparse_multimesh) == RS::get_singleton()->multimesh_get_buffer(full_multimesh));
+
+	SUBCASE("Out of range instances are skipped") {
+		Vector<float> out_of_range_buffer;
+		out_of_range_buffer.resize(stride * 2);
+		out_of_range_buffer.fill(-1.0);
+
+		ERR_PRINT_OFF;
+		RS::get_singleton()->multimesh_set_buffer_instances(sparse_multimesh, { instance_count, -1 }, out_of_range_buffer);
+		ERR_PRINT_ON;
+
+		CHECK(RS::get_singleton()->multimesh_get_buffer(sparse_multimesh) == buffer);
+	}
+
+	SUBCASE("Buffers that don't match the instance stride are rejected") {
+		// A transform without the color, which would be a valid stride for a different format.
+		Vector<float> short_buffer;
+		short_buffer.resize(12 * 4);
+		short_buffer.fill(-1.0);
+
+		ERR_PRINT_OFF;
+		RS::get_singleton()->multimesh_set_buffer_instances(sparse_multimesh, { 0, 1, 2, 3 }, short_buffer);
+		ERR_PRINT_ON;
+
+		CHECK(RS::get_singleton()->multimesh_get_buffer(sparse_multimesh) == buffer);
+	}
+
+	RS::get_singleton()->free(sparse_multimesh);
+	RS::get_singleton()->free(full_multimesh);
+}
+
+} // namespace TestRenderingServer
+
+#endif // TEST_RENDERING_SERVER_H
@@ -0,0 +1,258 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/config/project_settings.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+class TestShaderCompilerInternalsAccessor {
+public:
+	static int get_compile_cache_size(const ShaderCompiler &p_compiler) {
+		return p_compiler.compile_cache.size();
+	}
+};
+
+namespace TestShaderCompiler {
+
+// Mirrors how the scene shader of a renderer hooks its state up to the compiler.
+struct ShaderState {
+	int blend_mode = 0;
+	bool unshaded = false;
+	bool uses_alpha = false;
+	bool uses_time = false;
+	bool writes_vertex = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::IdentifierActions actions;
+
+	ShaderState() {
+		actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_mode, 0);
+		actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_mode, 1);
+		actions.render_mode_flags["unshaded"] = &unshaded;
+		actions.usage_flag_pointers["ALPHA"] = &uses_alpha;
+		actions.usage_flag_pointers["TIME"] = &uses_time;
+		actions.write_flag_pointers["VERTEX"] = &writes_vertex;
+		actions.uniforms = &uniforms;
+	}
+};
+
+static void create_compiler(ShaderCompiler &r_compiler, int p_max_cache_entries) {
+	ProjectSettings::get_singleton()->set_setting("rendering/shader_compiler/compile_cache/max_entries", p_max_cache_entries);
+
+	ShaderCompiler::DefaultIdentifierActions actions;
+	actions.renames["VERTEX"] = "vertex";
+	actions.renames["UV"] = "uv_interp";
+	actions.renames["ALBEDO"] = "albedo";
+	actions.renames["ALPHA"] = "alpha";
+	actions.renames["TIME"] = "global_time";
+	actions.render_mode_defines["unshaded"] = "#define MODE_UNSHADED\n";
+	actions.usage_defines["ALPHA"] = "#define USE_ALPHA\n";
+	actions.base_texture_binding_index = 1;
+	actions.texture_layout_set = 2;
+	actions.base_uniform_string = "material.";
+	actions.global_buffer_array_variable = "global_shader_uniforms.data";
+	actions.instance_uniform_index_variable = "instances.data[instance_index_interp].instance_uniforms_ofs";
+	r_compiler.initialize(actions);
+}
+
+static void check_generated_code_equal(const ShaderCompiler::GeneratedCode &p_a, const ShaderCompiler::GeneratedCode &p_b) {
+	CHECK(p_a.defines == p_b.defines);
+	CHECK(p_a.uniform_offsets == p_b.uniform_offsets);
+	CHECK(p_a.uniform_total_size == p_b.uniform_total_size);
+	CHECK(p_a.uniforms == p_b.uniforms);
+	for (int i = 0; i < ShaderCompiler::STAGE_MAX; i++) {
+		CHECK(p_a.stage_globals[i] == p_b.stage_globals[i]);
+	}
+
+	REQUIRE(p_a.code.size() == p_b.code.size());
+	for (const KeyValue<String, String> &E : p_a.code) {
+		REQUIRE(p_b.code.has(E.key));
+		CHECK(p_b.code[E.key] == E.value);
+	}
+
+	REQUIRE(p_a.texture_uniforms.size() == p_b.texture_uniforms.size());
+	for (int i = 0; i < p_a.texture_uniforms.size(); i++) {
+		const ShaderCompiler::GeneratedCode::Texture &texture_a = p_a.texture_uniforms[i];
+		const ShaderCompiler::GeneratedCode::Texture &texture_b = p_b.texture_uniforms[i];
+		CHECK(texture_a.name == texture_b.name);
+		CHECK(texture_a.type == texture_b.type);
+		CHECK(texture_a.hint == texture_b.hint);
+		CHECK(texture_a.use_color == texture_b.use_color);
+		CHECK(texture_a.filter == texture_b.filter);
+		CHECK(texture_a.repeat == texture_b.repeat);
+		CHECK(texture_a.global == texture_b.global);
+		CHECK(texture_a.array_size == texture_b.array_size);
+	}
+
+	CHECK(p_a.uses_global_textures == p_b.uses_global_textures);
+	CHECK(p_a.uses_fragment_time == p_b.uses_fragment_time);
+	CHECK(p_a.uses_vertex_time == p_b.uses_vertex_time);
+	CHECK(p_a.uses_screen_texture_mipmaps == p_b.uses_screen_texture_mipmaps);
+	CHECK(p_a.uses_screen_texture == p_b.uses_screen_texture);
+	CHECK(p_a.uses_depth_texture == p_b.uses_depth_texture);
+	CHECK(p_a.uses_normal_roughness_texture == p_b.uses_normal_roughness_texture);
+}
+
+static void check_shader_state_equal(const ShaderState &p_a, const ShaderState &p_b) {
+	CHECK(p_a.blend_mode == p_b.blend_mode);
+	CHECK(p_a.unshaded == p_b.unshaded);
+	CHECK(p_a.uses_alpha == p_b.uses_alpha);
+	CHECK(p_a.uses_time == p_b.uses_time);
+	CHECK(p_a.writes_vertex == p_b.writes_vertex);
+
+	REQUIRE(p_a.uniforms.size() == p_b.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_a.uniforms) {
+		REQUIRE(p_b.uniforms.has(E.key));
+		const ShaderLanguage::ShaderNode::Uniform &uniform = p_b.uniforms[E.key];
+		CHECK(uniform.order == E.value.order);
+		CHECK(uniform.texture_order == E.value.texture_order);
+		CHECK(uniform.texture_binding == E.value.texture_binding);
+		CHECK(uniform.type == E.value.type);
+		CHECK(uniform.scope == E.value.scope);
+		CHECK(uniform.hint == E.value.hint);
+		CHECK(uniform.use_color == E.value.use_color);
+		CHECK(uniform.default_value.size() == E.value.default_value.size());
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Cached compilations match a fresh compilation") {
+	const String code = R"(
+shader_type spatial;
+render_mode blend_add, unshaded;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform float height = 1.0;
+uniform sampler2D albedo_texture : source_color, filter_linear;
+
+void vertex() {
+	VERTEX.y += sin(TIME) * height;
+}
+
+void fragment() {
+	ALBEDO = tint.rgb * texture(albedo_texture, UV).rgb;
+	ALPHA = 0.5;
+}
+)";
+
+	const Variant max_entries = GLOBAL_GET("rendering/shader_compiler/compile_cache/max_entries");
+
+	// Without a cache, every compilation takes the full path.
+	ShaderCompiler reference_compiler;
+	create_compiler(reference_compiler, 0);
+	ShaderState reference_state;
+	ShaderCompiler::GeneratedCode reference_code;
+	REQUIRE(reference_compiler.compile(RS::SHADER_SPATIAL, code, &reference_state.actions, "", reference_code) == OK);
+	CHECK(TestShaderCompilerInternalsAccessor::get_compile_cache_size(reference_compiler) == 0);
+
+	CHECK(reference_state.blend_mode == 1);
+	CHECK(reference_state.unshaded);
+	CHECK(reference_state.uses_alpha);
+	CHECK(reference_state.uses_time);
+	CHECK(reference_state.writes_vertex);
+	CHECK(reference_state.uniforms.size() == 3);
+
+	ShaderCompiler compiler;
+	create_compiler(compiler, 16);
+
+	ShaderState fresh_state;
+	ShaderCompiler::GeneratedCode fresh_code;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, code, &fresh_state.actions, "", fresh_code) == OK);
+	CHECK(TestShaderCompilerInternalsAccessor::get_compile_cache_size(compiler) == 1);
+
+	ShaderState cached_state;
+	ShaderCompiler::GeneratedCode cached_code;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, code, &cached_state.actions, "", cached_code) == OK);
+	CHECK_MESSAGE(TestShaderCompilerInternalsAccessor::get_compile_cache_size(compiler) == 1, "Compiling the same code again should reuse the cached entry.");
+
+	SUBCASE("The first compilation with a cache matches a compilation without one") {
+		check_generated_code_equal(reference_code, fresh_code);
+		check_shader_state_equal(reference_state, fresh_state);
+	}
+
+	SUBCASE("A cached compilation matches the fresh one") {
+		check_generated_code_equal(fresh_code, cached_code);
+		check_shader_state_equal(fresh_state, cached_state);
+	}
+
+	SUBCASE("Different code is cached separately") {
+		const String other_code = code.replace("blend_add", "blend_mix");
+		ShaderState other_state;
+		ShaderCompiler::GeneratedCode other_code_gen;
+		REQUIRE(compiler.compile(RS::SHADER_SPATIAL, other_code, &other_state.actions, "", other_code_gen) == OK);
+		CHECK(TestShaderCompilerInternalsAccessor::get_compile_cache_size(compiler) == 2);
+		CHECK(other_state.blend_mode == 0);
+	}
+
+	ProjectSettings::get_singleton()->set_setting("rendering/shader_compiler/compile_cache/max_entries", max_entries);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Shaders using global uniforms are not cached") {
+	const String code = R"(
+shader_type spatial;
+
+global uniform vec4 global_tint;
+uniform vec4 tint : source_color = vec4(1.0);
+
+void fragment() {
+	ALBEDO = global_tint.rgb * tint.rgb;
+}
+)";
+
+	const Variant max_entries = GLOBAL_GET("rendering/shader_compiler/compile_cache/max_entries");
+
+	ShaderCompiler compiler;
+	create_compiler(compiler, 16);
+
+	ShaderState first_state;
+	ShaderCompiler::GeneratedCode first_code;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, code, &first_state.actions, "", first_code) == OK);
+	CHECK(TestShaderCompilerInternalsAccessor::get_compile_cache_size(compiler) == 0);
+
+	ShaderState second_state;
+	ShaderCompiler::GeneratedCode second_code;
+	REQUIRE(compiler.compile(RS::SHADER_SPATIAL, code, &second_state.actions, "", second_code) == OK);
+	CHECK(TestShaderCompilerInternalsAccessor::get_compile_cache_size(compiler) == 0);
+
+	REQUIRE(first_state.uniforms.has("global_tint"));
+	CHECK(first_state.uniforms["global_tint"].scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_GLOBAL);
+	check_generated_code_equal(first_code, second_code);
+	check_shader_state_equal(first_state, second_state);
+
+	ProjectSettings::get_singleton()->set_setting("rendering/shader_compiler/compile_cache/max_entries", max_entries);
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
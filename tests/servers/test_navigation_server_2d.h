@@ -31,16 +31,100 @@
 #ifndef TEST_NAVIGATION_SERVER_2D_H
 #define TEST_NAVIGATION_SERVER_2D_H
 
+#include "scene/resources/2d/navigation_polygon.h"
 #include "servers/navigation_server_2d.h"
+#include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
 namespace TestNavigationServer2D {
+
+class PathQueryCallbackMock : public Object {
+	GDCLASS(PathQueryCallbackMock, Object);
+
+public:
+	void callback() {
+		calls++;
+		path_size = query_result->get_path().size();
+	}
+
+	Ref<NavigationPathQueryResult2D> query_result;
+	unsigned calls{ 0 };
+	int path_size{ 0 };
+};
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer2D] Server should be empty when initialized") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer2D] Server should answer asynchronous path queries") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+		// The 2D server commits its commands and finishes the queries in the 3D server process.
+		NavigationServer3D *navigation_server_3d = NavigationServer3D::get_singleton();
+
+		Ref<NavigationPolygon> navigation_polygon = memnew(NavigationPolygon);
+		navigation_polygon->set_vertices({ Vector2(0, 0), Vector2(100, 0), Vector2(100, 100), Vector2(0, 100) });
+		navigation_polygon->add_polygon({ 0, 1, 2, 3 });
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, navigation_polygon);
+		navigation_server_3d->process(0.0); // Give server some cycles to commit.
+
+		TypedArray<NavigationPathQueryParameters2D> query_parameters;
+		TypedArray<NavigationPathQueryResult2D> query_results;
+		for (int i = 0; i < 8; i++) {
+			Ref<NavigationPathQueryParameters2D> parameters = memnew(NavigationPathQueryParameters2D);
+			parameters->set_map(map);
+			parameters->set_start_position(Vector2(10 + i * 10, 10));
+			parameters->set_target_position(Vector2(90, 90 - i * 10));
+			query_parameters.push_back(parameters);
+			query_results.push_back(memnew(NavigationPathQueryResult2D));
+		}
+
+		// The results must be set before the callback is called.
+		PathQueryCallbackMock callback_mock;
+		callback_mock.query_result = query_results[0];
+		const int64_t query_id = navigation_server->query_paths_async(query_parameters, query_results, callable_mp(&callback_mock, &PathQueryCallbackMock::callback));
+		CHECK_NE(query_id, -1);
+
+		SUBCASE("Asynchronous queries should yield the same results as synchronous ones") {
+			navigation_server_3d->process(0.0); // Give server some cycles to finish the queries.
+			CHECK(navigation_server->is_path_query_finished(query_id));
+			CHECK_EQ(callback_mock.calls, 1);
+			CHECK_GT(callback_mock.path_size, 0);
+
+			for (int i = 0; i < query_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult2D> query_result = memnew(NavigationPathQueryResult2D);
+				navigation_server->query_path(query_parameters[i], query_result);
+				Ref<NavigationPathQueryResult2D> async_query_result = query_results[i];
+				CHECK_NE(async_query_result->get_path().size(), 0);
+				CHECK_EQ(async_query_result->get_path(), query_result->get_path());
+				CHECK_EQ(async_query_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
+		SUBCASE("Queries should finish before their map is freed") {
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server_3d->process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->is_path_query_finished(query_id));
+			CHECK_EQ(callback_mock.calls, 1);
+			CHECK_GT(callback_mock.path_size, 0);
+			region = RID();
+			map = RID();
+		}
+
+		if (region.is_valid()) {
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server_3d->process(0.0); // Give server some cycles to commit.
+		}
+	}
 }
 } //namespace TestNavigationServer2D
 
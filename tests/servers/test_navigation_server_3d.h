@@ -31,7 +31,9 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/navigation_region_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
 
@@ -51,6 +53,22 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+class SourceGeometryParserMock : public Object {
+	GDCLASS(SourceGeometryParserMock, Object);
+
+public:
+	void parse(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_node) {
+		parse_calls++;
+		if (p_node == marker) {
+			p_source_geometry_data->add_faces(faces, Transform3D());
+		}
+	}
+
+	Node *marker = nullptr;
+	PackedVector3Array faces;
+	unsigned parse_calls{ 0 };
+};
+
 static inline Array build_array() {
 	return Array();
 }
@@ -61,6 +79,52 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// Checks that the regions of the map are stitched and queried like in a map built from scratch.
+static inline void check_map_matches_rebuild(RID p_map, const Ref<NavigationMesh> &p_navigation_mesh, const Vector<Vector3> &p_points) {
+	NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+	// Regions are added in the same order, it decides between polygons at the same distance.
+	RID rebuilt_map = navigation_server->map_create();
+	navigation_server->map_set_active(rebuilt_map, true);
+	navigation_server->map_set_edge_connection_margin(rebuilt_map, navigation_server->map_get_edge_connection_margin(p_map));
+	const TypedArray<RID> map_regions = navigation_server->map_get_regions(p_map);
+	Vector<RID> regions;
+	Vector<RID> rebuilt_regions;
+	for (int i = 0; i < map_regions.size(); i++) {
+		const RID region = map_regions[i];
+		if (!navigation_server->region_get_enabled(region)) {
+			continue;
+		}
+		RID rebuilt_region = navigation_server->region_create();
+		navigation_server->region_set_transform(rebuilt_region, navigation_server->region_get_transform(region));
+		navigation_server->region_set_navigation_layers(rebuilt_region, navigation_server->region_get_navigation_layers(region));
+		navigation_server->region_set_navigation_mesh(rebuilt_region, p_navigation_mesh);
+		navigation_server->region_set_map(rebuilt_region, rebuilt_map);
+		regions.push_back(region);
+		rebuilt_regions.push_back(rebuilt_region);
+	}
+	navigation_server->process(0.0); // Give server some cycles to commit.
+
+	for (int i = 0; i < regions.size(); i++) {
+		CHECK_EQ(navigation_server->region_get_connections_count(regions[i]), navigation_server->region_get_connections_count(rebuilt_regions[i]));
+	}
+
+	for (const Vector3 &from : p_points) {
+		CHECK_EQ(navigation_server->map_get_closest_point(p_map, from), navigation_server->map_get_closest_point(rebuilt_map, from));
+		CHECK_EQ(regions.find(navigation_server->map_get_closest_point_owner(p_map, from)), rebuilt_regions.find(navigation_server->map_get_closest_point_owner(rebuilt_map, from)));
+
+		for (const Vector3 &to : p_points) {
+			CHECK_EQ(navigation_server->map_get_path(p_map, from, to, true), navigation_server->map_get_path(rebuilt_map, from, to, true));
+		}
+	}
+
+	for (const RID &rebuilt_region : rebuilt_regions) {
+		navigation_server->free(rebuilt_region);
+	}
+	navigation_server->free(rebuilt_map);
+	navigation_server->process(0.0); // Give server some cycles to commit.
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -605,6 +669,51 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(source_geometry->get_indices().size(), 6);
 		}
 
+		SUBCASE("Parsed geometry should be complete when parsing with a callback returns") {
+			source_geometry->clear();
+			CallableMock callback_mock;
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, mesh_instance, callable_mp(&callback_mock, &CallableMock::function1).bind(source_geometry));
+			CHECK_EQ(callback_mock.function1_calls, 1);
+			CHECK_EQ(source_geometry->get_vertices().size(), 12);
+			CHECK_EQ(source_geometry->get_indices().size(), 6);
+			CHECK_FALSE(navigation_server->is_baking_navigation_mesh(navigation_mesh));
+		}
+
+		SUBCASE("Asynchronous parsing should count as baking until the callback is called") {
+			const Vector<float> vertices = source_geometry->get_vertices();
+			const Vector<int> indices = source_geometry->get_indices();
+
+			CallableMock callback_mock;
+			navigation_server->parse_source_geometry_data_async(navigation_mesh, source_geometry, mesh_instance, callable_mp(&callback_mock, &CallableMock::function1).bind(source_geometry));
+			CHECK(navigation_server->is_baking_navigation_mesh(navigation_mesh));
+			CHECK_EQ(callback_mock.function1_calls, 0);
+
+			// Neither parsing nor baking the same navigation mesh again should start in the meantime.
+			Ref<NavigationMeshSourceGeometryData3D> other_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			Array arr;
+			arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+			other_source_geometry->add_mesh_array(arr, Transform3D());
+			CallableMock rejected_callback_mock;
+			ERR_PRINT_OFF;
+			navigation_server->parse_source_geometry_data_async(navigation_mesh, other_source_geometry, mesh_instance, callable_mp(&rejected_callback_mock, &CallableMock::function1).bind(other_source_geometry));
+			navigation_server->bake_from_source_geometry_data_async(navigation_mesh, other_source_geometry, callable_mp(&rejected_callback_mock, &CallableMock::function1).bind(other_source_geometry));
+			ERR_PRINT_ON;
+
+			for (int i = 0; i < 1000 && callback_mock.function1_calls == 0; i++) {
+				navigation_server->sync(); // Dispatches the callbacks of parsing that finished in the background.
+				OS::get_singleton()->delay_usec(1000);
+			}
+			CHECK_EQ(callback_mock.function1_calls, 1);
+			CHECK_FALSE(navigation_server->is_baking_navigation_mesh(navigation_mesh));
+			CHECK_EQ(source_geometry->get_vertices(), vertices);
+			CHECK_EQ(source_geometry->get_indices(), indices);
+
+			navigation_server->sync();
+			CHECK_EQ(rejected_callback_mock.function1_calls, 0);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), 0);
+		}
+
 		SUBCASE("Parsed geometry should be extendible with other geometry") {
 			source_geometry->merge(source_geometry); // Merging with itself.
 			const Vector<float> vertices = source_geometry->get_vertices();
@@ -623,6 +732,103 @@ TEST_SUITE("[Navigation]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D][SceneTree] Parsed geometry should keep the SceneTree order") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A custom parser that adds a single face for the marker node, between the two meshes.
+		Node3D *node_3d = memnew(Node3D);
+		SceneTree::get_singleton()->get_root()->add_child(node_3d);
+		Ref<PlaneMesh> plane_mesh = memnew(PlaneMesh);
+		plane_mesh->set_size(Size2(10.0, 10.0));
+		MeshInstance3D *first_mesh_instance = memnew(MeshInstance3D);
+		first_mesh_instance->set_mesh(plane_mesh);
+		node_3d->add_child(first_mesh_instance);
+		Node3D *marker = memnew(Node3D);
+		node_3d->add_child(marker);
+		MeshInstance3D *second_mesh_instance = memnew(MeshInstance3D);
+		second_mesh_instance->set_mesh(plane_mesh);
+		second_mesh_instance->set_position(Vector3(20.0, 0.0, 0.0));
+		node_3d->add_child(second_mesh_instance);
+
+		PackedVector3Array marker_faces;
+		marker_faces.push_back(Vector3(0.0, 1.0, 0.0));
+		marker_faces.push_back(Vector3(1.0, 1.0, 0.0));
+		marker_faces.push_back(Vector3(0.0, 1.0, 1.0));
+
+		SourceGeometryParserMock parser_mock;
+		parser_mock.marker = marker;
+		parser_mock.faces = marker_faces;
+		RID parser = navigation_server->source_geometry_parser_create();
+		navigation_server->source_geometry_parser_set_callback(parser, callable_mp(&parser_mock, &SourceGeometryParserMock::parse));
+
+		Ref<NavigationMeshSourceGeometryData3D> expected_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		expected_source_geometry->add_mesh(plane_mesh, first_mesh_instance->get_global_transform());
+		expected_source_geometry->add_faces(marker_faces, Transform3D());
+		expected_source_geometry->add_mesh(plane_mesh, second_mesh_instance->get_global_transform());
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		SUBCASE("Synchronous parsing") {
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+		}
+
+		SUBCASE("Asynchronous parsing") {
+			CallableMock callback_mock;
+			navigation_server->parse_source_geometry_data_async(navigation_mesh, source_geometry, node_3d, callable_mp(&callback_mock, &CallableMock::function1).bind(source_geometry));
+			for (int i = 0; i < 1000 && callback_mock.function1_calls == 0; i++) {
+				navigation_server->sync(); // Dispatches the callbacks of parsing that finished in the background.
+				OS::get_singleton()->delay_usec(1000);
+			}
+			CHECK_EQ(callback_mock.function1_calls, 1);
+		}
+
+		CHECK_EQ(parser_mock.parse_calls, 4);
+		CHECK_EQ(source_geometry->get_vertices(), expected_source_geometry->get_vertices());
+		CHECK_EQ(source_geometry->get_indices(), expected_source_geometry->get_indices());
+
+		navigation_server->free(parser);
+		memdelete(second_mesh_instance);
+		memdelete(marker);
+		memdelete(first_mesh_instance);
+		memdelete(node_3d);
+	}
+
+	TEST_CASE("[NavigationServer3D][SceneTree] NavigationRegion3D should not start a second bake while parsing") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		NavigationRegion3D *navigation_region = memnew(NavigationRegion3D);
+		SceneTree::get_singleton()->get_root()->add_child(navigation_region);
+		Ref<PlaneMesh> plane_mesh = memnew(PlaneMesh);
+		plane_mesh->set_size(Size2(10.0, 10.0));
+		MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+		mesh_instance->set_mesh(plane_mesh);
+		navigation_region->add_child(mesh_instance);
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_region->set_navigation_mesh(navigation_mesh);
+
+		SIGNAL_WATCH(navigation_region, "bake_finished");
+		navigation_region->bake_navigation_mesh(true);
+		CHECK(navigation_region->is_baking());
+
+		ERR_PRINT_OFF;
+		navigation_region->bake_navigation_mesh(true);
+		ERR_PRINT_ON;
+
+		for (int i = 0; i < 1000 && navigation_region->is_baking(); i++) {
+			navigation_server->sync(); // Dispatches the callbacks of parsing and baking that finished in the background.
+			OS::get_singleton()->delay_usec(1000);
+		}
+		CHECK_FALSE(navigation_region->is_baking());
+		SIGNAL_CHECK("bake_finished", build_array(build_array()));
+		SIGNAL_UNWATCH(navigation_region, "bake_finished");
+		CHECK_EQ(navigation_mesh->get_polygon_count(), 2);
+
+		memdelete(mesh_instance);
+		memdelete(navigation_region);
+	}
+
 	// This test case uses only public APIs on purpose - other test cases use simplified baking.
 	TEST_CASE("[NavigationServer3D][SceneTree] Server should be able to bake map correctly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -697,8 +903,9 @@ TEST_SUITE("[Navigation]") {
 			CHECK_NE(navigation_server->map_get_closest_point(map, Vector3(0, 0, 0)), Vector3(0, 0, 0));
 			CHECK_NE(navigation_server->map_get_closest_point_normal(map, Vector3(0, 0, 0)), Vector3());
 			CHECK(navigation_server->map_get_closest_point_owner(map, Vector3(0, 0, 0)).is_valid());
-			// TODO: Test map_get_closest_point_to_segment() with p_use_collision=true as well.
 			CHECK_NE(navigation_server->map_get_closest_point_to_segment(map, Vector3(0, 0, 0), Vector3(1, 1, 1), false), Vector3());
+			CHECK_NE(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 1, 1), Vector3(1, -1, 1), true), Vector3());
+			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 5, 1), Vector3(1, 4, 1), true), Vector3());
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), true).size(), 0);
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), false).size(), 0);
 		}
@@ -759,6 +966,222 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Asynchronous queries should yield the same results as synchronous ones") {
+			TypedArray<NavigationPathQueryParameters3D> query_parameters;
+			TypedArray<NavigationPathQueryResult3D> query_results;
+			for (int i = 0; i < 8; i++) {
+				Ref<NavigationPathQueryParameters3D> parameters = memnew(NavigationPathQueryParameters3D);
+				parameters->set_map(map);
+				parameters->set_start_position(Vector3(i, 0, 0));
+				parameters->set_target_position(Vector3(10, 0, 10 - i));
+				query_parameters.push_back(parameters);
+				query_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			const int64_t query_id = navigation_server->query_paths_async(query_parameters, query_results);
+			CHECK_NE(query_id, -1);
+			navigation_server->process(0.0); // Give server some cycles to finish the queries.
+			CHECK(navigation_server->is_path_query_finished(query_id));
+
+			for (int i = 0; i < query_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(query_parameters[i], query_result);
+				Ref<NavigationPathQueryResult3D> async_query_result = query_results[i];
+				CHECK_NE(async_query_result->get_path().size(), 0);
+				CHECK_EQ(async_query_result->get_path(), query_result->get_path());
+				CHECK_EQ(async_query_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		// The setting is read when the map is created, use clusters of a single polygon.
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 1);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 64);
+
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-5, 0, -5), Vector3(5, 0, 5), true);
+		REQUIRE_GT(path.size(), 1);
+		CHECK(path[0].is_equal_approx(navigation_server->map_get_closest_point(map, Vector3(-5, 0, -5))));
+		CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, Vector3(5, 0, 5))));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should stitch changed regions like a full rebuild") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A 2x2 square.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(2, 0, 0), Vector3(2, 0, 2), Vector3(0, 0, 2) });
+		navigation_mesh->add_polygon({ 0, 1, 2, 3 });
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_edge_connection_margin(map, 1.0);
+
+		// The first two regions and the last two share an edge, the middle ones are connected across a gap.
+		const real_t offsets[4] = { 0.0, 2.0, 4.5, 6.5 };
+		RID regions[4];
+		for (int i = 0; i < 4; i++) {
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_transform(regions[i], Transform3D(Basis(), Vector3(offsets[i], 0, 0)));
+			navigation_server->region_set_navigation_mesh(regions[i], navigation_mesh);
+			navigation_server->region_set_map(regions[i], map);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Points inside each region, and above the shared edges where the regions are at the same distance.
+		const Vector<Vector3> points = { Vector3(0.5, 0, 1), Vector3(3, 0, 1.5), Vector3(5, 0, 0.5), Vector3(8, 0, 1), Vector3(2, 1, 1), Vector3(6.5, 1, 1), Vector3(4.25, 0, 1) };
+
+		REQUIRE_GT(navigation_server->map_get_path(map, points[0], points[3], true).size(), 1);
+		check_map_matches_rebuild(map, navigation_mesh, points);
+
+		SUBCASE("Removing and adding regions") {
+			navigation_server->region_set_map(regions[1], RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+
+			navigation_server->region_set_map(regions[1], map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+		}
+
+		SUBCASE("Toggling regions") {
+			navigation_server->region_set_enabled(regions[2], false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+
+			navigation_server->region_set_enabled(regions[0], false);
+			navigation_server->region_set_enabled(regions[2], true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+
+			navigation_server->region_set_enabled(regions[0], true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+		}
+
+		SUBCASE("Moving regions") {
+			navigation_server->region_set_transform(regions[3], Transform3D(Basis(), Vector3(10, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+
+			navigation_server->region_set_transform(regions[3], Transform3D(Basis(), Vector3(offsets[3], 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+		}
+
+		SUBCASE("Changing navigation layers") {
+			navigation_server->region_set_navigation_layers(regions[3], 2);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			check_map_matches_rebuild(map, navigation_mesh, points);
+			// Paths on the default layer end on the region before it.
+			const Vector<Vector3> path = navigation_server->map_get_path(map, points[0], points[3], true);
+			REQUIRE_GT(path.size(), 1);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(offsets[3], 0, 1)));
+		}
+
+		for (int i = 0; i < 4; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake tiled navigation meshes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		const int untiled_polygon_count = navigation_mesh->get_polygon_count();
+		CHECK_NE(untiled_polygon_count, 0);
+
+		navigation_mesh->set_tile_size(2.0);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_GT(navigation_mesh->get_polygon_count(), untiled_polygon_count);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Tiles should be stitched into a single connected navigation mesh") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(4, 0, 4), true);
+			REQUIRE_GT(path.size(), 1);
+			CHECK(path[path.size() - 1].is_equal_approx(navigation_server->map_get_closest_point(map, Vector3(4, 0, 4))));
+		}
+
+		SUBCASE("Rebaking unchanged source geometry should yield the same navigation mesh") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should lead to the destination with flow fields") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const Vector3 destination = navigation_server->map_get_closest_point(map, Vector3(5, 0, 5));
+		Vector3 position = navigation_server->map_get_closest_point(map, Vector3(-5, 0, -5));
+		for (int i = 0; i < 16 && !position.is_equal_approx(destination); i++) {
+			position = navigation_server->map_get_flow_field_next_position(map, position, destination);
+		}
+		CHECK(position.is_equal_approx(destination));
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
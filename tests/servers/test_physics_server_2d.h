@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Contact impulses of a resting body stay stable") {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+
+	const real_t gravity = 980.0;
+	const real_t step = 1.0 / 60.0;
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, gravity);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID ground_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(ground_shape, Vector2(100, 10));
+	RID ground = physics_server->body_create();
+	physics_server->body_set_mode(ground, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(ground, ground_shape);
+	physics_server->body_set_space(ground, space);
+
+	// Box of mass 1, placed right on top of the ground.
+	RID box_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box_shape, Vector2(10, 10));
+	RID box = physics_server->body_create();
+	physics_server->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(box, box_shape);
+	physics_server->body_set_param(box, PhysicsServer2D::BODY_PARAM_MASS, 1.0);
+	physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, -20)));
+	physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+	physics_server->body_set_max_contacts_reported(box, 4);
+	physics_server->body_set_space(box, space);
+
+	// Let the contacts settle first.
+	for (int i = 0; i < 60; i++) {
+		physics_server->step(step);
+	}
+
+	// Each step, the contacts have to carry the weight of the box for one step, no more.
+	const real_t weight_impulse = gravity * step;
+	for (int i = 0; i < 240; i++) {
+		physics_server->step(step);
+
+		PhysicsDirectBodyState2D *state = physics_server->body_get_direct_state(box);
+		REQUIRE(state != nullptr);
+		REQUIRE(state->get_contact_count() > 0);
+		CHECK(state->get_contact_count() <= 2);
+
+		Vector2 total_impulse;
+		for (int j = 0; j < state->get_contact_count(); j++) {
+			total_impulse += state->get_contact_impulse(j);
+		}
+		CHECK(total_impulse.length() == doctest::Approx(weight_impulse).epsilon(0.1));
+	}
+
+	Transform2D box_transform = physics_server->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM);
+	CHECK(box_transform.get_origin().distance_to(Vector2(0, -20)) < 1.0);
+
+	physics_server->free(box);
+	physics_server->free(box_shape);
+	physics_server->free(ground);
+	physics_server->free(ground_shape);
+	physics_server->free(space);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,365 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_3d/godot_body_3d.h"
+#include "servers/physics_3d/godot_broad_phase_3d_bvh.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Bodies state buffer") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(shape, 1.0);
+
+	Vector<RID> bodies;
+	for (int i = 0; i < 2; i++) {
+		RID body = physics_server->body_create();
+		physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(body, shape);
+		physics_server->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+
+	const Transform3D transforms[2] = {
+		Transform3D(Basis(Vector3(0, 1, 0), Math_PI * 0.5), Vector3(1, 2, 3)),
+		Transform3D(Basis(), Vector3(-4, 5, -6)),
+	};
+	const Vector3 linear_velocities[2] = { Vector3(1, 0, 0), Vector3(0, -2, 0) };
+	const Vector3 angular_velocities[2] = { Vector3(0, 0, 3), Vector3(4, 0, 0) };
+
+	Vector<float> buffer;
+	buffer.resize(2 * PhysicsServer3D::BODIES_STATE_BUFFER_STRIDE);
+	for (int i = 0; i < 2; i++) {
+		float *w = buffer.ptrw() + i * PhysicsServer3D::BODIES_STATE_BUFFER_STRIDE;
+		// Basis rows, each followed by the matching origin component.
+		for (int j = 0; j < 3; j++) {
+			w[j * 4 + 0] = transforms[i].basis.rows[j][0];
+			w[j * 4 + 1] = transforms[i].basis.rows[j][1];
+			w[j * 4 + 2] = transforms[i].basis.rows[j][2];
+			w[j * 4 + 3] = transforms[i].origin[j];
+		}
+		for (int j = 0; j < 3; j++) {
+			w[12 + j] = linear_velocities[i][j];
+			w[15 + j] = angular_velocities[i][j];
+		}
+	}
+
+	SUBCASE("Round trip") {
+		physics_server->bodies_set_state_buffer(bodies, buffer);
+
+		for (int i = 0; i < 2; i++) {
+			Transform3D transform = physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(transforms[i]));
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)).is_equal_approx(linear_velocities[i]));
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)).is_equal_approx(angular_velocities[i]));
+		}
+
+		Vector<float> result = physics_server->bodies_get_state_buffer(bodies);
+		REQUIRE(result.size() == buffer.size());
+		for (int i = 0; i < buffer.size(); i++) {
+			CHECK(result[i] == doctest::Approx(buffer[i]));
+		}
+	}
+
+	SUBCASE("Mask") {
+		physics_server->bodies_set_state_buffer(bodies, buffer, PhysicsServer3D::BODY_STATE_BUFFER_TRANSFORM);
+
+		for (int i = 0; i < 2; i++) {
+			Transform3D transform = physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(transform.is_equal_approx(transforms[i]));
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3());
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)) == Vector3());
+		}
+
+		physics_server->bodies_set_state_buffer(bodies, buffer, PhysicsServer3D::BODY_STATE_BUFFER_ANGULAR_VELOCITY);
+
+		for (int i = 0; i < 2; i++) {
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3());
+			CHECK(Vector3(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY)).is_equal_approx(angular_velocities[i]));
+		}
+	}
+
+	SUBCASE("Sleeping bodies") {
+		for (int i = 0; i < 2; i++) {
+			physics_server->body_set_state(bodies[i], PhysicsServer3D::BODY_STATE_SLEEPING, true);
+		}
+
+		// Writing back the current state must not wake the bodies up.
+		physics_server->bodies_set_state_buffer(bodies, physics_server->bodies_get_state_buffer(bodies));
+		for (int i = 0; i < 2; i++) {
+			CHECK(bool(physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_SLEEPING)));
+		}
+
+		// Changing the velocity of one body only wakes that body up.
+		Vector<float> changed = physics_server->bodies_get_state_buffer(bodies);
+		changed.write[PhysicsServer3D::BODIES_STATE_BUFFER_STRIDE + 12] = 1.0;
+		physics_server->bodies_set_state_buffer(bodies, changed, PhysicsServer3D::BODY_STATE_BUFFER_LINEAR_VELOCITY);
+		CHECK(bool(physics_server->body_get_state(bodies[0], PhysicsServer3D::BODY_STATE_SLEEPING)));
+		CHECK_FALSE(bool(physics_server->body_get_state(bodies[1], PhysicsServer3D::BODY_STATE_SLEEPING)));
+		CHECK(Vector3(physics_server->body_get_state(bodies[1], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)) == Vector3(1, 0, 0));
+	}
+
+	for (int i = 0; i < 2; i++) {
+		physics_server->free(bodies[i]);
+	}
+	physics_server->free(shape);
+	physics_server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Consecutive motion tests of a body") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(10, 1, 10));
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.5);
+
+	// The floor's top is at y = 1.
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, box_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_KINEMATIC);
+	physics_server->body_add_shape(body, sphere_shape);
+	physics_server->body_set_space(body, space);
+	const Transform3D from(Basis(), Vector3(0, 4, 0));
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, from);
+
+	const PhysicsServer3D::MotionParameters parameters(from, Vector3(0, -5, 0));
+	PhysicsServer3D::MotionResult result;
+	REQUIRE(physics_server->body_test_motion(body, parameters, &result));
+	CHECK(result.travel.y == doctest::Approx(-2.5).epsilon(0.01));
+
+	SUBCASE("Repeating the test gives the same result") {
+		PhysicsServer3D::MotionResult repeated_result;
+		REQUIRE(physics_server->body_test_motion(body, parameters, &repeated_result));
+		CHECK(repeated_result.travel.is_equal_approx(result.travel));
+		CHECK(repeated_result.collisions[0].position.is_equal_approx(result.collisions[0].position));
+		CHECK(repeated_result.collisions[0].normal.is_equal_approx(result.collisions[0].normal));
+	}
+
+	SUBCASE("Moving the tested body between tests, like move_and_slide() does") {
+		// Lands the body right above the floor, then slides it into a wall that was already in the culled region.
+		RID wall_shape = physics_server->box_shape_create();
+		physics_server->shape_set_data(wall_shape, Vector3(1, 2, 10));
+		RID wall = physics_server->body_create();
+		physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(wall, wall_shape);
+		physics_server->body_set_space(wall, space);
+		physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(4, 2, 0)));
+
+		REQUIRE(physics_server->body_test_motion(body, parameters, &result));
+		const Transform3D landed(Basis(), from.origin + result.travel + Vector3(0, 0.1, 0));
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, landed);
+
+		PhysicsServer3D::MotionResult slide_result;
+		REQUIRE(physics_server->body_test_motion(body, PhysicsServer3D::MotionParameters(landed, Vector3(5, 0, 0)), &slide_result));
+		CHECK(slide_result.travel.x == doctest::Approx(2.5).epsilon(0.01));
+		CHECK(slide_result.collisions[0].normal.is_equal_approx(Vector3(-1, 0, 0)));
+
+		physics_server->free(wall);
+		physics_server->free(wall_shape);
+	}
+
+	SUBCASE("Moving another body between tests") {
+		physics_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+
+		PhysicsServer3D::MotionResult moved_result;
+		REQUIRE(physics_server->body_test_motion(body, parameters, &moved_result));
+		CHECK(moved_result.travel.y == doctest::Approx(-3.5).epsilon(0.01));
+	}
+
+	SUBCASE("Changing the static state of another body between tests") {
+		physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_RIGID);
+
+		PhysicsServer3D::MotionResult changed_result;
+		REQUIRE(physics_server->body_test_motion(body, parameters, &changed_result));
+		CHECK(changed_result.travel.is_equal_approx(result.travel));
+	}
+
+	SUBCASE("Removing another body between tests") {
+		physics_server->body_set_space(floor, RID());
+
+		PhysicsServer3D::MotionResult removed_result;
+		CHECK_FALSE(physics_server->body_test_motion(body, parameters, &removed_result));
+		CHECK(removed_result.travel.is_equal_approx(parameters.motion));
+	}
+
+	physics_server->free(body);
+	physics_server->free(floor);
+	physics_server->free(sphere_shape);
+	physics_server->free(box_shape);
+	physics_server->free(space);
+}
+
+static RID create_soft_body(RID p_space, RID p_mesh, const Vector3 &p_position) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID soft_body = physics_server->soft_body_create();
+	physics_server->soft_body_set_space(soft_body, p_space);
+	physics_server->soft_body_set_mesh(soft_body, p_mesh);
+	physics_server->soft_body_set_transform(soft_body, Transform3D(Basis(), p_position));
+	physics_server->soft_body_set_simulation_precision(soft_body, 5);
+	physics_server->soft_body_set_linear_stiffness(soft_body, 0.8);
+	return soft_body;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Soft body constraints solved on worker threads match a serial solve") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	// A grid with enough nodes and links to be split into several chunks per batch.
+	const int grid_size = 40;
+	PackedVector3Array vertices;
+	PackedInt32Array indices;
+	for (int y = 0; y < grid_size; y++) {
+		for (int x = 0; x < grid_size; x++) {
+			vertices.push_back(Vector3(x * 0.1, 0, y * 0.1));
+		}
+	}
+	for (int y = 0; y < grid_size - 1; y++) {
+		for (int x = 0; x < grid_size - 1; x++) {
+			const int i = y * grid_size + x;
+			indices.push_back(i);
+			indices.push_back(i + 1);
+			indices.push_back(i + grid_size);
+			indices.push_back(i + 1);
+			indices.push_back(i + grid_size + 1);
+			indices.push_back(i + grid_size);
+		}
+	}
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_INDEX] = indices;
+	RID mesh = RS::get_singleton()->mesh_create();
+	RS::get_singleton()->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	// A single active soft body splits its own solve between worker threads,
+	// while several soft bodies are each solved serially on their own thread.
+	RID single_space = physics_server->space_create();
+	RID shared_space = physics_server->space_create();
+	const RID spaces[2] = { single_space, shared_space };
+	for (const RID &space : spaces) {
+		physics_server->space_set_active(space, true);
+		physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+		physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+	}
+
+	RID parallel_body = create_soft_body(single_space, mesh, Vector3());
+	RID serial_body = create_soft_body(shared_space, mesh, Vector3());
+	RID other_body = create_soft_body(shared_space, mesh, Vector3(100, 0, 0));
+
+	// Pinning two corners makes the cloth swing and stretch its links.
+	const RID bodies[3] = { parallel_body, serial_body, other_body };
+	for (const RID &soft_body : bodies) {
+		physics_server->soft_body_pin_point(soft_body, 0, true);
+		physics_server->soft_body_pin_point(soft_body, grid_size - 1, true);
+	}
+
+	for (int i = 0; i < 30; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	const int middle_point = (grid_size / 2) * grid_size + grid_size / 2;
+	CHECK_MESSAGE(physics_server->soft_body_get_point_global_position(parallel_body, middle_point).y < -0.1, "The cloth should have fallen.");
+
+	bool positions_match = true;
+	for (int i = 0; i < vertices.size(); i++) {
+		if (!physics_server->soft_body_get_point_global_position(parallel_body, i).is_equal_approx(physics_server->soft_body_get_point_global_position(serial_body, i))) {
+			positions_match = false;
+			break;
+		}
+	}
+	CHECK_MESSAGE(positions_match, "Solving on worker threads should give the same node positions as a serial solve.");
+
+	for (const RID &soft_body : bodies) {
+		physics_server->free(soft_body);
+	}
+	physics_server->free(single_space);
+	physics_server->free(shared_space);
+	RS::get_singleton()->free(mesh);
+}
+
+TEST_CASE("[PhysicsServer3D] Broadphase changes invalidate cached culls of other bodies") {
+	GodotBroadPhase3D *broadphase = GodotBroadPhase3DBVH::_create();
+	GodotBody3D *body = memnew(GodotBody3D);
+	GodotBody3D *other_body = memnew(GodotBody3D);
+
+	GodotBroadPhase3D::ID body_id = broadphase->create(body, 0, AABB(Vector3(), Vector3(1, 1, 1)), false);
+	GodotBroadPhase3D::ID other_id = broadphase->create(other_body, 0, AABB(Vector3(2, 0, 0), Vector3(1, 1, 1)), true);
+	uint64_t revision = broadphase->get_revision();
+
+	// Changes to the querying body itself keep its cached culls valid.
+	broadphase->move(body_id, AABB(Vector3(0, 1, 0), Vector3(1, 1, 1)));
+	CHECK(broadphase->is_unchanged_except(revision, body));
+
+	SUBCASE("Moving another body") {
+		broadphase->move(other_id, AABB(Vector3(3, 0, 0), Vector3(1, 1, 1)));
+		CHECK_FALSE(broadphase->is_unchanged_except(revision, body));
+	}
+
+	SUBCASE("Changing the static state of another body") {
+		broadphase->set_static(other_id, false);
+		CHECK_FALSE(broadphase->is_unchanged_except(revision, body));
+	}
+
+	SUBCASE("Removing another body") {
+		broadphase->remove(other_id);
+		other_id = 0;
+		CHECK_FALSE(broadphase->is_unchanged_except(revision, body));
+	}
+
+	if (other_id) {
+		broadphase->remove(other_id);
+	}
+	broadphase->remove(body_id);
+	memdelete(other_body);
+	memdelete(body);
+	memdelete(broadphase);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H
@@ -44,6 +44,10 @@ namespace RVO2D {
 		float rangeSq = sqr(timeHorizonObst_ * maxSpeed_ + radius_);
 		sim_->kdTree_->computeObstacleNeighbors(this, rangeSq);
 
+		lastAgentNeighbors_.clear();
+		for (size_t i = 0; i < agentNeighbors_.size(); ++i) {
+			lastAgentNeighbors_.push_back(agentNeighbors_[i].second);
+		}
 		agentNeighbors_.clear();
 
 		if (maxNeighbors_ > 0) {
@@ -360,7 +364,7 @@ namespace RVO2D {
 		}
 	}
 
-	void Agent2D::insertAgentNeighbor(const Agent2D *agent, float &rangeSq)
+	void Agent2D::insertAgentNeighbor(const Agent2D *agent, float distSq, float &rangeSq)
 	{
 		// no point processing same agent
 		if (this == agent) {
@@ -379,8 +383,6 @@ namespace RVO2D {
 			return;
 		}
 
-		const float distSq = absSq(position_ - agent->position_);
-
 		if (distSq < rangeSq) {
 			if (agentNeighbors_.size() < maxNeighbors_) {
 				agentNeighbors_.push_back(std::make_pair(distSq, agent));
@@ -431,6 +433,50 @@ namespace RVO2D {
 		//}
 	}
 
+	bool Agent2D::StepInputs::operator!=(const StepInputs &other) const
+	{
+		return position != other.position || velocity != other.velocity || prefVelocity != other.prefVelocity || maxNeighbors != other.maxNeighbors || maxSpeed != other.maxSpeed || neighborDist != other.neighborDist || radius != other.radius || timeHorizon != other.timeHorizon || timeHorizonObst != other.timeHorizonObst || height != other.height || elevation != other.elevation || avoidanceLayers != other.avoidanceLayers || avoidanceMask != other.avoidanceMask || avoidancePriority != other.avoidancePriority;
+	}
+
+	bool Agent2D::storeStepInputs()
+	{
+		StepInputs inputs;
+		inputs.position = position_;
+		inputs.velocity = velocity_;
+		inputs.prefVelocity = prefVelocity_;
+		inputs.maxNeighbors = maxNeighbors_;
+		inputs.maxSpeed = maxSpeed_;
+		inputs.neighborDist = neighborDist_;
+		inputs.radius = radius_;
+		inputs.timeHorizon = timeHorizon_;
+		inputs.timeHorizonObst = timeHorizonObst_;
+		inputs.height = height_;
+		inputs.elevation = elevation_;
+		inputs.avoidanceLayers = avoidance_layers_;
+		inputs.avoidanceMask = avoidance_mask_;
+		inputs.avoidancePriority = avoidance_priority_;
+
+		stepInputsChanged_ = !hasStepInputs_ || inputs != stepInputs_;
+		stepInputs_ = inputs;
+		hasStepInputs_ = true;
+		return stepInputsChanged_;
+	}
+
+	bool Agent2D::isNewVelocityValid() const
+	{
+		if (stepInputsChanged_ || agentNeighbors_.size() != lastAgentNeighbors_.size()) {
+			return false;
+		}
+
+		for (size_t i = 0; i < agentNeighbors_.size(); ++i) {
+			if (agentNeighbors_[i].second != lastAgentNeighbors_[i] || agentNeighbors_[i].second->stepInputsChanged_) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	void Agent2D::update(RVOSimulator2D *sim_)
 	{
 		velocity_ = newVelocity_;
@@ -67,9 +67,24 @@ namespace RVO2D {
 		 * \brief      Inserts an agent neighbor into the set of neighbors of
 		 *             this agent.
 		 * \param      agent           A pointer to the agent to be inserted.
+		 * \param      distSq          The squared distance to the agent.
 		 * \param      rangeSq         The squared range around this agent.
 		 */
-		void insertAgentNeighbor(const Agent2D *agent, float &rangeSq);
+		void insertAgentNeighbor(const Agent2D *agent, float distSq, float &rangeSq);
+
+		/**
+		 * \brief      Stores the inputs of the new velocity computation of this
+		 *             step and returns whether they changed since the last step.
+		 */
+		bool storeStepInputs();
+
+		/**
+		 * \brief      Returns whether the new velocity computed in an earlier step
+		 *             is still valid, because neither this agent nor its neighbors
+		 *             changed. Needs computeNeighbors() and the storeStepInputs()
+		 *             of all the agents to run first.
+		 */
+		bool isNewVelocityValid() const;
 
 		/**
 		 * \brief      Inserts a static obstacle neighbor into the set of neighbors
@@ -105,6 +120,34 @@ namespace RVO2D {
 		uint32_t avoidance_mask_ = 1;
 		float avoidance_priority_ = 1.0;
 
+		/**
+		 * \brief      The inputs of the new velocity computation.
+		 */
+		class StepInputs {
+		public:
+			Vector2 position;
+			Vector2 velocity;
+			Vector2 prefVelocity;
+			size_t maxNeighbors;
+			float maxSpeed;
+			float neighborDist;
+			float radius;
+			float timeHorizon;
+			float timeHorizonObst;
+			float height;
+			float elevation;
+			uint32_t avoidanceLayers;
+			uint32_t avoidanceMask;
+			float avoidancePriority;
+
+			bool operator!=(const StepInputs &other) const;
+		};
+
+		StepInputs stepInputs_;
+		bool stepInputsChanged_ = true;
+		bool hasStepInputs_ = false;
+		std::vector<const Agent2D *> lastAgentNeighbors_;
+
 		size_t id_;
 
 		friend class KdTree2D;
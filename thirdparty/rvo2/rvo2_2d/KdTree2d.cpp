@@ -52,10 +52,37 @@ namespace RVO2D {
 			agentTree_.resize(2 * agents_.size() - 1);
 			buildAgentTreeRecursive(0, agents_.size(), 0);
 		}
+
+		updateAgentPositions();
+	}
+
+	void KdTree2D::buildAgentTree(std::vector<Agent2D *> agents, size_t maxSubtreeAgents, std::vector<AgentSubtree> &subtrees)
+	{
+		agents_.swap(agents);
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeRecursive(0, agents_.size(), 0, maxSubtreeAgents, &subtrees);
+		}
+	}
+
+	void KdTree2D::buildAgentSubtree(const AgentSubtree &subtree)
+	{
+		/* The subtrees use disjoint ranges of agents_ and agentTree_. */
+		buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
 	}
 
-	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeAgents, std::vector<AgentSubtree> *subtrees)
 	{
+		if (subtrees != NULL && end - begin <= maxSubtreeAgents) {
+			AgentSubtree subtree;
+			subtree.begin = begin;
+			subtree.end = end;
+			subtree.node = node;
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minX = agentTree_[node].maxX = agents_[begin]->position_.x();
@@ -100,8 +127,8 @@ namespace RVO2D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * (left - begin);
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, maxSubtreeAgents, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, maxSubtreeAgents, subtrees);
 		}
 	}
 
@@ -233,6 +260,15 @@ namespace RVO2D {
 		}
 	}
 
+	void KdTree2D::updateAgentPositions()
+	{
+		agentPositions_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
+		}
+	}
+
 	void KdTree2D::computeAgentNeighbors(Agent2D *agent, float &rangeSq) const
 	{
 		queryAgentTreeRecursive(agent, rangeSq, 0);
@@ -255,8 +291,20 @@ namespace RVO2D {
 	void KdTree2D::queryAgentTreeRecursive(Agent2D *agent, float &rangeSq, size_t node) const
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= MAX_LEAF_SIZE) {
-			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+			/* The distances are computed from the packed positions first, so far away agents are skipped without being accessed. */
+			const size_t begin = agentTree_[node].begin;
+			const size_t count = agentTree_[node].end - begin;
+			const Vector2 *positions = &agentPositions_[begin];
+			float distSq[MAX_LEAF_SIZE];
+
+			for (size_t i = 0; i < count; ++i) {
+				distSq[i] = absSq(agent->position_ - positions[i]);
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				if (distSq[i] < rangeSq) {
+					agent->insertAgentNeighbor(agents_[begin + i], distSq[i], rangeSq);
+				}
 			}
 		}
 		else {
@@ -93,6 +93,17 @@ namespace RVO2D {
 			size_t right;
 		};
 
+		/**
+		 * \brief      Defines a subtree of the agent <i>k</i>d-tree whose build
+		 *             was deferred.
+		 */
+		class AgentSubtree {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief      Defines an obstacle <i>k</i>d-tree node.
 		 */
@@ -130,7 +141,27 @@ namespace RVO2D {
 		 */
 		void buildAgentTree(std::vector<Agent2D *> agents);
 
-		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
+		/**
+		 * \brief      Builds the upper levels of an agent <i>k</i>d-tree. The
+		 *             subtrees with at most maxSubtreeAgents agents are added to
+		 *             subtrees instead, so they can be built concurrently with
+		 *             buildAgentSubtree(). updateAgentPositions() must be called
+		 *             once they are built.
+		 */
+		void buildAgentTree(std::vector<Agent2D *> agents, size_t maxSubtreeAgents, std::vector<AgentSubtree> &subtrees);
+
+		/**
+		 * \brief      Builds a subtree deferred by buildAgentTree().
+		 */
+		void buildAgentSubtree(const AgentSubtree &subtree);
+
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeAgents = 0, std::vector<AgentSubtree> *subtrees = NULL);
+
+		/**
+		 * \brief      Copies the agent positions to the packed array that the
+		 *             agent neighbor queries read.
+		 */
+		void updateAgentPositions();
 
 		/**
 		 * \brief      Builds an obstacle <i>k</i>d-tree.
@@ -190,6 +221,7 @@ namespace RVO2D {
 
 		std::vector<Agent2D *> agents_;
 		std::vector<AgentTreeNode> agentTree_;
+		std::vector<Vector2> agentPositions_;
 		ObstacleTreeNode *obstacleTree_;
 		RVOSimulator2D *sim_;
 
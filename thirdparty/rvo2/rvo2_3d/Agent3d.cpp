@@ -109,6 +109,10 @@ namespace RVO3D {
 
 	void Agent3D::computeNeighbors(RVOSimulator3D *sim_)
 	{
+		lastAgentNeighbors_.clear();
+		for (size_t i = 0; i < agentNeighbors_.size(); ++i) {
+			lastAgentNeighbors_.push_back(agentNeighbors_[i].second);
+		}
 		agentNeighbors_.clear();
 
 		if (maxNeighbors_ > 0) {
@@ -190,7 +194,7 @@ namespace RVO3D {
 		}
 	}
 
-	void Agent3D::insertAgentNeighbor(const Agent3D *agent, float &rangeSq)
+	void Agent3D::insertAgentNeighbor(const Agent3D *agent, float distSq, float &rangeSq)
 	{
 		// no point processing same agent
 		if (this == agent) {
@@ -205,8 +209,6 @@ namespace RVO3D {
 			return;
 		}
 
-		const float distSq = absSq(position_ - agent->position_);
-
 		if (distSq < rangeSq) {
 			if (agentNeighbors_.size() < maxNeighbors_) {
 				agentNeighbors_.push_back(std::make_pair(distSq, agent));
@@ -227,6 +229,49 @@ namespace RVO3D {
 		}
 	}
 
+	bool Agent3D::StepInputs::operator!=(const StepInputs &other) const
+	{
+		return position != other.position || velocity != other.velocity || prefVelocity != other.prefVelocity || maxNeighbors != other.maxNeighbors || maxSpeed != other.maxSpeed || neighborDist != other.neighborDist || radius != other.radius || timeHorizon != other.timeHorizon || timeHorizonObst != other.timeHorizonObst || height != other.height || avoidanceLayers != other.avoidanceLayers || avoidanceMask != other.avoidanceMask || avoidancePriority != other.avoidancePriority;
+	}
+
+	bool Agent3D::storeStepInputs()
+	{
+		StepInputs inputs;
+		inputs.position = position_;
+		inputs.velocity = velocity_;
+		inputs.prefVelocity = prefVelocity_;
+		inputs.maxNeighbors = maxNeighbors_;
+		inputs.maxSpeed = maxSpeed_;
+		inputs.neighborDist = neighborDist_;
+		inputs.radius = radius_;
+		inputs.timeHorizon = timeHorizon_;
+		inputs.timeHorizonObst = timeHorizonObst_;
+		inputs.height = height_;
+		inputs.avoidanceLayers = avoidance_layers_;
+		inputs.avoidanceMask = avoidance_mask_;
+		inputs.avoidancePriority = avoidance_priority_;
+
+		stepInputsChanged_ = !hasStepInputs_ || inputs != stepInputs_;
+		stepInputs_ = inputs;
+		hasStepInputs_ = true;
+		return stepInputsChanged_;
+	}
+
+	bool Agent3D::isNewVelocityValid() const
+	{
+		if (stepInputsChanged_ || agentNeighbors_.size() != lastAgentNeighbors_.size()) {
+			return false;
+		}
+
+		for (size_t i = 0; i < agentNeighbors_.size(); ++i) {
+			if (agentNeighbors_[i].second != lastAgentNeighbors_[i] || agentNeighbors_[i].second->stepInputsChanged_) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	void Agent3D::update(RVOSimulator3D *sim_)
 	{
 		velocity_ = newVelocity_;
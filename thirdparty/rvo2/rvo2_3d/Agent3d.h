@@ -70,9 +70,20 @@ namespace RVO3D {
 		/**
 		 * \brief   Inserts an agent neighbor into the set of neighbors of this agent.
 		 * \param   agent    A pointer to the agent to be inserted.
+		 * \param   distSq   The squared distance to the agent.
 		 * \param   rangeSq  The squared range around this agent.
 		 */
-		void insertAgentNeighbor(const Agent3D *agent, float &rangeSq);
+		void insertAgentNeighbor(const Agent3D *agent, float distSq, float &rangeSq);
+
+		/**
+		 * \brief   Stores the inputs of the new velocity computation of this step and returns whether they changed since the last step.
+		 */
+		bool storeStepInputs();
+
+		/**
+		 * \brief   Returns whether the new velocity computed in an earlier step is still valid, because neither this agent nor its neighbors changed. Needs computeNeighbors() and the storeStepInputs() of all the agents to run first.
+		 */
+		bool isNewVelocityValid() const;
 
 		/**
 		 * \brief   Updates the three-dimensional position and three-dimensional velocity of this agent.
@@ -98,6 +109,33 @@ namespace RVO3D {
 		uint32_t avoidance_mask_ = 1;
 		float avoidance_priority_ = 1.0;
 
+		/**
+		 * \brief   The inputs of the new velocity computation.
+		 */
+		class StepInputs {
+		public:
+			Vector3 position;
+			Vector3 velocity;
+			Vector3 prefVelocity;
+			size_t maxNeighbors;
+			float maxSpeed;
+			float neighborDist;
+			float radius;
+			float timeHorizon;
+			float timeHorizonObst;
+			float height;
+			uint32_t avoidanceLayers;
+			uint32_t avoidanceMask;
+			float avoidancePriority;
+
+			bool operator!=(const StepInputs &other) const;
+		};
+
+		StepInputs stepInputs_;
+		bool stepInputsChanged_ = true;
+		bool hasStepInputs_ = false;
+		std::vector<const Agent3D *> lastAgentNeighbors_;
+
 		friend class KdTree3D;
 		friend class RVOSimulator3D;
 	};
@@ -51,10 +51,37 @@ namespace RVO3D {
 			agentTree_.resize(2 * agents_.size() - 1);
 			buildAgentTreeRecursive(0, agents_.size(), 0);
 		}
+
+		updateAgentPositions();
+	}
+
+	void KdTree3D::buildAgentTree(std::vector<Agent3D *> agents, size_t maxSubtreeAgents, std::vector<AgentSubtree> &subtrees)
+	{
+		agents_.swap(agents);
+
+		if (!agents_.empty()) {
+			agentTree_.resize(2 * agents_.size() - 1);
+			buildAgentTreeRecursive(0, agents_.size(), 0, maxSubtreeAgents, &subtrees);
+		}
+	}
+
+	void KdTree3D::buildAgentSubtree(const AgentSubtree &subtree)
+	{
+		/* The subtrees use disjoint ranges of agents_ and agentTree_. */
+		buildAgentTreeRecursive(subtree.begin, subtree.end, subtree.node);
 	}
 
-	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
+	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeAgents, std::vector<AgentSubtree> *subtrees)
 	{
+		if (subtrees != NULL && end - begin <= maxSubtreeAgents) {
+			AgentSubtree subtree;
+			subtree.begin = begin;
+			subtree.end = end;
+			subtree.node = node;
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
 		agentTree_[node].minCoord = agents_[begin]->position_;
@@ -116,8 +143,17 @@ namespace RVO3D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * leftSize;
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, maxSubtreeAgents, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, maxSubtreeAgents, subtrees);
+		}
+	}
+
+	void KdTree3D::updateAgentPositions()
+	{
+		agentPositions_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
 		}
 	}
 
@@ -129,8 +165,20 @@ namespace RVO3D {
 	void KdTree3D::queryAgentTreeRecursive(Agent3D *agent, float &rangeSq, size_t node) const
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= RVO3D_MAX_LEAF_SIZE) {
-			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+			/* The distances are computed from the packed positions first, so far away agents are skipped without being accessed. */
+			const size_t begin = agentTree_[node].begin;
+			const size_t count = agentTree_[node].end - begin;
+			const Vector3 *positions = &agentPositions_[begin];
+			float distSq[RVO3D_MAX_LEAF_SIZE];
+
+			for (size_t i = 0; i < count; ++i) {
+				distSq[i] = absSq(agent->position_ - positions[i]);
+			}
+
+			for (size_t i = 0; i < count; ++i) {
+				if (distSq[i] < rangeSq) {
+					agent->insertAgentNeighbor(agents_[begin + i], distSq[i], rangeSq);
+				}
 			}
 		}
 		else {
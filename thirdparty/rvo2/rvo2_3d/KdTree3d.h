@@ -90,6 +90,16 @@ namespace RVO3D {
 		 * \brief   Constructs a <i>k</i>d-tree instance.
 		 * \param   sim  The simulator instance.
 		 */
+		/**
+		 * \brief   Defines a subtree of the agent <i>k</i>d-tree whose build was deferred.
+		 */
+		class AgentSubtree {
+		public:
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		explicit KdTree3D(RVOSimulator3D *sim);
 
 		/**
@@ -97,7 +107,22 @@ namespace RVO3D {
 		 */
 		void buildAgentTree(std::vector<Agent3D *> agents);
 
-		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
+		/**
+		 * \brief   Builds the upper levels of an agent <i>k</i>d-tree. The subtrees with at most maxSubtreeAgents agents are added to subtrees instead, so they can be built concurrently with buildAgentSubtree(). updateAgentPositions() must be called once they are built.
+		 */
+		void buildAgentTree(std::vector<Agent3D *> agents, size_t maxSubtreeAgents, std::vector<AgentSubtree> &subtrees);
+
+		/**
+		 * \brief   Builds a subtree deferred by buildAgentTree().
+		 */
+		void buildAgentSubtree(const AgentSubtree &subtree);
+
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t maxSubtreeAgents = 0, std::vector<AgentSubtree> *subtrees = NULL);
+
+		/**
+		 * \brief   Copies the agent positions to the packed array that the agent neighbor queries read.
+		 */
+		void updateAgentPositions();
 
 		/**
 		 * \brief   Computes the agent neighbors of the specified agent.
@@ -110,6 +135,7 @@ namespace RVO3D {
 
 		std::vector<Agent3D *> agents_;
 		std::vector<AgentTreeNode3D> agentTree_;
+		std::vector<Vector3> agentPositions_;
 		RVOSimulator3D *sim_;
 
 		friend class Agent3D;